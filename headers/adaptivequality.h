@@ -0,0 +1,98 @@
+#ifndef ADAPTIVEQUALITY_H
+#define ADAPTIVEQUALITY_H
+
+// Inclusion de mes headers
+#include "headers/ledrenderer.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+
+/**
+ * @file adaptivequality.h
+ * @author G. Maxime
+ * @class AdaptiveQuality
+ * @brief Ajuste la qualité du dessin des LED pour tenir un budget de temps par image.
+ * La durée de chaque image est lissée (moyenne exponentielle). Au-delà du budget
+ * pendant quelques images, la qualité baisse d'un cran ; sous 60 % du budget
+ * pendant nettement plus longtemps, elle remonte d'un cran. Une remontée suivie
+ * d'une rechute rapide double le délai avant la remontée suivante, pour ne pas osciller.
+ */
+class AdaptiveQuality
+{
+public:
+    /**
+     * @brief Définit le budget de temps par image.
+     * @param budgetMs Budget en millisecondes (0 pour désactiver : qualité maximale permanente).
+     */
+    void setBudget(double budgetMs);
+
+    /**
+     * @brief Budget de temps par image en millisecondes (0 si désactivé).
+     */
+    double budget() const;
+
+    /**
+     * @brief Niveau de qualité courant.
+     */
+    LedRenderer::Quality quality() const;
+
+    /**
+     * @brief Durée lissée des dernières images, en millisecondes.
+     */
+    double averageFrameTime() const;
+
+    /**
+     * @brief Prend en compte la durée d'une image.
+     * @param frameNs Durée du dessin de l'image en nanosecondes.
+     * @return Vrai si le niveau de qualité a changé.
+     */
+    bool addSample(qint64 frameNs);
+
+private:
+    /**
+     * @brief Change de niveau et repart d'une mesure vierge.
+     */
+    void changeLevel(int level);
+
+    /**
+     * @brief Budget par image en millisecondes (0 : désactivé).
+     */
+    double budgetMs = 0.0;
+
+    /**
+     * @brief Durée lissée des images en millisecondes (négative : aucune mesure depuis le dernier changement).
+     */
+    double averageMs = -1.0;
+
+    /**
+     * @brief Niveau courant (valeur de LedRenderer::Quality).
+     */
+    int level = LedRenderer::HighQuality;
+
+    /**
+     * @brief Images consécutives au-dessus du budget.
+     */
+    int overFrames = 0;
+
+    /**
+     * @brief Images consécutives avec une marge suffisante pour remonter.
+     */
+    int underFrames = 0;
+
+    /**
+     * @brief Images dessinées depuis le dernier changement de niveau.
+     */
+    int framesAtLevel = 0;
+
+    /**
+     * @brief Vrai si le dernier changement de niveau était une remontée.
+     */
+    bool lastChangeWasUp = false;
+
+    /**
+     * @brief Nombre de doublements du délai de remontée après des rechutes.
+     */
+    int backoff = 0;
+};
+
+#endif // ADAPTIVEQUALITY_H
@@ -0,0 +1,150 @@
+#ifndef CONTENTMAILBOX_H
+#define CONTENTMAILBOX_H
+
+// Inclusion des headers Qt nécessaires
+#include <QString>
+#include <QRgb>
+
+// Inclusion des headers standard nécessaires
+#include <array>
+#include <atomic>
+#include <utility>
+
+/**
+ * @file contentmailbox.h
+ * @author G. Maxime
+ * @class LatestValueMailbox
+ * @brief Boîte aux lettres sans verrou ne conservant que la dernière valeur déposée.
+ * Plusieurs producteurs (n'importe quel thread) déposent des valeurs avec post(),
+ * un seul consommateur (le thread GUI) récupère la plus récente avec take().
+ * Les valeurs intermédiaires non lues sont abandonnées. Un dépôt ne prend jamais
+ * de verrou : il réserve un emplacement libre par compare-and-swap puis le publie
+ * par un échange atomique, l'emplacement remplacé étant rendu par son producteur.
+ *
+ * Un emplacement est occupé par producteur en cours d'écriture, plus la valeur
+ * publiée et la valeur en cours de lecture. Un producteur n'attend jamais : au-delà
+ * de SlotCount - 2 dépôts simultanés, un dépôt qui ne trouve aucun emplacement libre
+ * est abandonné, au profit des dépôts concurrents qui seront publiés après lui.
+ */
+template <typename T, int SlotCount = 8>
+class LatestValueMailbox
+{
+    static_assert(SlotCount >= 3, "LatestValueMailbox needs at least 3 slots");
+
+public:
+    /**
+     * @brief Dépose une valeur (appelable depuis n'importe quel thread, sans attente).
+     * @return Faux si le dépôt a été abandonné faute d'emplacement libre (dépôts concurrents en cours).
+     */
+    bool post(const T &value)
+    {
+        for (int index = 0; index < SlotCount; ++index) {
+            int expected = Free;
+            if (!buffers[index].state.compare_exchange_strong(expected, Writing, std::memory_order_acquire))
+                continue;
+
+            buffers[index].value = value;
+            buffers[index].state.store(Published, std::memory_order_relaxed);
+            // Publication séquentiellement cohérente : ordonnée avec le réarmement du réveil
+            // (ContentMailbox::wakePending), un dépôt ne peut pas passer entre le relevé et le réarmement
+            const int previous = latest.exchange(index, std::memory_order_seq_cst);
+            if (previous >= 0)
+                release(previous);
+            return true;
+        }
+        // Dernière valeur gagnante : un dépôt concurrent la remplacerait de toute façon
+        return false;
+    }
+
+    /**
+     * @brief Récupère la dernière valeur déposée (thread consommateur uniquement).
+     * @param value Valeur récupérée.
+     * @return Faux si aucune valeur n'a été déposée depuis le dernier appel.
+     */
+    bool take(T *value)
+    {
+        const int index = latest.exchange(-1, std::memory_order_seq_cst);
+        if (index < 0)
+            return false;
+
+        *value = std::move(buffers[index].value);
+        release(index);
+        return true;
+    }
+
+    /**
+     * @brief Indique si une valeur attend d'être récupérée.
+     */
+    bool hasValue() const
+    {
+        return latest.load(std::memory_order_acquire) >= 0;
+    }
+
+private:
+    /**
+     * @brief États d'un emplacement.
+     */
+    enum SlotState {
+        Free,
+        Writing,
+        Published
+    };
+
+    /**
+     * @brief Emplacement de valeur, isolé sur sa propre ligne de cache.
+     */
+    struct alignas(64) Slot {
+        std::atomic<int> state{Free};
+        T value{};
+    };
+
+    /**
+     * @brief Rend un emplacement sorti de la publication (par un producteur ou par le consommateur).
+     */
+    void release(int index)
+    {
+        buffers[index].value = T();
+        buffers[index].state.store(Free, std::memory_order_release);
+    }
+
+    /**
+     * @brief Emplacements des valeurs.
+     */
+    std::array<Slot, SlotCount> buffers;
+
+    /**
+     * @brief Indice de l'emplacement publié le plus récent (-1 : aucun).
+     */
+    alignas(64) std::atomic<int> latest{-1};
+};
+
+/**
+ * @struct ContentMailbox
+ * @brief Dernier état demandé par les producteurs pour chaque réglage de contenu.
+ * Chaque réglage a sa propre boîte : un changement de couleur ne fait pas perdre
+ * un changement de texte déposé par un autre thread.
+ */
+struct ContentMailbox
+{
+    LatestValueMailbox<QString> text;
+    LatestValueMailbox<QRgb> color;
+    LatestValueMailbox<int> displayMode;
+    LatestValueMailbox<int> scrollMode;
+    LatestValueMailbox<bool> scrollEnabled;
+    LatestValueMailbox<int> scrollSpeed;
+
+    /**
+     * @brief Vrai si un relevé de la boîte est déjà programmé sur le thread GUI.
+     * Lu, écrit et échangé en ordre séquentiellement cohérent, comme les publications
+     * des boîtes : soit le relevé voit le dépôt, soit le producteur voit le réarmement
+     * et programme un nouveau relevé.
+     */
+    std::atomic<bool> wakePending{false};
+
+    /**
+     * @brief Instant du premier dépôt non encore relevé (LatencyTracker::nowNs(), 0 : aucun).
+     */
+    std::atomic<qint64> firstPostNs{0};
+};
+
+#endif // CONTENTMAILBOX_H
@@ -0,0 +1,77 @@
+#ifndef FRAMECLOCK_H
+#define FRAMECLOCK_H
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+#include <QTime>
+
+/**
+ * @file frameclock.h
+ * @author G. Maxime
+ * @class FrameClock
+ * @brief Source de temps de la matrice (défilement, horloge, effets).
+ * Les timers ne servent qu'à réveiller la matrice : le contenu affiché est
+ * calculé à partir de cette horloge. Une horloge manuelle (ManualFrameClock)
+ * rend donc chaque image reproductible, indépendamment de la machine.
+ */
+class FrameClock
+{
+public:
+    virtual ~FrameClock() = default;
+
+    /**
+     * @brief Temps monotone en millisecondes, depuis une origine arbitraire.
+     */
+    virtual qint64 elapsedMs() const = 0;
+
+    /**
+     * @brief Heure locale affichée en mode horloge.
+     */
+    virtual QTime currentTime() const = 0;
+
+    /**
+     * @brief Horloge système partagée (QElapsedTimer et QTime::currentTime()).
+     */
+    static const FrameClock *systemClock();
+};
+
+/**
+ * @class ManualFrameClock
+ * @brief Horloge avancée explicitement, pour rejouer des séquences d'images à l'identique.
+ */
+class ManualFrameClock : public FrameClock
+{
+public:
+    /**
+     * @brief Constructeur.
+     * @param time Heure locale de départ.
+     */
+    explicit ManualFrameClock(const QTime &time = QTime(0, 0));
+
+    qint64 elapsedMs() const override;
+    QTime currentTime() const override;
+
+    /**
+     * @brief Avance le temps monotone et l'heure locale.
+     * @param ms Durée en millisecondes.
+     */
+    void advance(qint64 ms);
+
+    /**
+     * @brief Change l'heure locale sans toucher au temps monotone.
+     */
+    void setTime(const QTime &time);
+
+private:
+    /**
+     * @brief Temps monotone courant en millisecondes.
+     */
+    qint64 nowMs = 0;
+
+    /**
+     * @brief Heure locale courante.
+     */
+    QTime wallTime;
+};
+
+#endif // FRAMECLOCK_H
@@ -0,0 +1,321 @@
+#ifndef FRAMESTREAM_H
+#define FRAMESTREAM_H
+
+// Inclusion des headers Qt nécessaires
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QRgb>
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+#include "headers/ledpalette.h"
+
+// Inclusion des headers standard nécessaires
+#include <vector>
+
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @file framestream.h
+ * @author G. Maxime
+ * @brief Diffusion des images de la matrice sur TCP, compressée par différences.
+ *
+ * Chaque image est réduite à un plan compact : un bit par LED (allumée si son
+ * intensité atteint la moitié), suivi du plan d'encre (4 ou 8 bits par LED, nul
+ * pour les LED éteintes). Un client reçoit d'abord une image clé complète, puis
+ * pour chaque changement le XOR du plan avec le précédent, codé par plages
+ * (RLE) : seuls les octets modifiés circulent.
+ *
+ * Format d'un message : type (1 octet), longueur de la charge (4 octets, petit-boutiste), charge.
+ * - 'K' image clé : numéro (u32), colonnes (u16), lignes (u16), bits d'encre (u8),
+ *   nombre de couleurs (u16), couleurs (3 octets RGB chacune), plan compact.
+ * - 'D' différence : numéro (u32), puis des paires (saut varint, nombre varint
+ *   d'octets XOR suivis de ces octets) jusqu'à la fin de la charge.
+ */
+
+/**
+ * @class FrameStreamServer
+ * @brief Serveur de diffusion : encode chaque image une seule fois pour tous les clients.
+ * Un client dont le tampon d'émission dépasse maxPendingBytes() ne reçoit plus de
+ * différences ; il est resynchronisé par une image clé dès que son tampon s'est vidé.
+ * Un client lent ne ralentit donc jamais le rendu et n'accumule pas de mémoire.
+ */
+class FrameStreamServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Compteurs de diffusion.
+     */
+    struct Statistics {
+        int clients = 0;              ///< Clients connectés
+        quint64 framesEncoded = 0;    ///< Images modifiées encodées
+        quint64 keyframesSent = 0;    ///< Images clés envoyées (connexions et resynchronisations)
+        quint64 deltasSent = 0;       ///< Différences envoyées
+        quint64 framesSkipped = 0;    ///< Images non envoyées à un client saturé
+        quint64 bytesSent = 0;        ///< Octets confiés aux sockets, tous clients confondus
+        quint64 keyframeBytes = 0;    ///< Taille de la dernière image clé, en octets
+        quint64 deltaBytes = 0;       ///< Octets de différences encodés (une fois par image)
+        qint64 publishNs = 0;         ///< Temps passé dans publish() (encodage et écritures)
+        qint64 peakPendingBytes = 0;  ///< Plus grand tampon d'émission observé pour un client
+    };
+
+    /**
+     * @brief Plafond par défaut du tampon d'émission d'un client, en octets.
+     */
+    static constexpr qint64 DefaultMaxPendingBytes = 256 * 1024;
+
+    /**
+     * @brief Constructeur d'un serveur arrêté.
+     * @param parent Objet parent (par défaut nullptr).
+     */
+    explicit FrameStreamServer(QObject *parent = nullptr);
+
+    /**
+     * @brief Écoute sur un port TCP (toutes les interfaces).
+     * @param port Port d'écoute (0 : port libre choisi par le système, voir port()).
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si le serveur écoute.
+     */
+    bool listen(quint16 port, QString *errorMessage);
+
+    /**
+     * @brief Port d'écoute effectif.
+     */
+    quint16 port() const;
+
+    /**
+     * @brief Change le plafond du tampon d'émission au-delà duquel un client est mis en attente.
+     */
+    void setMaxPendingBytes(qint64 bytes);
+
+    /**
+     * @brief Plafond du tampon d'émission d'un client, en octets.
+     */
+    qint64 maxPendingBytes() const;
+
+    /**
+     * @brief Diffuse une image si elle diffère de la précédente.
+     */
+    void publish(const LedFrame &frame, const LedPalette &palette);
+
+    /**
+     * @brief Relevé des compteurs.
+     */
+    Statistics statistics() const;
+
+    /**
+     * @brief Plan compact d'une image : bits d'allumage puis encres des LED allumées.
+     * @param frame Image à réduire.
+     * @param packed Plan compact (redimensionné si nécessaire).
+     */
+    static void packFrame(const LedFrame &frame, std::vector<quint8> *packed);
+
+    /**
+     * @brief Taille du plan compact, en octets.
+     */
+    static int packedBytes(int cols, int rows, int inkBits);
+
+private slots:
+    /**
+     * @brief Accepte les connexions en attente et leur envoie l'image courante.
+     */
+    void onNewConnection();
+
+private:
+    /**
+     * @brief État d'un client.
+     */
+    struct Client {
+        QTcpSocket *socket = nullptr;
+        bool needsKeyframe = true;
+    };
+
+    /**
+     * @brief Envoie l'image courante à un client à resynchroniser si son tampon s'est vidé.
+     */
+    void resyncClient(QTcpSocket *socket);
+
+    /**
+     * @brief Encode l'image clé de l'image courante (une fois par image).
+     */
+    const QByteArray &keyframeMessage();
+
+    /**
+     * @brief Encode dans deltaMessage le XOR de nextPacked et latestPacked, par plages.
+     */
+    void encodeDelta();
+
+    /**
+     * @brief Confie un message à un client.
+     */
+    void send(Client &client, const QByteArray &message);
+
+    /**
+     * @brief Retire un client déconnecté.
+     */
+    void removeClient(QTcpSocket *socket);
+
+    /**
+     * @brief Socket d'écoute.
+     */
+    QTcpServer *server;
+
+    /**
+     * @brief Clients connectés.
+     */
+    std::vector<Client> clients;
+
+    /**
+     * @brief Plafond du tampon d'émission d'un client.
+     */
+    qint64 pendingLimit = DefaultMaxPendingBytes;
+
+    /**
+     * @brief Plan compact de l'image courante, déjà diffusée.
+     */
+    std::vector<quint8> latestPacked;
+
+    /**
+     * @brief Plan compact de l'image à diffuser (échangé avec latestPacked après diffusion).
+     */
+    std::vector<quint8> nextPacked;
+
+    /**
+     * @brief Géométrie et palette de l'image courante.
+     */
+    int cols = 0;
+    int rows = 0;
+    int inkBits = 0;
+    QVector<QRgb> colors;
+
+    /**
+     * @brief Numéro de l'image courante (0 : aucune image).
+     */
+    quint32 frameNumber = 0;
+
+    /**
+     * @brief Message de différence de l'image courante.
+     */
+    QByteArray deltaMessage;
+
+    /**
+     * @brief Image clé de l'image courante, encodée à la demande.
+     */
+    QByteArray cachedKeyframe;
+
+    /**
+     * @brief Numéro de l'image de cachedKeyframe.
+     */
+    quint32 cachedKeyframeNumber = 0;
+
+    /**
+     * @brief Compteurs.
+     */
+    Statistics stats;
+};
+
+/**
+ * @class FrameStreamDecoder
+ * @brief Décodeur côté client : reconstruit le plan compact à partir des messages reçus.
+ */
+class FrameStreamDecoder
+{
+public:
+    /**
+     * @brief Ajoute des octets reçus et décode les messages complets.
+     * @param bytes Octets reçus (un message peut être coupé n'importe où).
+     * @param errorMessage Message d'erreur renseigné si le flux est invalide.
+     * @return Nombre d'images décodées, -1 si le flux est invalide.
+     */
+    int feed(const QByteArray &bytes, QString *errorMessage);
+
+    /**
+     * @brief Indique qu'une image clé a été reçue.
+     */
+    bool hasFrame() const { return synced; }
+
+    /**
+     * @brief Dimensions de l'image, en LED.
+     */
+    int cols() const { return frameCols; }
+    int rows() const { return frameRows; }
+
+    /**
+     * @brief Profondeur du plan d'encre (0, 4 ou 8 bits).
+     */
+    int inkBits() const { return frameInkBits; }
+
+    /**
+     * @brief Numéro de la dernière image décodée.
+     */
+    quint32 frameNumber() const { return number; }
+
+    /**
+     * @brief Couleurs des indices de palette.
+     */
+    const QVector<QRgb> &palette() const { return colors; }
+
+    /**
+     * @brief Plan compact courant (même format que FrameStreamServer::packFrame()).
+     */
+    const std::vector<quint8> &packed() const { return plane; }
+
+    /**
+     * @brief Indique si la LED (col, row) est allumée.
+     */
+    bool isLit(int col, int row) const;
+
+    /**
+     * @brief Indice de palette de la LED (col, row).
+     */
+    quint8 ink(int col, int row) const;
+
+    /**
+     * @brief Nombre d'images clés et de différences décodées.
+     */
+    quint64 keyframes() const { return keyframeCount; }
+    quint64 deltas() const { return deltaCount; }
+
+private:
+    /**
+     * @brief Décode un message complet.
+     */
+    bool decode(char type, const char *payload, int size, QString *errorMessage);
+
+    /**
+     * @brief Octets reçus non encore décodés.
+     */
+    QByteArray pending;
+
+    /**
+     * @brief Plan compact reconstruit.
+     */
+    std::vector<quint8> plane;
+
+    /**
+     * @brief Géométrie, palette et numéro de l'image reconstruite.
+     */
+    QVector<QRgb> colors;
+    int frameCols = 0;
+    int frameRows = 0;
+    int frameInkBits = 0;
+    quint32 number = 0;
+
+    /**
+     * @brief Vrai après la première image clé : les différences s'appliquent.
+     */
+    bool synced = false;
+
+    /**
+     * @brief Messages décodés.
+     */
+    quint64 keyframeCount = 0;
+    quint64 deltaCount = 0;
+};
+
+#endif // FRAMESTREAM_H
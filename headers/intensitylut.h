@@ -0,0 +1,185 @@
+#ifndef INTENSITYLUT_H
+#define INTENSITYLUT_H
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+
+// Inclusion des headers standard nécessaires
+#include <array>
+
+/**
+ * @file intensitylut.h
+ * @author G. Maxime
+ * @class IntensityLut
+ * @brief Réponse lumineuse d'un panneau physique : les intensités 8 bits des LED passent
+ * par une table de 256 entrées qui combine gamma et luminosité globale.
+ *
+ * La table est recalculée quand un réglage change ; l'application à une image ne fait
+ * qu'une lecture de table par LED allumée, par blocs de 32 LED avec AVX2 (vpshufb sur
+ * 16 sous-tables), les blocs de LED éteintes étant sautés.
+ * Changer la luminosité coûte donc une reconstruction de table, jamais un calcul par LED.
+ *
+ * Le mode bit-plane simule le rafraîchissement d'un panneau en modulation par code
+ * binaire : l'intensité est réduite à la profondeur du panneau, puis chaque plan de bit
+ * k reste affiché pendant 2^k tops d'un cycle de rafraîchissement. L'intensité perçue
+ * d'une image est la part de la fenêtre d'exposition (l'intervalle depuis l'image
+ * précédente) où la LED est allumée : le poids de chaque plan dans la fenêtre est
+ * calculé une fois par image, puis une table de 256 entrées est recomposée à partir de
+ * ces poids. Quand la fenêtre ne couvre pas un nombre entier de cycles, les poids
+ * varient d'une image à l'autre et le scintillement du panneau apparaît.
+ */
+class IntensityLut
+{
+public:
+    /**
+     * @brief Compteurs depuis le dernier reset().
+     */
+    struct Statistics {
+        quint64 frames = 0;        ///< Images passées par la table
+        quint64 tableBuilds = 0;   ///< Tables gamma et luminosité recalculées
+        quint64 planeTables = 0;   ///< Tables recomposées à partir des poids des plans de bit
+    };
+
+    /**
+     * @brief Profondeur maximale du panneau simulé, en bits.
+     */
+    static constexpr int MaxPlaneBits = 8;
+
+    /**
+     * @brief Fréquence de rafraîchissement par défaut du panneau simulé, en Hz.
+     */
+    static constexpr int DefaultRefreshHz = 240;
+
+    /**
+     * @brief Constructeur : réponse linéaire à pleine luminosité, sans simulation de plans.
+     */
+    IntensityLut();
+
+    /**
+     * @brief Règle la courbe de réponse.
+     * @param gamma Exposant appliqué à l'intensité normalisée (1 : linéaire).
+     * @param brightness Luminosité globale, de 0 à 1.
+     */
+    void setResponse(double gamma, double brightness);
+
+    /**
+     * @brief Exposant gamma courant.
+     */
+    double gamma() const { return gammaValue; }
+
+    /**
+     * @brief Luminosité globale courante, de 0 à 1.
+     */
+    double brightness() const { return brightnessValue; }
+
+    /**
+     * @brief Active ou désactive la simulation du rafraîchissement par plans de bit.
+     * @param bits Profondeur du panneau, de 1 à MaxPlaneBits (0 : désactive).
+     * @param refreshHz Cycles complets de rafraîchissement par seconde.
+     */
+    void setBitPlanes(int bits, int refreshHz);
+
+    /**
+     * @brief Profondeur du panneau simulé (0 : simulation désactivée).
+     */
+    int planeBits() const { return bits; }
+
+    /**
+     * @brief Indique que la table est l'identité : apply() renvoie l'image telle quelle.
+     */
+    bool isIdentity() const { return identity && bits == 0; }
+
+    /**
+     * @brief Passe une image par la table.
+     * @param frame Image à présenter.
+     * @param nowMs Horloge courante en millisecondes (fin de la fenêtre d'exposition).
+     * @return frame elle-même si la table est l'identité, sinon une copie transformée.
+     */
+    const LedFrame &apply(const LedFrame &frame, qint64 nowMs);
+
+    /**
+     * @brief Indique que la dernière table différait de la précédente : le scintillement
+     * simulé demande des images supplémentaires même sans changement de contenu.
+     */
+    bool isAnimating() const { return bits != 0 && animating; }
+
+    /**
+     * @brief Table appliquée à la dernière image.
+     */
+    const std::array<quint8, 256> &table() const { return current; }
+
+    /**
+     * @brief Remplace chaque intensité non nulle par son entrée de table.
+     */
+    static void applyTable(quint8 *levels, int count, const std::array<quint8, 256> &table);
+
+    /**
+     * @brief Relevé des compteurs.
+     */
+    Statistics statistics() const { return stats; }
+
+    /**
+     * @brief Efface les compteurs.
+     */
+    void reset() { stats = Statistics(); }
+
+private:
+    /**
+     * @brief Recalcule la table gamma et luminosité.
+     */
+    void rebuildResponse();
+
+    /**
+     * @brief Recompose la table de l'image à partir des poids des plans dans la fenêtre d'exposition.
+     * @return Vrai si la table a changé.
+     */
+    bool composePlanes(qint64 nowMs);
+
+    /**
+     * @brief Réglages de la courbe de réponse.
+     */
+    double gammaValue = 1.0;
+    double brightnessValue = 1.0;
+
+    /**
+     * @brief Vrai si la table gamma et luminosité est l'identité.
+     */
+    bool identity = true;
+
+    /**
+     * @brief Réglages du panneau simulé.
+     */
+    int bits = 0;
+    int refreshHz = DefaultRefreshHz;
+
+    /**
+     * @brief Table gamma et luminosité, puis table appliquée (égales hors mode bit-plane).
+     */
+    std::array<quint8, 256> response{};
+    std::array<quint8, 256> current{};
+
+    /**
+     * @brief Vrai si la table appliquée a changé à la dernière image.
+     */
+    bool animating = false;
+
+    /**
+     * @brief Instant de la dernière image (-1 : aucune).
+     */
+    qint64 lastApplyMs = -1;
+
+    /**
+     * @brief Copie transformée de la dernière image.
+     */
+    LedFrame mappedFrame;
+
+    /**
+     * @brief Compteurs.
+     */
+    Statistics stats;
+};
+
+#endif // INTENSITYLUT_H
@@ -0,0 +1,505 @@
+#ifndef KIOSK_H
+#define KIOSK_H
+
+// Inclusion de mes headers
+#include "headers/matrixdisplay.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QColor>
+#include <QSize>
+#include <QRect>
+#include <QVector>
+#include <QFile>
+#include <QImage>
+#include <QElapsedTimer>
+#include <QByteArray>
+#include <QSocketNotifier>
+#include <QTimer>
+
+/**
+ * @file kiosk.h
+ * @author G. Maxime
+ * @brief Déclaration du mode kiosque : configuration sans interface de contrôle.
+ * Le mode kiosque n'instancie que la MatrixDisplay, configurée par la ligne de commande
+ * ou par un fichier INI. Les images peuvent être envoyées dans un fichier framebuffer
+ * au lieu d'une fenêtre, pour les contrôleurs sans écran.
+ */
+
+/**
+ * @struct KioskZoneConfig
+ * @brief Zone supplémentaire de la matrice, lue depuis une section [zoneN] du fichier INI.
+ */
+struct KioskZoneConfig
+{
+    /**
+     * @brief Position et taille de la zone, en LED (clé area=x,y,largeur,hauteur).
+     */
+    QRect area;
+
+    /**
+     * @brief Texte affiché dans la zone.
+     */
+    QString text;
+
+    /**
+     * @brief Couleur des LED allumées de la zone.
+     */
+    QColor pixelColor = QColor(0, 255, 0);
+
+    /**
+     * @brief Politique de défilement (même valeurs que KioskConfig::ScrollPolicy).
+     */
+    int scroll = 0;
+
+    /**
+     * @brief Vitesse de défilement (1 à 5).
+     */
+    int speed = 2;
+
+    /**
+     * @brief Affiche l'horloge au lieu du texte.
+     */
+    bool clock = false;
+
+    /**
+     * @brief Affiche les secondes en mode horloge.
+     */
+    bool clockSeconds = false;
+
+    /**
+     * @brief Utilise le format 12h en mode horloge.
+     */
+    bool clock12h = false;
+
+    /**
+     * @brief Image fixe ou GIF animé affiché au lieu du texte (vide : pas d'image).
+     */
+    QString image;
+
+    /**
+     * @brief Seuillage ou tramage de l'image.
+     */
+    LedImage::Conversion imageConversion = LedImage::OrderedDither;
+};
+
+/**
+ * @struct KioskConfig
+ * @brief Paramètres du mode kiosque, lus depuis un fichier INI puis surchargés par la ligne de commande.
+ */
+struct KioskConfig
+{
+    /**
+     * @brief Politique de défilement demandée.
+     */
+    enum ScrollPolicy {
+        ScrollAuto,
+        ScrollOff,
+        ScrollDefault,
+        ScrollBounce
+    };
+
+    /**
+     * @brief Vrai si l'application doit démarrer en mode kiosque.
+     */
+    bool enabled = false;
+
+    /**
+     * @brief Texte affiché sur la matrice.
+     */
+    QString text = QStringLiteral("HELLO WORLD!");
+
+    /**
+     * @brief Couleur des LED allumées.
+     */
+    QColor pixelColor = QColor(0, 255, 0);
+
+    /**
+     * @brief Couleur du fond.
+     */
+    QColor backgroundColor = Qt::darkGray;
+
+    /**
+     * @brief Politique de défilement (auto : uniquement si le texte dépasse).
+     */
+    ScrollPolicy scroll = ScrollAuto;
+
+    /**
+     * @brief Vitesse de défilement, sur la même échelle que le slider (1 à 5).
+     */
+    int speed = 2;
+
+    /**
+     * @brief Affiche l'horloge au lieu du texte.
+     */
+    bool clock = false;
+
+    /**
+     * @brief Affiche les secondes en mode horloge.
+     */
+    bool clockSeconds = false;
+
+    /**
+     * @brief Utilise le format 12h en mode horloge.
+     */
+    bool clock12h = false;
+
+    /**
+     * @brief Transition jouée lors des changements de contenu.
+     */
+    LedEffects::Transition transition = LedEffects::NoTransition;
+
+    /**
+     * @brief Durée des transitions en millisecondes.
+     */
+    int transitionMs = 400;
+
+    /**
+     * @brief Constante de temps de la rémanence des LED (0 : désactivée).
+     */
+    int afterglowMs = 0;
+
+    /**
+     * @brief Taille de la grille en LED (invalide : grille par défaut de la matrice).
+     */
+    QSize matrixSize;
+
+    /**
+     * @brief Position et taille de la zone principale (invalide : toute la grille).
+     */
+    QRect area;
+
+    /**
+     * @brief Profondeur des indices de palette du mode couleur par LED (4 ou 8 bits).
+     */
+    int paletteBits = 4;
+
+    /**
+     * @brief Zones supplémentaires, empilées au-dessus de la zone principale.
+     */
+    QVector<KioskZoneConfig> zones;
+
+    /**
+     * @brief Ouvre la matrice en plein écran.
+     */
+    bool fullscreen = false;
+
+    /**
+     * @brief Fichier framebuffer de sortie (vide : affichage dans une fenêtre).
+     */
+    QString framebufferPath;
+
+    /**
+     * @brief Taille en pixels des images écrites dans le framebuffer.
+     */
+    QSize framebufferSize = QSize(1200, 144);
+
+    /**
+     * @brief Budget de démarrage jusqu'à la première image, en millisecondes.
+     */
+    int startupBudgetMs = 500;
+
+    /**
+     * @brief Fait échouer la session (code de sortie KioskSession::StartupBudgetExitCode)
+     * quand la première image dépasse le budget de démarrage, au lieu d'un simple avertissement.
+     */
+    bool strictStartup = false;
+
+    /**
+     * @brief Active la mesure des réveils par minute.
+     */
+    bool measureWakeups = false;
+
+    /**
+     * @brief Active la mesure du délai entre chaque changement de contenu et son affichage.
+     */
+    bool measureLatency = false;
+
+    /**
+     * @brief Active l'estimation du courant des LED (journalisée chaque minute).
+     */
+    bool measurePower = false;
+
+    /**
+     * @brief Courant d'une LED en blanc à pleine intensité, en mA.
+     */
+    double ledCurrentMa = 60.0;
+
+    /**
+     * @brief Courant total autorisé pour les LED, en mA (0 : pas de limitation) ; active aussi l'estimation.
+     */
+    double powerLimitMa = 0.0;
+
+    /**
+     * @brief Exposant gamma de la réponse des LED (1 : linéaire).
+     */
+    double gamma = 1.0;
+
+    /**
+     * @brief Luminosité globale des LED, de 0 à 1.
+     */
+    double brightness = 1.0;
+
+    /**
+     * @brief Profondeur du panneau simulé par plans de bit (0 : pas de simulation).
+     */
+    int bitPlanes = 0;
+
+    /**
+     * @brief Fréquence de rafraîchissement du panneau simulé, en Hz.
+     */
+    int pwmRefreshHz = 240;
+
+    /**
+     * @brief Dessine les images dans un thread de rendu dédié.
+     */
+    bool renderThread = false;
+
+    /**
+     * @brief Budget de temps de dessin par image en millisecondes (0 : qualité maximale permanente).
+     */
+    double frameBudgetMs = 0.0;
+
+    /**
+     * @brief Style des LED (points nets ou halo).
+     */
+    LedRenderer::Style ledStyle = LedRenderer::DotStyle;
+
+    /**
+     * @brief Plafond du cache d'images partagé (halos, couches de grille), en Mio.
+     */
+    int spriteCacheMb = 32;
+
+    /**
+     * @brief Affiche en bandeau continu chaque ligne lue sur l'entrée standard (Unix uniquement).
+     */
+    bool tickerStdin = false;
+
+    /**
+     * @brief Image fixe ou GIF animé affiché au lieu du texte dans la zone principale.
+     */
+    QString imagePath;
+
+    /**
+     * @brief Seuillage ou tramage des images (threshold, ordered, color).
+     */
+    LedImage::Conversion imageConversion = LedImage::OrderedDither;
+
+    /**
+     * @brief Flux vidéo brut RGB 24 bits affiché dans la zone principale (« - » : entrée standard, Unix uniquement).
+     */
+    QString videoPath;
+
+    /**
+     * @brief Dimensions des images du flux vidéo, en pixels.
+     */
+    QSize videoSize = QSize(640, 360);
+
+    /**
+     * @brief Nom du segment de mémoire partagée où chaque image est publiée (vide : pas de publication).
+     */
+    QString sharedFrameKey;
+
+    /**
+     * @brief Port TCP de diffusion des images aux visualiseurs distants (0 : pas de diffusion).
+     */
+    int streamPort = 0;
+
+    /**
+     * @brief Fichier JSON Chrome trace écrit à la fermeture (vide : pas de trace, build MATRIX_TRACING).
+     */
+    QString tracePath;
+
+    /**
+     * @brief Lit la ligne de commande (et le fichier --config éventuel).
+     * @param arguments Arguments de l'application.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si la configuration est valide.
+     */
+    bool parse(const QStringList &arguments, QString *errorMessage);
+
+    /**
+     * @brief Lit un fichier de configuration INI (section [kiosk] et sections [zoneN] éventuelles).
+     * @param path Chemin du fichier.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si le fichier a pu être lu.
+     */
+    bool loadFile(const QString &path, QString *errorMessage);
+
+    /**
+     * @brief Indique, avant la création de QApplication, si une sortie framebuffer est demandée.
+     * Permet de basculer sur la plateforme Qt « offscreen » quand aucun écran n'est disponible.
+     */
+    static bool requestsFramebuffer(int argc, char *argv[]);
+};
+
+/**
+ * @class KioskSession
+ * @brief Session kiosque : instancie et pilote une MatrixDisplay seule.
+ * En mode framebuffer, chaque changement d'image est rendu hors écran dans un
+ * fichier projeté en mémoire (pixels 32 bits, format QImage::Format_RGB32).
+ */
+class KioskSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Code de sortie de l'application quand le budget de démarrage est dépassé en mode strict.
+     */
+    static constexpr int StartupBudgetExitCode = 2;
+
+    /**
+     * @brief Constructeur de la session kiosque.
+     * @param config Configuration à appliquer.
+     * @param startupTimer Chronomètre démarré au lancement du processus.
+     * @param parent Objet parent (par défaut nullptr).
+     */
+    KioskSession(const KioskConfig &config, const QElapsedTimer &startupTimer, QObject *parent = nullptr);
+
+    /**
+     * @brief Destructeur : libère la matrice et le framebuffer.
+     */
+    ~KioskSession();
+
+    /**
+     * @brief Crée la matrice, applique la configuration et affiche la première image.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si la session a démarré.
+     */
+    bool start(QString *errorMessage);
+
+private slots:
+    /**
+     * @brief Regroupe les demandes de rendu en une seule écriture par tour de boucle.
+     */
+    void scheduleFramebufferWrite();
+
+    /**
+     * @brief Rend la matrice dans le framebuffer.
+     */
+    void writeFramebuffer();
+
+    /**
+     * @brief Mesure le temps écoulé jusqu'à la première image et le compare au budget.
+     * En mode strict, un dépassement termine la boucle d'événements avec StartupBudgetExitCode.
+     */
+    void reportFirstFrame();
+
+    /**
+     * @brief Journalise une mesure des réveils par minute (--measure-wakeups).
+     */
+    void logWakeupRate(double wakeupsPerMinute);
+
+    /**
+     * @brief Journalise les délais d'affichage de la minute écoulée (--measure-latency).
+     */
+    void logLatency(const LatencyTracker::Report &report);
+
+    /**
+     * @brief Journalise le courant estimé de la minute écoulée (--measure-power, --power-limit).
+     */
+    void logPower(const PowerLimiter::Statistics &statistics);
+
+    /**
+     * @brief Journalise la fin du flux vidéo (--video) : cause éventuelle et compteurs.
+     */
+    void logVideoFinished(const QString &errorMessage, const VideoFeed::Statistics &statistics);
+
+    /**
+     * @brief Compte un changement de qualité adaptative et le journalise si aucun message
+     * n'a été écrit pendant le dernier intervalle.
+     */
+    void logRenderQuality();
+
+    /**
+     * @brief Journalise le niveau de qualité courant et les changements regroupés depuis le
+     * dernier message, puis ouvre un nouvel intervalle (sans effet si rien n'a changé).
+     */
+    void flushRenderQualityLog();
+
+    /**
+     * @brief Ajoute au bandeau les lignes complètes disponibles sur l'entrée standard.
+     */
+    void readTickerInput();
+
+private:
+    /**
+     * @brief Ouvre et projette en mémoire le fichier framebuffer.
+     */
+    bool openFramebuffer(QString *errorMessage);
+
+    /**
+     * @brief Applique la configuration à la matrice.
+     */
+    void applyConfig();
+
+    /**
+     * @brief Applique le contenu d'une zone (texte ou horloge, défilement, couleur).
+     */
+    void applyZone(MatrixZone *zone, const KioskZoneConfig &zoneConfig);
+
+    /**
+     * @brief Configuration de la session.
+     */
+    KioskConfig config;
+
+    /**
+     * @brief Chronomètre démarré au lancement du processus.
+     */
+    QElapsedTimer startupTimer;
+
+    /**
+     * @brief Matrice affichée (seul widget instancié en mode kiosque).
+     */
+    MatrixDisplay *display = nullptr;
+
+    /**
+     * @brief Fichier framebuffer de sortie.
+     */
+    QFile framebufferFile;
+
+    /**
+     * @brief Mémoire projetée du framebuffer (nullptr si la projection est impossible).
+     */
+    uchar *framebufferMemory = nullptr;
+
+    /**
+     * @brief Image de rendu, partageant la mémoire projetée quand elle existe.
+     */
+    QImage frameImage;
+
+    /**
+     * @brief Indique qu'une écriture du framebuffer est déjà programmée.
+     */
+    bool framebufferWritePending = false;
+
+    /**
+     * @brief Indique si la première image a déjà été mesurée.
+     */
+    bool firstFrameReported = false;
+
+    /**
+     * @brief Intervalle minimal entre deux messages de qualité adaptative.
+     */
+    QTimer qualityLogTimer;
+
+    /**
+     * @brief Changements de qualité survenus depuis le dernier message.
+     */
+    int pendingQualityChanges = 0;
+
+    /**
+     * @brief Surveillance de l'entrée standard du bandeau (nullptr si --ticker-stdin n'est pas demandé).
+     */
+    QSocketNotifier *tickerNotifier = nullptr;
+
+    /**
+     * @brief Dernière ligne incomplète lue sur l'entrée standard.
+     */
+    QByteArray tickerPending;
+};
+
+#endif // KIOSK_H
@@ -0,0 +1,199 @@
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+#include <QString>
+
+// Inclusion des headers standard nécessaires
+#include <array>
+
+/**
+ * @file latencytracker.h
+ * @author G. Maxime
+ * @class LatencyTracker
+ * @brief Mesure le délai entre un changement de contenu et la première image affichée qui le montre.
+ * Chaque changement (texte, mode, redimensionnement, dépôt d'un autre thread) est
+ * horodaté, puis suivi à travers trois étapes : mise en page (le contenu est
+ * invalidé), rastérisation (première image calculée après le changement, numérotée)
+ * et présentation (premier paintEvent montrant une image de numéro au moins égal).
+ * Les délais sont cumulés dans des histogrammes à précision relative de 12,5 % :
+ * la mesure n'alloue rien et reste bornée en mémoire quelle que soit sa durée.
+ */
+class LatencyTracker
+{
+public:
+    /**
+     * @brief Origine d'un changement.
+     */
+    enum Source {
+        TextChange,    ///< setText() ou appendText()
+        ModeChange,    ///< setDisplayMode()
+        Resize,        ///< Redimensionnement du widget
+        PostedChange,  ///< Réglage déposé par un autre thread (post*()), depuis le dépôt
+        SourceCount
+    };
+
+    /**
+     * @brief Résumé d'une distribution de délais, en microsecondes.
+     */
+    struct Distribution {
+        quint64 count = 0;
+        qint64 p50Us = 0;
+        qint64 p99Us = 0;
+        qint64 maxUs = 0;
+    };
+
+    /**
+     * @brief Relevé des mesures.
+     */
+    struct Report {
+        Distribution sources[SourceCount];  ///< Délai total par origine
+        Distribution total;                 ///< Délai total, toutes origines
+        Distribution layout;                ///< Du changement à la mise en page
+        Distribution raster;                ///< De la mise en page à la rastérisation
+        Distribution present;               ///< De la rastérisation à la présentation
+        quint64 dropped = 0;                ///< Changements non suivis (trop de changements en attente)
+    };
+
+    /**
+     * @brief Nombre maximal de changements en attente de présentation.
+     */
+    static constexpr int MaxPending = 64;
+
+    /**
+     * @brief Horloge monotone commune à tous les threads, en nanosecondes.
+     */
+    static qint64 nowNs();
+
+    /**
+     * @brief Nom d'une origine, pour les rapports.
+     */
+    static QString sourceName(Source source);
+
+    /**
+     * @brief Active ou désactive la mesure ; désactivée, chaque marque ne coûte qu'un test.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Indique si la mesure est active.
+     */
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Horodate un changement de contenu.
+     * @param source Origine du changement.
+     * @param inputNs Instant du changement (nowNs()).
+     */
+    void markInput(Source source, qint64 inputNs);
+
+    /**
+     * @brief Horodate un changement de contenu à l'instant présent.
+     */
+    void markInput(Source source)
+    {
+        if (enabled)
+            markInput(source, nowNs());
+    }
+
+    /**
+     * @brief Horodate la mise en page des changements qui n'en ont pas encore.
+     */
+    void markLayout();
+
+    /**
+     * @brief Horodate la rastérisation des changements en attente dans l'image numérotée.
+     * @param sequence Numéro de l'image calculée.
+     */
+    void markRasterized(quint64 sequence);
+
+    /**
+     * @brief Termine les changements rastérisés dans une image de numéro inférieur ou égal.
+     * @param sequence Numéro de l'image présentée.
+     */
+    void markPresented(quint64 sequence);
+
+    /**
+     * @brief Nombre de changements en attente de présentation.
+     */
+    int pendingChanges() const { return pendingCount; }
+
+    /**
+     * @brief Relevé des distributions.
+     */
+    Report report() const;
+
+    /**
+     * @brief Efface les mesures et les changements en attente.
+     */
+    void reset();
+
+    /**
+     * @brief Résumé d'un relevé sur une ligne, pour les journaux.
+     */
+    static QString summary(const Report &report);
+
+private:
+    /**
+     * @class Histogram
+     * @brief Histogramme log-linéaire : valeurs exactes sous 16 µs, puis 8 classes par puissance de deux.
+     */
+    class Histogram
+    {
+    public:
+        void add(qint64 valueUs);
+        Distribution distribution() const;
+        void clear();
+
+    private:
+        static constexpr int LinearBuckets = 16;
+        static constexpr int SubBuckets = 8;
+        static constexpr int BucketCount = LinearBuckets + (40 - 4) * SubBuckets;
+        static int bucketFor(qint64 valueUs);
+        static qint64 bucketValue(int bucket);
+        qint64 percentile(int percent) const;
+
+        std::array<quint32, BucketCount> counts{};
+        quint64 count = 0;
+        qint64 maxUs = 0;
+    };
+
+    /**
+     * @brief Changement en cours de suivi (-1 : étape non atteinte).
+     */
+    struct PendingChange {
+        Source source = TextChange;
+        qint64 inputNs = 0;
+        qint64 layoutNs = -1;
+        qint64 rasterNs = -1;
+        quint64 sequence = 0;
+    };
+
+    /**
+     * @brief Vrai si la mesure est active.
+     */
+    bool enabled = false;
+
+    /**
+     * @brief Changements en attente, dans l'ordre d'arrivée.
+     */
+    std::array<PendingChange, MaxPending> pending;
+    int pendingCount = 0;
+
+    /**
+     * @brief Changements ignorés faute de place.
+     */
+    quint64 droppedCount = 0;
+
+    /**
+     * @brief Délais totaux par origine et délais par étape.
+     */
+    Histogram sourceTotals[SourceCount];
+    Histogram total;
+    Histogram layoutStage;
+    Histogram rasterStage;
+    Histogram presentStage;
+};
+
+#endif // LATENCYTRACKER_H
@@ -0,0 +1,129 @@
+#ifndef LEDEFFECTS_H
+#define LEDEFFECTS_H
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+
+/**
+ * @file ledeffects.h
+ * @author G. Maxime
+ * @class LedEffects
+ * @brief Étage d'effets entre la rastérisation et la présentation.
+ * Travaille sur des plans d'intensité (LedFrame) : fondu enchaîné ou balayage entre
+ * l'ancien et le nouveau contenu, et rémanence exponentielle des LED qui s'éteignent.
+ * Les calculs par LED sont faits par blocs de 16 octets (SSE2) avec repli scalaire.
+ */
+class LedEffects
+{
+public:
+    /**
+     * @brief Transitions disponibles lors d'un changement de contenu.
+     */
+    enum Transition {
+        NoTransition,
+        Crossfade,
+        Wipe
+    };
+
+    /**
+     * @brief Choisit la transition appliquée au prochain changement de contenu.
+     * @param transition Type de transition.
+     * @param durationMs Durée de la transition en millisecondes.
+     */
+    void setTransition(Transition transition, int durationMs);
+
+    /**
+     * @brief Constante de temps maximale de la rémanence, en millisecondes.
+     */
+    static constexpr int MaxAfterglowMs = 10000;
+
+    /**
+     * @brief Règle la rémanence des LED qui s'éteignent.
+     * @param decayMs Constante de temps de la décroissance exponentielle (0 pour désactiver),
+     * bornée à MaxAfterglowMs.
+     */
+    void setAfterglow(int decayMs);
+
+    /**
+     * @brief Fournit le nouveau plan rastérisé.
+     * @param target Plan cible produit par la rastérisation.
+     * @param contentChanged Vrai si le contenu a changé (déclenche la transition), faux pour un simple mouvement.
+     * @param nowMs Horloge courante en millisecondes.
+     */
+    void setTarget(const LedFrame &target, bool contentChanged, qint64 nowMs);
+
+    /**
+     * @brief Calcule le plan à présenter à l'instant donné.
+     * @param nowMs Horloge courante en millisecondes.
+     * @return Plan d'intensité à afficher.
+     */
+    const LedFrame &process(qint64 nowMs);
+
+    /**
+     * @brief Indique si une transition ou une rémanence est encore en cours.
+     */
+    bool isAnimating() const;
+
+    /**
+     * @brief Indique si un effet est configuré (sinon process() recopie simplement la cible).
+     */
+    bool isEnabled() const;
+
+private:
+    /**
+     * @brief Transition configurée.
+     */
+    Transition transition = NoTransition;
+
+    /**
+     * @brief Durée des transitions en millisecondes.
+     */
+    int transitionDurationMs = 400;
+
+    /**
+     * @brief Constante de temps de la rémanence (0 : désactivée).
+     */
+    int afterglowMs = 0;
+
+    /**
+     * @brief Plan affiché au moment où la transition a démarré.
+     */
+    LedFrame fromFrame;
+
+    /**
+     * @brief Dernier plan rastérisé.
+     */
+    LedFrame targetFrame;
+
+    /**
+     * @brief Plan intermédiaire de la transition, avant rémanence.
+     */
+    LedFrame blendFrame;
+
+    /**
+     * @brief Plan présenté.
+     */
+    LedFrame outputFrame;
+
+    /**
+     * @brief Indique si une transition est en cours.
+     */
+    bool transitionActive = false;
+
+    /**
+     * @brief Début de la transition en cours.
+     */
+    qint64 transitionStartMs = 0;
+
+    /**
+     * @brief Instant du dernier appel à process() (-1 : aucun).
+     */
+    qint64 lastProcessMs = -1;
+
+    /**
+     * @brief Indique si des LED éteintes rayonnent encore.
+     */
+    bool glowing = false;
+};
+
+#endif // LEDEFFECTS_H
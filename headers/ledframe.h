@@ -0,0 +1,229 @@
+#ifndef LEDFRAME_H
+#define LEDFRAME_H
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+
+// Inclusion des headers standard nécessaires
+#include <vector>
+
+/**
+ * @file ledframe.h
+ * @author G. Maxime
+ * @class LedFrame
+ * @brief Plan d'intensité des LED de la matrice.
+ * Chaque LED est représentée par un octet (0 : éteinte, 255 : pleine intensité),
+ * rangé ligne par ligne. C'est le format échangé entre la rastérisation du contenu,
+ * l'étage d'effets et la présentation.
+ *
+ * Un plan d'encre optionnel associe à chaque LED un indice de palette (LedPalette)
+ * sur 4 ou 8 bits : la couleur par LED coûte un demi-octet ou un octet au lieu
+ * des quatre octets d'une image ARGB.
+ */
+class LedFrame
+{
+public:
+    /**
+     * @brief Intensité d'une LED pleinement allumée.
+     */
+    static constexpr quint8 FullLevel = 255;
+
+    /**
+     * @brief Constructeur d'un plan éteint.
+     * @param cols Nombre de colonnes.
+     * @param rows Nombre de lignes.
+     */
+    explicit LedFrame(int cols = 0, int rows = 0);
+
+    /**
+     * @brief Redimensionne le plan et éteint toutes les LED.
+     */
+    void resize(int cols, int rows);
+
+    /**
+     * @brief Éteint toutes les LED et remet leur encre à l'indice 0.
+     */
+    void clear();
+
+    /**
+     * @brief Choisit la profondeur du plan d'encre et le remet à zéro.
+     * @param bits 0 (pas de plan d'encre), 4 ou 8 bits par LED.
+     */
+    void setInkDepth(int bits);
+
+    /**
+     * @brief Profondeur du plan d'encre, en bits par LED (0 si absent).
+     */
+    int inkDepth() const { return inkBits; }
+
+    /**
+     * @brief Nombre de colonnes du plan.
+     */
+    int cols() const { return columnCount; }
+
+    /**
+     * @brief Nombre de lignes du plan.
+     */
+    int rows() const { return rowCount; }
+
+    /**
+     * @brief Nombre total de LED.
+     */
+    int ledCount() const { return columnCount * rowCount; }
+
+    /**
+     * @brief Indique si le plan a les mêmes dimensions qu'un autre.
+     */
+    bool sameSize(const LedFrame &other) const;
+
+    /**
+     * @brief Accès direct aux intensités, ligne par ligne.
+     */
+    quint8 *data() { return levels.data(); }
+
+    /**
+     * @brief Accès direct en lecture aux intensités, ligne par ligne.
+     */
+    const quint8 *data() const { return levels.data(); }
+
+    /**
+     * @brief Accès direct aux indices de palette (deux LED par octet en 4 bits, vide sans plan d'encre).
+     */
+    quint8 *inkData() { return inks.data(); }
+
+    /**
+     * @brief Accès direct en lecture aux indices de palette.
+     */
+    const quint8 *inkData() const { return inks.data(); }
+
+    /**
+     * @brief Taille du plan d'encre, en octets.
+     */
+    int inkBytes() const { return static_cast<int>(inks.size()); }
+
+    /**
+     * @brief Intensité de la LED (col, row).
+     */
+    quint8 at(int col, int row) const { return levels[static_cast<size_t>(row) * columnCount + col]; }
+
+    /**
+     * @brief Fixe l'intensité de la LED (col, row).
+     */
+    void set(int col, int row, quint8 level) { levels[static_cast<size_t>(row) * columnCount + col] = level; }
+
+    /**
+     * @brief Indice de palette de la LED d'indice donné (ligne par ligne), 0 sans plan d'encre.
+     */
+    quint8 inkAt(int index) const
+    {
+        if (inkBits == 8)
+            return inks[index];
+        if (inkBits == 4)
+            return (inks[index >> 1] >> ((index & 1) * 4)) & 0x0F;
+        return 0;
+    }
+
+    /**
+     * @brief Fixe l'indice de palette de la LED d'indice donné (ignoré sans plan d'encre).
+     */
+    void setInkAt(int index, quint8 ink)
+    {
+        if (inkBits == 8) {
+            inks[index] = ink;
+        } else if (inkBits == 4) {
+            const int shift = (index & 1) * 4;
+            quint8 &packed = inks[index >> 1];
+            packed = static_cast<quint8>((packed & ~(0x0F << shift)) | ((ink & 0x0F) << shift));
+        }
+    }
+
+    /**
+     * @brief Indice de palette de la LED (col, row).
+     */
+    quint8 ink(int col, int row) const { return inkAt(row * columnCount + col); }
+
+    /**
+     * @brief Allume une colonne de glyphe : le bit n du masque allume la ligne firstRow + n.
+     * Les colonnes et lignes hors du plan sont ignorées.
+     * @param col Colonne de la matrice.
+     * @param firstRow Ligne de la matrice correspondant au bit 0.
+     * @param mask Masque de la colonne (un bit par ligne).
+     * @param level Intensité des LED allumées.
+     * @param ink Indice de palette des LED allumées (ignoré sans plan d'encre).
+     */
+    void drawColumnMask(int col, int firstRow, quint32 mask, quint8 level = FullLevel, quint8 ink = 0);
+
+    /**
+     * @brief Éteint les LED d'un rectangle (rogné aux dimensions du plan).
+     */
+    void clearRect(int col, int row, int cols, int rows);
+
+    /**
+     * @brief Copie un rectangle d'un autre plan (intensités et encres), ligne par ligne.
+     * Le rectangle est rogné aux dimensions des deux plans.
+     * @param source Plan source.
+     * @param sourceCol Colonne du coin supérieur gauche dans le plan source.
+     * @param sourceRow Ligne du coin supérieur gauche dans le plan source.
+     * @param col Colonne de destination.
+     * @param row Ligne de destination.
+     * @param cols Largeur du rectangle en LED.
+     * @param rows Hauteur du rectangle en LED.
+     */
+    void copyRect(const LedFrame &source, int sourceCol, int sourceRow, int col, int row, int cols, int rows);
+
+    /**
+     * @brief Reprend l'encre des LED allumées d'un autre plan de même taille.
+     * Les LED éteintes dans target gardent leur encre, pour que les LED qui
+     * s'éteignent progressivement conservent leur couleur.
+     */
+    void mergeInks(const LedFrame &target);
+
+    /**
+     * @brief Indique si au moins une LED est allumée.
+     */
+    bool hasLitLed() const;
+
+    /**
+     * @brief Comparaison LED par LED (intensités et encres).
+     */
+    bool operator==(const LedFrame &other) const;
+
+    /**
+     * @brief Empreinte du plan (dimensions, intensités et encres), stable d'une machine à l'autre.
+     * @return Hachage FNV-1a 64 bits.
+     */
+    quint64 hash() const;
+
+    /**
+     * @brief Différence LED par LED.
+     */
+    bool operator!=(const LedFrame &other) const { return !(*this == other); }
+
+private:
+    /**
+     * @brief Nombre de colonnes.
+     */
+    int columnCount = 0;
+
+    /**
+     * @brief Nombre de lignes.
+     */
+    int rowCount = 0;
+
+    /**
+     * @brief Intensités des LED, ligne par ligne.
+     */
+    std::vector<quint8> levels;
+
+    /**
+     * @brief Profondeur du plan d'encre (0, 4 ou 8 bits par LED).
+     */
+    int inkBits = 0;
+
+    /**
+     * @brief Indices de palette, deux LED par octet en 4 bits.
+     */
+    std::vector<quint8> inks;
+};
+
+#endif // LEDFRAME_H
@@ -0,0 +1,171 @@
+#ifndef LEDIMAGE_H
+#define LEDIMAGE_H
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+#include <QString>
+#include <QImage>
+#include <QSize>
+#include <QRect>
+#include <QRgb>
+#include <QVector>
+#include <QByteArray>
+
+/**
+ * @file ledimage.h
+ * @author G. Maxime
+ * @class LedImage
+ * @brief Image fixe ou animation convertie aux dimensions d'une zone de la matrice.
+ * Chaque image source est réduite par moyenne de surface (chaque LED reçoit la
+ * moyenne exacte des pixels qu'elle recouvre), centrée en conservant ses proportions,
+ * puis seuillée ou tramée en états de LED. Une LED est codée sur un octet : 0 éteinte,
+ * ZoneColorCode allumée dans la couleur de la zone, 1 à 7 allumée dans l'une des
+ * couleurs primaires ou secondaires (bits rouge, vert, bleu) du tramage couleur.
+ *
+ * La conversion est faite une seule fois au chargement : la lecture d'une animation
+ * ne fait que choisir l'image précalculée correspondant au temps écoulé, quelle que
+ * soit la taille de l'image d'origine.
+ */
+class LedImage
+{
+public:
+    /**
+     * @brief Conversion des intensités moyennes en états de LED.
+     */
+    enum Conversion {
+        Threshold,      ///< Allumée si la luminance dépasse la moitié (couleur de la zone)
+        OrderedDither,  ///< Tramage ordonné 4×4 de la luminance (couleur de la zone)
+        ColorDither     ///< Tramage ordonné de chaque composante : huit couleurs, noir compris
+    };
+
+    /**
+     * @brief Code d'une LED allumée dans la couleur de la zone.
+     */
+    static constexpr quint8 ZoneColorCode = 8;
+
+    /**
+     * @brief Nombre de codes de LED distincts (0 à ZoneColorCode).
+     */
+    static constexpr int CodeCount = ZoneColorCode + 1;
+
+    /**
+     * @brief Nombre maximal d'images conservées pour une animation.
+     */
+    static constexpr int MaxFrames = 1024;
+
+    /**
+     * @brief Nom d'une conversion (threshold, ordered, color).
+     */
+    static QString conversionName(Conversion conversion);
+
+    /**
+     * @brief Convertit un nom de conversion (threshold, ordered, color).
+     * @return Faux si le nom est inconnu.
+     */
+    static bool parseConversion(const QString &value, Conversion *conversion);
+
+    /**
+     * @brief Couleur d'un code de tramage couleur (1 à 7).
+     */
+    static QRgb codeColor(quint8 code);
+
+    /**
+     * @brief Rectangle de LED occupé par une image centrée dans la zone, proportions conservées.
+     * @param source Dimensions de l'image, en pixels.
+     * @param leds Dimensions de la zone, en LED.
+     */
+    static QRect fitRect(const QSize &source, const QSize &leds);
+
+    /**
+     * @brief Code d'une LED à partir de sa couleur moyenne, sur fond noir (composantes de 0 à 255).
+     * @param col Colonne de la LED dans la zone (position dans la matrice de tramage).
+     * @param row Ligne de la LED dans la zone.
+     */
+    static quint8 quantize(float red, float green, float blue, int col, int row, Conversion conversion);
+
+    /**
+     * @brief Décode toutes les images d'un fichier (image fixe ou GIF animé).
+     * @param path Fichier à lire.
+     * @param frames Images décodées.
+     * @param delaysMs Durée d'affichage de chaque image, en millisecondes.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si au moins une image a été décodée.
+     */
+    static bool readFrames(const QString &path, QVector<QImage> *frames, QVector<int> *delaysMs,
+                           QString *errorMessage);
+
+    /**
+     * @brief Convertit des images aux dimensions d'une zone.
+     * @param frames Images sources (de tailles quelconques).
+     * @param delaysMs Durée d'affichage de chaque image (ignorée pour une image seule).
+     * @param size Dimensions de la zone, en LED.
+     * @param conversion Seuillage ou tramage appliqué.
+     */
+    static LedImage convert(const QVector<QImage> &frames, const QVector<int> &delaysMs,
+                            const QSize &size, Conversion conversion);
+
+    /**
+     * @brief Dimensions des images converties, en LED.
+     */
+    QSize size() const { return ledSize; }
+
+    /**
+     * @brief Indique qu'aucune image n'est disponible.
+     */
+    bool isEmpty() const { return frames.isEmpty(); }
+
+    /**
+     * @brief Nombre d'images.
+     */
+    int frameCount() const { return frames.size(); }
+
+    /**
+     * @brief Codes des LED d'une image, ligne par ligne.
+     */
+    const QByteArray &frame(int index) const { return frames.at(index); }
+
+    /**
+     * @brief Durée d'un cycle de l'animation, en millisecondes (0 pour une image fixe).
+     */
+    qint64 durationMs() const { return frameEndsMs.isEmpty() ? 0 : frameEndsMs.last(); }
+
+    /**
+     * @brief Durée de l'image la plus courte, en millisecondes (0 pour une image fixe).
+     * Période de réveil de la lecture : aucun changement d'image n'est manqué.
+     */
+    int shortestFrameMs() const { return shortestMs; }
+
+    /**
+     * @brief Image affichée après un temps de lecture donné (l'animation boucle).
+     * @param elapsedMs Temps écoulé depuis le début de la lecture.
+     */
+    int frameAt(qint64 elapsedMs) const;
+
+private:
+    /**
+     * @brief Réduit une image par moyenne de surface et la convertit en codes de LED.
+     */
+    static QByteArray convertFrame(const QImage &source, const QSize &size, Conversion conversion);
+
+    /**
+     * @brief Dimensions des images, en LED.
+     */
+    QSize ledSize;
+
+    /**
+     * @brief Codes des LED de chaque image.
+     */
+    QVector<QByteArray> frames;
+
+    /**
+     * @brief Fin de chaque image depuis le début du cycle, en millisecondes (cumul des durées).
+     */
+    QVector<qint64> frameEndsMs;
+
+    /**
+     * @brief Durée de l'image la plus courte, en millisecondes.
+     */
+    int shortestMs = 0;
+};
+
+#endif // LEDIMAGE_H
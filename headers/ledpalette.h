@@ -0,0 +1,92 @@
+#ifndef LEDPALETTE_H
+#define LEDPALETTE_H
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+#include <QRgb>
+#include <QVector>
+#include <QHash>
+
+/**
+ * @file ledpalette.h
+ * @author G. Maxime
+ * @class LedPalette
+ * @brief Table de couleurs indexée des LED.
+ * Les plans d'intensité ne stockent qu'un indice par LED (4 ou 8 bits) ; la
+ * palette associe chaque indice à une couleur. Les entrées sont ajoutées à la
+ * demande ; une fois la palette pleine, la couleur la plus proche est utilisée
+ * et la palette est signalée comme saturée pour être reconstruite.
+ */
+class LedPalette
+{
+public:
+    /**
+     * @brief Constructeur d'une palette vide.
+     * @param bits Profondeur des indices : 4 (16 couleurs) ou 8 bits (256 couleurs).
+     */
+    explicit LedPalette(int bits = 4);
+
+    /**
+     * @brief Profondeur des indices, en bits.
+     */
+    int depth() const;
+
+    /**
+     * @brief Change la profondeur des indices et vide la palette.
+     */
+    void setDepth(int bits);
+
+    /**
+     * @brief Nombre maximal d'entrées.
+     */
+    int capacity() const;
+
+    /**
+     * @brief Nombre d'entrées utilisées.
+     */
+    int size() const;
+
+    /**
+     * @brief Couleur de l'entrée d'indice donné.
+     */
+    QRgb color(int index) const;
+
+    /**
+     * @brief Indice de la couleur, ajoutée si elle n'existe pas encore.
+     * Si la palette est pleine, renvoie l'entrée la plus proche et marque la palette comme saturée.
+     */
+    quint8 entryFor(QRgb color);
+
+    /**
+     * @brief Vide la palette.
+     */
+    void clear();
+
+    /**
+     * @brief Indique qu'une couleur n'a pas trouvé de place depuis le dernier clear().
+     */
+    bool hasOverflowed() const;
+
+private:
+    /**
+     * @brief Profondeur des indices, en bits.
+     */
+    int bits;
+
+    /**
+     * @brief Couleurs des entrées.
+     */
+    QVector<QRgb> entries;
+
+    /**
+     * @brief Recherche inverse couleur vers indice.
+     */
+    QHash<QRgb, quint8> lookup;
+
+    /**
+     * @brief Indique qu'une couleur a été approchée faute de place.
+     */
+    bool overflowed = false;
+};
+
+#endif // LEDPALETTE_H
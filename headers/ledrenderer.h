@@ -0,0 +1,186 @@
+#ifndef LEDRENDERER_H
+#define LEDRENDERER_H
+
+// Inclusion des headers Qt nécessaires
+#include <QRectF>
+#include <QVector>
+#include <QString>
+#include <QBrush>
+#include <QImage>
+#include <QRgb>
+#include <QSharedPointer>
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+#include "headers/ledpalette.h"
+#include "headers/spritecache.h"
+
+class QPainter;
+
+/**
+ * @file ledrenderer.h
+ * @author G. Maxime
+ * @class LedRenderer
+ * @brief Dessine un plan d'intensité sous forme de LED rondes.
+ * Les LED allumées sont regroupées par encre de palette et par niveau d'intensité :
+ * un seul changement de brush par groupe, et seuls les groupes utilisés sont parcourus.
+ * Les tampons et les brushes sont conservés d'une image à l'autre : en régime établi,
+ * le dessin n'alloue rien. Le dessin n'utilise que QPainter : il peut être fait dans un thread de rendu
+ * sur une QImage, chaque thread ayant alors son propre LedRenderer.
+ *
+ * Plusieurs niveaux de qualité permettent d'alléger le dessin sur une machine
+ * lente ou une très grande matrice (voir AdaptiveQuality).
+ *
+ * Le style « glow » ajoute le halo diffus d'une vraie LED sans flou par image :
+ * un halo gaussien est précalculé par groupe (encre, niveau) pour la taille de
+ * cellule courante, puis les halos des LED allumées sont ajoutés en une passe
+ * additive au-dessus des points. Le halo n'est dessiné qu'en qualité maximale :
+ * c'est le premier détail sacrifié lorsque le budget d'image est dépassé.
+ *
+ * Les LED éteintes des LED rondes sont rastérisées une fois en une couche copiée
+ * d'un seul appel. Couches et halos proviennent du SpriteCache du processus :
+ * des matrices de même taille et de mêmes couleurs partagent les mêmes images.
+ */
+class LedRenderer
+{
+public:
+    /**
+     * @brief Niveaux de qualité, du plus beau au plus rapide.
+     */
+    enum Quality {
+        HighQuality,    ///< LED rondes antialiasées
+        NoAntialiasing, ///< LED rondes sans antialiasing
+        SquareLeds,     ///< LED carrées
+        LitLedsOnly     ///< LED carrées, grille des LED éteintes non dessinée
+    };
+
+    /**
+     * @brief Styles de dessin des LED.
+     */
+    enum Style {
+        DotStyle, ///< Points nets
+        GlowStyle ///< Points entourés d'un halo diffus
+    };
+
+    /**
+     * @brief Nombre de niveaux d'intensité distincts au dessin, par encre.
+     */
+    static constexpr int IntensityBuckets = 32;
+
+    /**
+     * @brief Nom lisible d'un niveau de qualité (pour les journaux).
+     */
+    static QString qualityName(Quality quality);
+
+    /**
+     * @brief Nom d'un style de LED (dot ou glow).
+     */
+    static QString styleName(Style style);
+
+    /**
+     * @brief Dessine la grille de LED.
+     * @param painter Peintre cible (fond déjà rempli).
+     * @param frame Plan d'intensité à afficher.
+     * @param palette Palette des encres du plan.
+     * @param matrixRect Rectangle occupé par la matrice.
+     * @param cellSize Taille d'une cellule (une LED et son espacement).
+     * @param quality Niveau de qualité du dessin.
+     * @param style Style des LED.
+     */
+    void paint(QPainter &painter, const LedFrame &frame, const LedPalette &palette,
+               const QRectF &matrixRect, float cellSize, Quality quality = HighQuality,
+               Style style = DotStyle);
+
+private:
+    /**
+     * @brief Dessine les LED éteintes selon le niveau de qualité.
+     */
+    void paintGrid(QPainter &painter, int cols, int rows, const QRectF &matrixRect,
+                   float cellSize, Quality quality);
+
+    /**
+     * @brief Dessine les LED allumées (texte, horloge), regroupées par encre et par niveau.
+     */
+    void paintLitLeds(QPainter &painter, const LedFrame &frame, const LedPalette &palette,
+                      const QRectF &matrixRect, float cellSize, bool roundLeds);
+
+    /**
+     * @brief Ajoute les halos des LED allumées (groupes de l'image courante) en une passe additive.
+     */
+    void paintGlow(QPainter &painter, const LedPalette &palette, float cellSize);
+
+    /**
+     * @brief Halo d'un groupe, obtenu du cache partagé à la première utilisation puis conservé.
+     * @param bucket Groupe (encre, niveau).
+     * @param ink Encre du groupe.
+     */
+    const QImage &haloSprite(int bucket, QRgb ink);
+
+    /**
+     * @brief Dessine les LED éteintes rondes à partir de la couche partagée de la grille.
+     */
+    void paintRoundGrid(QPainter &painter, int cols, int rows, const QRectF &matrixRect,
+                        float cellSize, bool antialiased);
+
+    /**
+     * @brief LED allumées regroupées par encre et par niveau (réutilisées d'une image à l'autre).
+     */
+    QVector<QVector<QRectF>> levelBuckets;
+
+    /**
+     * @brief Groupes non vides de l'image courante.
+     */
+    QVector<int> usedBuckets;
+
+    /**
+     * @brief LED éteintes d'une ligne, dessinées en un seul appel en mode carré.
+     */
+    QVector<QRectF> gridRow;
+
+    /**
+     * @brief Brush de chaque groupe, recréée seulement si l'encre du groupe change.
+     */
+    QVector<QBrush> bucketBrushes;
+
+    /**
+     * @brief Encre avec laquelle chaque brush de bucketBrushes a été créée.
+     */
+    QVector<QRgb> bucketBrushInks;
+
+    /**
+     * @brief Brush des LED éteintes.
+     */
+    QBrush gridBrush = QBrush(Qt::black);
+
+    /**
+     * @brief Halo de chaque groupe, partagé par le cache (nul : pas encore obtenu).
+     */
+    QVector<QSharedPointer<const QImage>> bucketHalos;
+
+    /**
+     * @brief Encre avec laquelle chaque halo de bucketHalos a été calculé.
+     */
+    QVector<QRgb> bucketHaloInks;
+
+    /**
+     * @brief Taille de cellule des halos calculés, en pixels physiques.
+     */
+    float haloCellPixels = 0.0f;
+
+    /**
+     * @brief Rapport pixels physiques / pixels logiques des halos calculés.
+     */
+    qreal haloDevicePixelRatio = 1.0;
+
+    /**
+     * @brief Couche des LED éteintes de l'image précédente.
+     */
+    QSharedPointer<const QImage> gridLayer;
+
+    /**
+     * @brief Clé de gridLayer dans le cache partagé.
+     */
+    SpriteKey gridLayerKey;
+};
+
+#endif // LEDRENDERER_H
@@ -79,6 +79,16 @@ private slots:
      */
     void toggleBounceCheckboxVisibility();
 
+    /**
+     * @brief Active ou désactive la mesure des réveils par minute de la matrice.
+     */
+    void toggleWakeupMonitoring();
+
+    /**
+     * @brief Journalise une mesure des réveils par minute de la matrice.
+     */
+    void logWakeupRate(double wakeupsPerMinute);
+
 private:
     /**
      * @brief Widget affichant la matrice LED.
@@ -109,6 +119,21 @@ private:
      * @brief Case à cocher contrôlant le mode de défilement (rebond).
      */
     QCheckBox *bounceCheckBox;
+
+    /**
+     * @brief Case à cocher affichant les secondes en mode horloge.
+     */
+    QCheckBox *secondsCheckBox = nullptr;
+
+    /**
+     * @brief Case à cocher activant le format 12h en mode horloge.
+     */
+    QCheckBox *twelveHourCheckBox = nullptr;
+
+    /**
+     * @brief Case à cocher activant le halo des LED.
+     */
+    QCheckBox *glowCheckBox = nullptr;
     
     /**
      * @brief Texte utilisé lorsque l'utilisateur retourne en mode texte sans saisie préalable.
@@ -134,5 +159,10 @@ private:
      * @brief Bouton pour mettre à jour le texte affiché sur la matrice.
      */
     QPushButton *updateButton = nullptr;
+
+    /**
+     * @brief Indique si la mesure des réveils de la matrice est active.
+     */
+    bool wakeupMonitoringEnabled = false;
 };
 #endif // MAINWINDOW_H
\ No newline at end of file
@@ -6,6 +6,31 @@
 #include <QString>
 #include <QColor>
 #include <QTimer>
+#include <QSize>
+#include <QRect>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QRectF>
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+#include "headers/ledeffects.h"
+#include "headers/matrixzone.h"
+#include "headers/zonecompositor.h"
+#include "headers/contentmailbox.h"
+#include "headers/ledrenderer.h"
+#include "headers/renderthread.h"
+#include "headers/adaptivequality.h"
+#include "headers/frameclock.h"
+#include "headers/sharedframe.h"
+#include "headers/framestream.h"
+#include "headers/latencytracker.h"
+#include "headers/powerlimiter.h"
+#include "headers/intensitylut.h"
+
+class QWindow;
+class QPainter;
 
 /**
  * @file matrixdisplay.h
@@ -18,7 +43,9 @@
  * l'activation du défilement peuvent être configurés.
  *
  * La matrice virtuelle possède une grille fixe, reproduisant le comportement
- * d'un véritable panneau LED.
+ * d'un véritable panneau LED. Elle peut être découpée en zones indépendantes
+ * (MatrixZone) composées dans un même plan ; les réglages de la matrice
+ * s'appliquent à la zone principale.
  */
 class MatrixDisplay : public QWidget
 {
@@ -26,20 +53,28 @@ class MatrixDisplay : public QWidget
 
 public:
     /**
-     * @brief Modes d'affichage disponibles pour la matrice LED.
+     * @brief Modes d'affichage disponibles pour la matrice LED (voir MatrixZone).
+     */
+    using DisplayMode = MatrixZone::DisplayMode;
+    static constexpr DisplayMode Text = MatrixZone::Text;
+    static constexpr DisplayMode Clock = MatrixZone::Clock;
+    static constexpr DisplayMode Ticker = MatrixZone::Ticker;
+    static constexpr DisplayMode Image = MatrixZone::Image;
+    static constexpr DisplayMode Video = MatrixZone::Video;
+
+    /**
+     * @brief Modes de défilement du texte (voir MatrixZone).
      */
-    enum DisplayMode {
-        Text,
-        Clock
-    };
+    using ScrollMode = MatrixZone::ScrollMode;
+    static constexpr ScrollMode defaultMode = MatrixZone::defaultMode;
+    static constexpr ScrollMode bounceMode = MatrixZone::bounceMode;
 
     /**
-     * @brief Modes de défilement du texte.
+     * @brief Formats horaires disponibles en mode horloge (voir MatrixZone).
      */
-    enum ScrollMode {
-        defaultMode,
-        bounceMode
-    };
+    using ClockFormat = MatrixZone::ClockFormat;
+    static constexpr ClockFormat Format24h = MatrixZone::Format24h;
+    static constexpr ClockFormat Format12h = MatrixZone::Format12h;
 
     /**
      * @brief Constructeur de la matrice LED.
@@ -51,12 +86,289 @@ public:
      */
     bool requiresScrolling() const;
 
+    /**
+     * @brief Redimensionne la grille de LED (100 x 12 par défaut).
+     * La zone principale suit la nouvelle taille si elle couvrait toute la grille.
+     * @param cols Nombre de colonnes.
+     * @param rows Nombre de lignes.
+     */
+    void setMatrixSize(int cols, int rows);
+
+    /**
+     * @brief Taille de la grille, en LED.
+     */
+    QSize matrixSize() const;
+
+    /**
+     * @brief Ajoute une zone indépendante (texte, horloge ou bandeau défilant) au-dessus des zones existantes.
+     * @param area Position et taille de la zone, en LED.
+     * @return Indice de la zone, à passer à zone() pour la configurer.
+     */
+    int addZone(const QRect &area);
+
+    /**
+     * @brief Choisit la profondeur des indices de palette du mode couleur par LED.
+     * @param bits 4 bits (16 couleurs simultanées, par défaut) ou 8 bits (256 couleurs).
+     */
+    void setPaletteDepth(int bits);
+
+    /**
+     * @brief Profondeur des indices de palette, en bits.
+     */
+    int paletteDepth() const;
+
+    /**
+     * @brief Supprime une zone (la zone principale, d'indice 0, ne peut pas être supprimée).
+     */
+    void removeZone(int index);
+
+    /**
+     * @brief Nombre de zones, zone principale comprise.
+     */
+    int zoneCount() const;
+
+    /**
+     * @brief Zone d'indice donné (0 : zone principale, pilotée par setText(), setColor(), etc.).
+     * @return La zone, ou nullptr si l'indice est invalide.
+     */
+    MatrixZone *zone(int index) const;
+
+    /**
+     * @brief Ouvre un flux vidéo brut dans la zone principale (mode Video).
+     * @param path Fichier ou FIFO d'images RGB 24 bits, ou « - » pour l'entrée standard.
+     * @param frameSize Dimensions des images du flux, en pixels.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si le flux a démarré.
+     */
+    bool openVideo(const QString &path, const QSize &frameSize, QString *errorMessage);
+
+    /**
+     * @brief Indique si la matrice est en veille (fenêtre masquée, minimisée ou non exposée).
+     */
+    bool isSuspended() const;
+
+    /**
+     * @brief Dernière mesure du nombre de réveils par minute (0 tant qu'aucune mesure n'est disponible).
+     */
+    double wakeupsPerMinute() const;
+
+    /**
+     * @brief Indique si les images sont dessinées par le thread de rendu.
+     */
+    bool isRenderThreadEnabled() const;
+
+    /**
+     * @brief Niveau de qualité courant du dessin des LED.
+     */
+    LedRenderer::Quality renderQuality() const;
+
+    /**
+     * @brief Budget de temps par image en millisecondes (0 si la qualité adaptative est désactivée).
+     */
+    double frameTimeBudget() const;
+
+    /**
+     * @brief Durée de la dernière image mesurée par la qualité adaptative, en millisecondes.
+     */
+    double lastFrameTime() const;
+
+    /**
+     * @brief Style courant des LED.
+     */
+    LedRenderer::Style ledStyle() const;
+
+    /**
+     * @brief Remplace la source de temps du défilement, de l'horloge et des effets.
+     * Avec une ManualFrameClock et tick(), chaque image est reproductible.
+     * @param clock Horloge à utiliser (doit survivre à la matrice), FrameClock::systemClock() par défaut.
+     */
+    void setClock(const FrameClock *clock);
+
+    /**
+     * @brief Met toutes les zones à jour pour l'instant courant de l'horloge, sans attendre leurs timers.
+     */
+    void tick();
+
+    /**
+     * @brief Plan d'intensité présenté à l'instant courant de l'horloge (contenu composé puis effets).
+     */
+    const LedFrame &displayFrame();
+
+    /**
+     * @brief Dessine la matrice à l'instant courant avec un peintre fourni (sortie hors écran, tests).
+     * Contrairement à render(), n'envoie aucun paintEvent : un peintre actif peut être réutilisé d'une image à l'autre.
+     */
+    void renderMatrix(QPainter &painter);
+
+    /**
+     * @brief Publie chaque nouvelle image présentée dans un segment de mémoire partagée nommé.
+     * Les lecteurs (SharedFrameReader) obtiennent une image cohérente sans verrou ; la
+     * publication a lieu au moment de la présentation, donc pas en veille.
+     * @param key Nom du segment (vide : arrête la publication).
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si la publication est active (ou arrêtée pour une clé vide).
+     */
+    bool setSharedFrameKey(const QString &key, QString *errorMessage);
+
+    /**
+     * @brief Diffuse chaque nouvelle image présentée aux visualiseurs TCP (FrameStreamServer).
+     * Un visualiseur reçoit une image clé puis les différences ; un visualiseur lent saute
+     * des images sans jamais ralentir l'affichage.
+     * @param port Port d'écoute (0 : port libre, voir frameStream()->port()).
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si le serveur écoute.
+     */
+    bool startFrameStream(quint16 port, QString *errorMessage);
+
+    /**
+     * @brief Serveur de diffusion (nullptr s'il n'est pas démarré).
+     */
+    FrameStreamServer *frameStream() const { return frameStreamer; }
+
+    /**
+     * @brief Délais mesurés entre les changements de contenu et leur premier affichage.
+     */
+    LatencyTracker::Report latencyReport() const;
+
+    /**
+     * @brief Efface les délais mesurés.
+     */
+    void resetLatency();
+
+    /**
+     * @brief Active l'estimation du courant des LED et, si limitMa est positif, la limitation de luminosité.
+     * Les mesures sont émises une fois par minute par powerMeasured() (voir aussi powerStatistics()).
+     * @param ledCurrentMa Courant d'une LED en blanc à pleine intensité, en mA (0 : désactive la mesure).
+     * @param limitMa Courant total autorisé, en mA (0 : mesure seule).
+     */
+    void setPowerBudget(double ledCurrentMa, double limitMa);
+
+    /**
+     * @brief Courant estimé des images présentées depuis le dernier relevé.
+     */
+    PowerLimiter::Statistics powerStatistics() const;
+
+    /**
+     * @brief Efface les mesures de courant.
+     */
+    void resetPowerStatistics();
+
+    /**
+     * @brief Règle la réponse lumineuse des LED : chaque intensité passe par une table gamma et luminosité.
+     * Un changement ne coûte qu'une reconstruction de la table (1 et 1 : réponse linéaire, sans copie).
+     * @param gamma Exposant appliqué à l'intensité normalisée.
+     * @param brightness Luminosité globale, de 0 à 1.
+     */
+    void setIntensityResponse(double gamma, double brightness);
+
+    /**
+     * @brief Simule le rafraîchissement par plans de bit d'un panneau physique (voir IntensityLut).
+     * @param bits Profondeur du panneau, de 1 à 8 (0 : désactive la simulation).
+     * @param refreshHz Cycles complets de rafraîchissement par seconde.
+     */
+    void setBitPlaneSimulation(int bits, int refreshHz = IntensityLut::DefaultRefreshHz);
+
+    /**
+     * @brief Compteurs de la table de réponse (images, reconstructions).
+     */
+    IntensityLut::Statistics intensityStatistics() const;
+
+    /**
+     * @name Dépôt de contenu depuis n'importe quel thread
+     * Ces méthodes ne prennent aucun verrou et ne bloquent jamais : la dernière
+     * valeur de chaque réglage est déposée dans une boîte sans verrou, relevée
+     * par le thread GUI au plus une fois par image et appliquée à la zone
+     * principale. Les valeurs intermédiaires peuvent être abandonnées.
+     * @{
+     */
+    void postText(const QString &text);
+    void postColor(const QColor &color);
+    void postDisplayMode(DisplayMode mode);
+    void postScrollMode(ScrollMode mode);
+    void postScrollEnabled(bool enabled);
+    void postScrollSpeed(int speed);
+    /** @} */
+
+signals:
+    /**
+     * @brief Émis lorsque la matrice entre en veille ou en sort.
+     * @param suspended Vrai si les timers et le rendu sont suspendus.
+     */
+    void suspendedChanged(bool suspended);
+
+    /**
+     * @brief Émis à la fin de chaque fenêtre de mesure des réveils.
+     * @param wakeupsPerMinute Nombre de réveils des timers ramené à la minute.
+     */
+    void wakeupRateMeasured(double wakeupsPerMinute);
+
+    /**
+     * @brief Émis à chaque fois que le contenu de la matrice doit être redessiné.
+     * Permet aux sorties hors écran de suivre les changements sans fenêtre visible.
+     */
+    void frameChanged();
+
+    /**
+     * @brief Émis à la fin de chaque paintEvent (fenêtre ou rendu hors écran).
+     */
+    void framePainted();
+
+    /**
+     * @brief Émis lorsque la qualité adaptative change de niveau.
+     * @param quality Nouveau niveau de qualité.
+     */
+    void renderQualityChanged(LedRenderer::Quality quality);
+
+    /**
+     * @brief Émis une fois par minute quand la mesure de latence est active et qu'un changement a été mesuré.
+     * @param report Délais mesurés pendant la minute écoulée (remis à zéro après l'émission).
+     */
+    void latencyMeasured(const LatencyTracker::Report &report);
+
+    /**
+     * @brief Émis une fois par minute quand l'estimation du courant est active et qu'une image a été présentée.
+     * @param statistics Courant estimé pendant la minute écoulée (remis à zéro après l'émission).
+     */
+    void powerMeasured(const PowerLimiter::Statistics &statistics);
+
+    /**
+     * @brief Émis à la fin du flux vidéo d'une zone (fin du fichier, erreur de lecture).
+     * @param errorMessage Cause de l'arrêt, vide en fin de flux normale.
+     * @param statistics Compteurs du flux à son arrêt.
+     */
+    void videoFinished(const QString &errorMessage, const VideoFeed::Statistics &statistics);
+
 public slots:
     /**
      * @brief Met à jour le texte affiché sur la matrice.
-     * @param text Chaîne à représenter (convertie en majuscules).
+     * @param text Chaîne à représenter (convertie en majuscules). Le balisage {red}, {#ff8000},
+     * {rainbow} et {} change la couleur des caractères suivants (voir MatrixZone).
      */
     void setText(const QString &text);
+
+    /**
+     * @brief Ajoute du texte au bandeau défilant de la zone principale, sans interrompre le défilement.
+     * Passe la zone principale en mode Ticker si nécessaire. Les producteurs d'autres
+     * threads l'appellent par une connexion en file (les ajouts ne doivent pas être abandonnés).
+     */
+    void appendText(const QString &text);
+
+    /**
+     * @brief Charge une image fixe ou un GIF animé dans la zone principale (mode Image).
+     * La conversion aux dimensions de la zone a lieu dans un thread de travail.
+     * @param path Fichier image.
+     */
+    void loadImage(const QString &path);
+
+    /**
+     * @brief Affiche une image fixe dans la zone principale (mode Image).
+     */
+    void setImage(const QImage &image);
+
+    /**
+     * @brief Choisit le seuillage ou le tramage des images de la zone principale.
+     */
+    void setImageConversion(LedImage::Conversion conversion);
     
     /**
      * @brief Modifie la couleur des pixels affichés.
@@ -95,6 +407,73 @@ public slots:
      */
     void setScrollInterval(int interval);
 
+    /**
+     * @brief Active ou désactive l'affichage des secondes en mode horloge.
+     * @param enabled Vrai pour afficher HH:mm:ss, faux pour HH:mm.
+     */
+    void setClockShowSeconds(bool enabled);
+
+    /**
+     * @brief Choisit le format horaire (24h ou 12h) du mode horloge.
+     * @param format Format souhaité.
+     */
+    void setClockFormat(ClockFormat format);
+
+    /**
+     * @brief Active ou désactive la mise en veille automatique lorsque la matrice n'est pas visible.
+     * @param enabled Vrai pour suspendre timers et rendu quand la fenêtre est cachée.
+     */
+    void setPowerSavingEnabled(bool enabled);
+
+    /**
+     * @brief Active ou désactive la mesure des réveils par minute.
+     * @param enabled Vrai pour compter les réveils et émettre wakeupRateMeasured() chaque minute.
+     */
+    void setWakeupMonitoringEnabled(bool enabled);
+
+    /**
+     * @brief Active la mesure du délai entre chaque changement de contenu (texte, mode,
+     * redimensionnement, dépôt d'un autre thread) et le premier paintEvent qui le montre.
+     * Les délais sont émis une fois par minute par latencyMeasured() (voir aussi latencyReport()).
+     */
+    void setLatencyMonitoringEnabled(bool enabled);
+
+    /**
+     * @brief Choisit la transition jouée lors d'un changement de texte ou de mode.
+     * @param transition Fondu enchaîné, balayage ou aucune transition.
+     * @param durationMs Durée de la transition en millisecondes.
+     */
+    void setTransitionEffect(LedEffects::Transition transition, int durationMs = 400);
+
+    /**
+     * @brief Règle la rémanence des LED qui s'éteignent.
+     * @param decayMs Constante de temps de la décroissance exponentielle (0 pour désactiver, au plus LedEffects::MaxAfterglowMs).
+     */
+    void setAfterglow(int decayMs);
+
+    /**
+     * @brief Active ou désactive le thread de rendu.
+     * Activé, les images sont dessinées hors du thread GUI dans une QImage à partir
+     * d'un instantané de la matrice ; paintEvent() ne fait plus que la copier.
+     * @param enabled Vrai pour dessiner dans le thread de rendu.
+     */
+    void setRenderThreadEnabled(bool enabled);
+
+    /**
+     * @brief Définit le budget de temps de dessin par image.
+     * Au-delà, la qualité baisse par paliers (sans antialiasing, LED carrées, grille
+     * éteinte omise) puis remonte lorsque la marge revient.
+     * @param budgetMs Budget en millisecondes (0 pour toujours dessiner en qualité maximale).
+     */
+    void setFrameTimeBudget(double budgetMs);
+
+    /**
+     * @brief Choisit le style des LED : points nets ou points entourés d'un halo.
+     * Le halo est précalculé par taille de cellule et par couleur (voir LedRenderer).
+     * @param style Style souhaité.
+     */
+    void setLedStyle(LedRenderer::Style style);
+
 protected:
     /** 
      * @brief Dessine la matrice LED et le contenu (texte ou horloge).
@@ -112,18 +491,74 @@ protected:
      */
     QSize sizeHint() const override;
 
+    /**
+     * @brief Réévalue la mise en veille lorsque le widget devient visible.
+     */
+    void showEvent(QShowEvent *event) override;
+
+    /**
+     * @brief Met la matrice en veille lorsque le widget est masqué.
+     */
+    void hideEvent(QHideEvent *event) override;
+
+    /**
+     * @brief Surveille les événements d'exposition de la fenêtre native.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     /**
-     * @brief Gestion des mises à jour temporisées (horloge ou scroll).
+     * @brief Changement de l'image composée des zones.
+     * @param contentChanged Vrai pour un changement de contenu pouvant déclencher une transition.
      */
-    void onTimeout();
+    void onZonesChanged(bool contentChanged);
 
-private:
     /**
-     * @brief Relance le timer de défilement si les conditions sont réunies.
+     * @brief Réveil d'un timer de zone, comptabilisé par la mesure des réveils.
      */
-    void restartScrollIfNeeded();
-    
+    void onTimerWakeup();
+
+    /**
+     * @brief Publie la mesure des réveils sur la fenêtre écoulée.
+     */
+    void reportWakeupRate();
+
+    /**
+     * @brief Émet latencyMeasured() avec les délais mesurés depuis le relevé précédent, puis les remet à zéro.
+     */
+    void reportLatency();
+
+    /**
+     * @brief Émet powerMeasured() avec le courant estimé depuis le relevé précédent, puis le remet à zéro.
+     */
+    void reportPower();
+
+    /**
+     * @brief Suspend ou reprend timers et rendu selon la visibilité réelle de la matrice.
+     */
+    void updateSuspendState();
+
+    /**
+     * @brief Image supplémentaire demandée par l'étage d'effets (fondu, rémanence).
+     */
+    void onEffectsTick();
+
+    /**
+     * @brief Fin d'un redimensionnement : un seul rendu complet, à la taille finale.
+     */
+    void finishResize();
+
+    /**
+     * @brief Relève la boîte des producteurs et applique les derniers réglages déposés.
+     */
+    void drainMailbox();
+
+    /**
+     * @brief Prépare l'instantané de l'image courante et le dépose au thread de rendu.
+     */
+    void submitSnapshot();
+
+private:
     /**
      * @brief Calcule la taille d'une cellule en respectant la grille fixe.
      * @return Taille d'une cellule en pixels.
@@ -131,14 +566,82 @@ private:
     float calculateCellSize() const;
 
     /**
-     * @brief Texte affiché sur la matrice (toujours en majuscules).
+     * @brief Taille d'une cellule pour une taille de widget donnée.
      */
-    QString currentText;
+    float cellSizeFor(const QSize &size) const;
 
     /**
-     * @brief Couleur des pixels allumés.
+     * @brief Rectangle occupé par la matrice, centré dans le widget.
+     * @param cellSize Taille d'une cellule en pixels.
+     */
+    QRectF matrixRect(float cellSize) const;
+
+    /**
+     * @brief Rectangle occupé par la matrice, centré dans un widget de taille donnée.
+     */
+    QRectF matrixRectFor(float cellSize, const QSize &size) const;
+
+    /**
+     * @brief Taille à laquelle les LED sont dessinées : celle du début du redimensionnement tant qu'il dure.
+     */
+    QSize renderSize() const;
+
+    /**
+     * @brief Image provisoire d'un redimensionnement : LED dessinées à renderSize(), puis mises à l'échelle.
+     */
+    void paintInterimFrame(QPainter &painter, const LedFrame &frame);
+
+    /**
+     * @brief Indique si la matrice devrait être en veille dans l'état courant.
+     */
+    bool shouldSuspend() const;
+
+    /**
+     * @brief Suit la fenêtre native qui héberge le widget pour détecter exposition et minimisation.
+     */
+    void watchWindowHandle();
+
+    /**
+     * @brief Programme un relevé de la boîte sur le thread GUI, une seule fois jusqu'au relevé suivant.
+     */
+    void wakeMailbox();
+
+    /**
+     * @brief Demande un nouveau rendu et notifie les sorties via frameChanged().
+     */
+    void invalidateFrame();
+
+    /**
+     * @brief Demande un nouveau rendu sans rastériser à nouveau le contenu (effets seuls).
+     */
+    void requestRepaint();
+
+    /**
+     * @brief Programme un seul dépôt d'instantané au thread de rendu, quel que soit le nombre de demandes.
+     */
+    void scheduleSnapshot();
+
+    /**
+     * @brief Rastérise si nécessaire puis applique les effets pour l'instant courant.
+     * @return Plan d'intensité à présenter.
+     */
+    const LedFrame &updateDisplayFrame();
+
+    /**
+     * @brief Dessine la matrice LED et son contenu avec le painter fourni.
+     * @param painter Painter actif sur le widget (ou sur une cible de render()).
+     */
+    void paintMatrix(QPainter &painter);
+
+    /**
+     * @brief Copie la dernière image du thread de rendu (fond seul tant qu'elle n'a pas la taille du widget).
      */
-    QColor pixelColor = Qt::green;
+    void presentRenderedFrame(QPainter &painter);
+
+    /**
+     * @brief Transmet la durée d'une image à la qualité adaptative et signale un changement de niveau.
+     */
+    void recordFrameTime(qint64 frameNs);
 
     /**
      * @brief Couleur des pixels allumés.
@@ -146,38 +649,188 @@ private:
     QColor backgroundColor = Qt::darkGray;
 
     /**
-     * @brief Mode d'affichage actuel (texte ou horloge).
+     * @brief Indique si la mise en veille automatique est autorisée.
+     */
+    bool powerSavingEnabled = true;
+
+    /**
+     * @brief Indique si timers et rendu sont actuellement suspendus.
+     */
+    bool suspended = false;
+
+    /**
+     * @brief Fenêtre native surveillée (exposition et visibilité).
+     */
+    QPointer<QWindow> watchedWindow;
+
+    /**
+     * @brief Indique si la mesure des réveils est active.
+     */
+    bool wakeupMonitoring = false;
+
+    /**
+     * @brief Nombre de réveils des timers depuis le début de la fenêtre de mesure.
+     */
+    int wakeupCount = 0;
+
+    /**
+     * @brief Durée de la fenêtre de mesure en cours.
+     */
+    QElapsedTimer wakeupWindow;
+
+    /**
+     * @brief Dernier taux de réveils mesuré, en réveils par minute.
+     */
+    double lastWakeupRate = 0.0;
+
+    /**
+     * @brief Timer grossier publiant la mesure des réveils une fois par minute.
+     */
+    QTimer *wakeupReportTimer;
+
+    /**
+     * @brief Délais entre changements de contenu et affichage.
+     */
+    LatencyTracker latency;
+
+    /**
+     * @brief Numéro de la dernière image calculée par updateDisplayFrame().
+     */
+    quint64 frameSequence = 0;
+
+    /**
+     * @brief Timer grossier publiant la mesure des délais une fois par minute.
+     */
+    QTimer *latencyReportTimer;
+
+    /**
+     * @brief Réponse lumineuse des LED (gamma, luminosité, plans de bit), avant la limitation de courant.
+     */
+    IntensityLut intensity;
+
+    /**
+     * @brief Estimation du courant et limitation de luminosité des images présentées.
+     */
+    PowerLimiter power;
+
+    /**
+     * @brief Timer grossier publiant le courant estimé une fois par minute.
+     */
+    QTimer *powerReportTimer;
+
+    /**
+     * @brief Regroupe les étapes d'un redimensionnement : expire quand la taille ne change plus.
+     */
+    QTimer *resizeSettleTimer;
+
+    /**
+     * @brief Vrai pendant un redimensionnement (images provisoires mises à l'échelle).
+     */
+    bool resizing = false;
+
+    /**
+     * @brief Taille du widget au début du redimensionnement en cours.
+     */
+    QSize interimSize;
+
+    /**
+     * @brief Matrice dessinée à interimSize (thread GUI), réutilisée tant que l'image ne change pas.
+     */
+    QImage interimImage;
+
+    /**
+     * @brief Indique que interimImage ne montre plus l'image courante.
+     */
+    bool interimStale = true;
+
+    /**
+     * @brief Indique que le contenu a changé et doit être rastérisé à nouveau.
+     */
+    bool rasterDirty = true;
+
+    /**
+     * @brief Indique que le prochain plan rastérisé doit déclencher la transition configurée.
+     */
+    bool transitionPending = false;
+
+    /**
+     * @brief Étage d'effets entre rastérisation et présentation.
+     */
+    LedEffects effects;
+
+    /**
+     * @brief Timer de rafraîchissement actif uniquement pendant les effets.
+     */
+    QTimer *effectsTimer;
+
+    /**
+     * @brief Source de temps des zones, des effets et du relevé de la boîte.
+     */
+    const FrameClock *clock = FrameClock::systemClock();
+
+    /**
+     * @brief Dessin des LED dans le thread GUI (thread de rendu désactivé).
+     */
+    LedRenderer renderer;
+
+    /**
+     * @brief Thread de rendu (nullptr s'il est désactivé).
+     */
+    RenderThread *renderThread = nullptr;
+
+    /**
+     * @brief Publication en mémoire partagée (nullptr si elle est désactivée).
+     */
+    SharedFramePublisher *framePublisher = nullptr;
+
+    /**
+     * @brief Diffusion TCP (nullptr si elle est désactivée).
+     */
+    FrameStreamServer *frameStreamer = nullptr;
+
+    /**
+     * @brief Instantané déposé au thread de rendu (réutilisé d'une image à l'autre).
+     */
+    RenderSnapshot snapshot;
+
+    /**
+     * @brief Indique qu'un dépôt d'instantané est déjà programmé.
+     */
+    bool snapshotPending = false;
+
+    /**
+     * @brief Qualité adaptative du dessin des LED.
      */
-    DisplayMode currentMode;
+    AdaptiveQuality adaptiveQuality;
 
     /**
-     * @brief timeur pour gérer les mises à jour périodiques (scroll ou horloge).
+     * @brief Durée de la dernière image mesurée, en millisecondes.
      */
-    QTimer *timer;
+    double lastFrameMs = 0.0;
 
     /**
-     * @brief Décalage horizontal courant utilisé pendant le défilement.
+     * @brief Style des LED.
      */
-    float scrollOffset;
+    LedRenderer::Style currentLedStyle = LedRenderer::DotStyle;
 
     /**
-     * @brief Indique si le défilement est autorisé en mode texte.
+     * @brief Zones de la matrice et plan composé.
      */
-    bool scrollEnabled;
+    ZoneCompositor *compositor;
 
     /**
-     * @brief Intervalle de défilement en millisecondes.
+     * @brief Derniers réglages déposés par les producteurs.
      */
-    int scrollIntervalMs = 50;
+    ContentMailbox mailbox;
 
     /**
-     * @brief Mode de défilement actuel.
+     * @brief Timer différant un relevé trop proche du précédent.
      */
-    ScrollMode scrollMode = defaultMode;
+    QTimer *mailboxTimer;
 
     /**
-     * @brief Direction actuelle du défilement (1 gauche à droite, -1 pour droite à gauche).
+     * @brief Instant du dernier relevé de la boîte (référence clock).
      */
-    int scrollDirection = 1; 
+    qint64 lastMailboxDrainMs = -1;
 };
 #endif // MATRIXDISPLAY_H
\ No newline at end of file
@@ -17,6 +17,9 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <array>
+#include <cstdint>
+#include <algorithm>
 
 
 /**
@@ -481,4 +484,66 @@ inline std::map<char, std::vector<std::string>> matrix_font ={
 
 };
 
+static_assert(CHAR_ROWS <= 8, "Les colonnes précalculées stockent une ligne par bit d'un octet.");
+
+/**
+ * @brief Colonnes précalculées d'un caractère.
+ *
+ * Chaque octet représente une colonne du glyphe : le bit n est à 1
+ * lorsque le pixel de la ligne n est allumé.
+ */
+using GlyphColumns = std::array<std::uint8_t, CHAR_COLS>;
+
+/**
+ * @brief Table des colonnes précalculées, indexée par le code du caractère.
+ */
+struct GlyphTable {
+    /**
+     * @brief Colonnes de chaque caractère (vides si le caractère n'est pas défini).
+     */
+    std::array<GlyphColumns, 256> columns{};
+
+    /**
+     * @brief Indique si le caractère existe dans matrix_font.
+     */
+    std::array<bool, 256> defined{};
+};
+
+/**
+ * @brief Retourne la table des colonnes, construite une seule fois à partir de matrix_font.
+ */
+inline const GlyphTable &glyphTable()
+{
+    static const GlyphTable table = [] {
+        GlyphTable built;
+        for (const auto &[c, rows] : matrix_font) {
+            const auto index = static_cast<unsigned char>(c);
+            GlyphColumns &columns = built.columns[index];
+            const int rowCount = std::min(CHAR_ROWS, static_cast<int>(rows.size()));
+            for (int row = 0; row < rowCount; ++row) {
+                const int colCount = std::min(CHAR_COLS, static_cast<int>(rows[row].size()));
+                for (int col = 0; col < colCount; ++col) {
+                    if (rows[row][col] == '1')
+                        columns[col] |= static_cast<std::uint8_t>(1u << row);
+                }
+            }
+            built.defined[index] = true;
+        }
+        return built;
+    }();
+    return table;
+}
+
+/**
+ * @brief Retourne les colonnes précalculées d'un caractère.
+ * @param c Caractère recherché.
+ * @return Pointeur vers les colonnes, ou nullptr si le caractère n'est pas défini.
+ */
+inline const GlyphColumns *glyphColumns(char c)
+{
+    const GlyphTable &table = glyphTable();
+    const auto index = static_cast<unsigned char>(c);
+    return table.defined[index] ? &table.columns[index] : nullptr;
+}
+
 #endif // MATRIXFONT_H
\ No newline at end of file
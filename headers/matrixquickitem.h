@@ -0,0 +1,177 @@
+#ifndef MATRIXQUICKITEM_H
+#define MATRIXQUICKITEM_H
+
+// Inclusion des headers Qt nécessaires
+#include <QQuickItem>
+#include <QString>
+#include <QColor>
+
+// Inclusion de mes headers
+#include "headers/matrixzone.h"
+#include "headers/zonecompositor.h"
+#include "headers/frameclock.h"
+
+/**
+ * @file matrixquickitem.h
+ * @author G. Maxime
+ * @class MatrixQuickItem
+ * @brief Variante Qt Quick de MatrixDisplay, pour les tableaux de bord QML (type LedMatrix).
+ * Le texte, le défilement et l'horloge sont produits par le même moteur que le widget
+ * (ZoneCompositor et ses MatrixZone). Le dessin, lui, est un arbre de nœuds du
+ * graphe de scène conservé d'une image à l'autre :
+ * - un rectangle de fond et une image des LED éteintes, refaits seulement quand la
+ *   taille des cellules change ;
+ * - un atlas de texture d'une cellule par encre et par niveau d'intensité, dessiné
+ *   une fois par LedRenderer ;
+ * - un nœud image par LED allumée, pointant sur sa cellule de l'atlas.
+ * À chaque image, seules les LED dont l'état (encre, niveau) a changé modifient
+ * leur nœud : rien n'est redessiné ni renvoyé pour les autres. Les nœuds n'utilisent
+ * que des images et des rectangles : l'élément fonctionne avec le moteur de rendu
+ * logiciel de Qt Quick, sans GPU.
+ */
+class MatrixQuickItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QString text READ text WRITE setText NOTIFY textChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor backgroundColor READ backgroundColor WRITE setBackgroundColor NOTIFY backgroundColorChanged)
+    Q_PROPERTY(bool clockMode READ clockMode WRITE setClockMode NOTIFY clockModeChanged)
+    Q_PROPERTY(bool scrollEnabled READ scrollEnabled WRITE setScrollEnabled NOTIFY scrollEnabledChanged)
+    Q_PROPERTY(int scrollInterval READ scrollInterval WRITE setScrollInterval NOTIFY scrollIntervalChanged)
+
+public:
+    /**
+     * @brief Compteurs de mise à jour du graphe de scène.
+     */
+    struct Statistics {
+        quint64 frames = 0;        ///< Appels à updatePaintNode()
+        quint64 changedLeds = 0;   ///< Nœuds de LED créés, modifiés ou retirés
+        quint64 atlasBuilds = 0;   ///< Atlas et images de la grille refaits (taille ou palette)
+        int litNodes = 0;          ///< Nœuds de LED allumées dans le graphe
+    };
+
+    /**
+     * @brief Constructeur de l'élément.
+     * @param parent Élément parent (par défaut nullptr).
+     */
+    explicit MatrixQuickItem(QQuickItem *parent = nullptr);
+
+    /**
+     * @brief Enregistre le type QML LedMatrix dans le module MatrixDisplay 1.0.
+     */
+    static void registerQmlType();
+
+    /**
+     * @brief Texte de la zone principale.
+     */
+    QString text() const;
+    void setText(const QString &text);
+
+    /**
+     * @brief Couleur des LED de la zone principale.
+     */
+    QColor color() const;
+    void setColor(const QColor &color);
+
+    /**
+     * @brief Couleur du fond derrière la matrice.
+     */
+    QColor backgroundColor() const { return background; }
+    void setBackgroundColor(const QColor &color);
+
+    /**
+     * @brief Vrai si la zone principale affiche l'heure au lieu du texte.
+     */
+    bool clockMode() const;
+    void setClockMode(bool enabled);
+
+    /**
+     * @brief Défilement du texte de la zone principale.
+     */
+    bool scrollEnabled() const { return scrolling; }
+    void setScrollEnabled(bool enabled);
+
+    /**
+     * @brief Vitesse de défilement de la zone principale (voir MatrixZone::setScrollInterval()).
+     */
+    int scrollInterval() const { return scrollSpeed; }
+    void setScrollInterval(int interval);
+
+    /**
+     * @brief Change la taille de la grille de LED.
+     */
+    void setMatrixSize(int cols, int rows);
+
+    /**
+     * @brief Zone d'indice donné, pour les réglages non exposés en propriétés (nullptr si invalide).
+     */
+    MatrixZone *zone(int index) const;
+
+    /**
+     * @brief Change la source de temps du moteur (horloge manuelle des tests).
+     */
+    void setClock(const FrameClock *clock);
+
+    /**
+     * @brief Met les zones à jour pour l'instant courant de l'horloge.
+     */
+    void tick();
+
+    /**
+     * @brief Relevé des compteurs (lu entre deux images).
+     */
+    Statistics statistics() const { return stats; }
+
+signals:
+    void textChanged();
+    void colorChanged();
+    void backgroundColorChanged();
+    void clockModeChanged();
+    void scrollEnabledChanged();
+    void scrollIntervalChanged();
+
+protected:
+    /**
+     * @brief Met à jour l'arbre de nœuds conservé (thread de rendu, thread GUI bloqué).
+     */
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+    /**
+     * @brief Redimensionnement : la taille des cellules est recalculée à la prochaine image.
+     */
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private:
+    /**
+     * @brief Taille d'une cellule pour la taille courante de l'élément.
+     */
+    float cellSize(qreal devicePixelRatio) const;
+
+    /**
+     * @brief Moteur de contenu partagé avec MatrixDisplay.
+     */
+    ZoneCompositor *compositor;
+
+    /**
+     * @brief Couleur du fond.
+     */
+    QColor background = Qt::black;
+
+    /**
+     * @brief Réglages du défilement de la zone principale.
+     */
+    bool scrolling = false;
+    int scrollSpeed = 2;
+
+    /**
+     * @brief Indique que la taille de l'élément a changé depuis la dernière image.
+     */
+    bool geometryDirty = true;
+
+    /**
+     * @brief Compteurs, mis à jour par updatePaintNode().
+     */
+    Statistics stats;
+};
+
+#endif // MATRIXQUICKITEM_H
@@ -0,0 +1,683 @@
+#ifndef MATRIXZONE_H
+#define MATRIXZONE_H
+
+// Inclusion des headers Qt nécessaires
+#include <QObject>
+#include <QString>
+#include <QColor>
+#include <QTimer>
+#include <QTime>
+#include <QRect>
+#include <QVector>
+#include <QByteArray>
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+#include "headers/ledpalette.h"
+#include "headers/frameclock.h"
+#include "headers/ledimage.h"
+#include "headers/videofeed.h"
+
+class QThread;
+
+/**
+ * @file matrixzone.h
+ * @author G. Maxime
+ * @class MatrixZone
+ * @brief Zone rectangulaire de la matrice avec son propre contenu.
+ * Une zone affiche du texte (fixe ou défilant) ou l'heure, avec sa couleur, son
+ * mode et sa vitesse de défilement. Elle possède ses propres timers et rastérise
+ * son contenu dans un plan d'intensité à ses dimensions, conservé tant que le
+ * contenu ne change pas : une zone statique ne coûte rien d'une image à l'autre.
+ *
+ * Le défilement est exprimé en colonnes de LED, indépendamment de la taille
+ * des cellules à l'écran. Sa position et l'heure affichée sont calculées à
+ * partir d'une FrameClock : les timers ne font que réveiller la zone.
+ *
+ * Le texte accepte un balisage de couleur : {red}, {#ff8000} ou tout nom de
+ * couleur SVG sélectionne l'encre des caractères suivants, {rainbow} applique
+ * un dégradé arc-en-ciel et {} revient à la couleur de la zone. Les couleurs
+ * sont converties en indices de la palette partagée au moment de la rastérisation.
+ *
+ * Le texte est conservé sous forme d'indices de glyphes (un octet par caractère)
+ * et de plages d'encre. La rastérisation calcule directement la plage de caractères
+ * visibles à partir du défilement : un message de 100 000 caractères ne coûte pas
+ * plus cher par image qu'un message court.
+ *
+ * En mode Ticker, la zone défile en continu comme un bandeau d'actualités :
+ * appendText() ajoute du texte en fin de bande sans interrompre le défilement.
+ * La bande est un tampon circulaire de colonnes déjà rastérisées ; les colonnes
+ * sorties par la gauche sont libérées, la mémoire reste bornée en fonctionnement continu.
+ *
+ * En mode Image, la zone affiche une image fixe ou animée (LedImage). Toutes les
+ * images sont converties une seule fois aux dimensions de la zone, dans un thread
+ * de travail ; la lecture ne fait qu'échanger des images précalculées.
+ *
+ * En mode Video, la zone affiche un flux d'images brutes (VideoFeed) lu et réduit
+ * hors du thread GUI ; la zone ne fait que reprendre la dernière image convertie.
+ */
+class MatrixZone : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Modes d'affichage disponibles pour une zone.
+     */
+    enum DisplayMode {
+        Text,
+        Clock,
+        Ticker,
+        Image,
+        Video
+    };
+
+    /**
+     * @brief Modes de défilement du texte.
+     */
+    enum ScrollMode {
+        defaultMode,
+        bounceMode
+    };
+
+    /**
+     * @brief Formats horaires disponibles en mode horloge.
+     */
+    enum ClockFormat {
+        Format24h,
+        Format12h
+    };
+
+    /**
+     * @brief Constructeur d'une zone.
+     * @param area Position et taille de la zone, en LED.
+     * @param palette Palette partagée dans laquelle les couleurs de la zone sont indexées.
+     * @param clock Source de temps du défilement et de l'horloge.
+     * @param parent Objet parent (par défaut nullptr).
+     */
+    MatrixZone(const QRect &area, LedPalette *palette, const FrameClock *clock, QObject *parent = nullptr);
+
+    /**
+     * @brief Destructeur : attend la fin d'une conversion d'image en cours et arrête le flux vidéo.
+     */
+    ~MatrixZone() override;
+
+    /**
+     * @brief Change la source de temps (le défilement repart de sa position courante).
+     */
+    void setClock(const FrameClock *clock);
+
+    /**
+     * @brief Met le contenu à jour pour l'instant courant de l'horloge (défilement, heure).
+     * Appelé par les timers de la zone ; permet de piloter la zone avec une horloge manuelle.
+     */
+    void tick();
+
+    /**
+     * @brief Position et taille de la zone, en LED.
+     */
+    QRect area() const;
+
+    /**
+     * @brief Texte courant (en majuscules, sans balisage de couleur ; caractères hors Latin-1 remplacés par '\0').
+     */
+    QString text() const;
+
+    /**
+     * @brief Couleur des LED allumées de la zone.
+     */
+    QColor color() const;
+
+    /**
+     * @brief Mode d'affichage courant.
+     */
+    DisplayMode displayMode() const;
+
+    /**
+     * @brief Indique si le texte courant dépasse la largeur de la zone.
+     */
+    bool requiresScrolling() const;
+
+    /**
+     * @brief Indique qu'une conversion d'image est en cours dans le thread de travail.
+     */
+    bool isImageLoading() const;
+
+    /**
+     * @brief Affiche une animation fournie image par image (passe la zone en mode Image).
+     * @param frames Images sources, de tailles quelconques.
+     * @param delaysMs Durée d'affichage de chaque image, en millisecondes.
+     */
+    void setAnimation(const QVector<QImage> &frames, const QVector<int> &delaysMs);
+
+    /**
+     * @brief Ouvre un flux vidéo brut et passe la zone en mode Video.
+     * @param path Fichier ou FIFO d'images RGB 24 bits, ou « - » pour l'entrée standard.
+     * @param frameSize Dimensions des images du flux, en pixels.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si le flux a démarré.
+     */
+    bool openVideo(const QString &path, const QSize &frameSize, QString *errorMessage);
+
+    /**
+     * @brief Compteurs du flux vidéo en cours (nuls hors du mode Video).
+     */
+    VideoFeed::Statistics videoStatistics() const;
+
+    /**
+     * @brief Indique si la zone a quelque chose à afficher (horloge, texte non vide ou bande non vide).
+     */
+    bool hasContent() const;
+
+    /**
+     * @brief Indique que le contenu a changé depuis la dernière rastérisation.
+     */
+    bool isDirty() const;
+
+    /**
+     * @brief Plan d'intensité de la zone, rastérisé à nouveau seulement si le contenu a changé.
+     */
+    const LedFrame &frame();
+
+    /**
+     * @brief Force une nouvelle rastérisation (par exemple après reconstruction de la palette).
+     */
+    void invalidate();
+
+    /**
+     * @brief Arrête les timers de la zone (matrice en veille).
+     */
+    void suspend();
+
+    /**
+     * @brief Relance les timers et rattrape le défilement correspondant au temps passé en veille.
+     */
+    void resume();
+
+    /**
+     * @brief Repart du début du défilement (par exemple après un redimensionnement).
+     */
+    void restartScroll();
+
+public slots:
+    /**
+     * @brief Déplace ou redimensionne la zone.
+     * @param area Position et taille de la zone, en LED.
+     */
+    void setArea(const QRect &area);
+
+    /**
+     * @brief Met à jour le texte affiché dans la zone.
+     * @param text Chaîne à représenter (convertie en majuscules), avec balisage de couleur éventuel.
+     */
+    void setText(const QString &text);
+
+    /**
+     * @brief Ajoute du texte en fin de bande du mode Ticker, sans interrompre le défilement.
+     * Passe la zone en mode Ticker si nécessaire. Le texte entre par le bord droit
+     * après le texte déjà en attente ; au-delà de la capacité de la bande, il est tronqué.
+     * @param text Chaîne à ajouter (convertie en majuscules), avec balisage de couleur éventuel.
+     */
+    void appendText(const QString &text);
+
+    /**
+     * @brief Charge une image fixe ou un GIF animé et passe la zone en mode Image.
+     * Le décodage et la conversion ont lieu dans un thread de travail ; la zone
+     * reste vide (ou garde l'image précédente) jusqu'à la fin de la conversion.
+     * @param path Fichier image (tout format lisible par QImageReader).
+     */
+    void loadImage(const QString &path);
+
+    /**
+     * @brief Affiche une image fixe et passe la zone en mode Image.
+     */
+    void setImage(const QImage &source);
+
+    /**
+     * @brief Choisit le seuillage ou le tramage des images (l'image courante est reconvertie).
+     */
+    void setImageConversion(LedImage::Conversion conversion);
+
+    /**
+     * @brief Modifie la couleur des LED allumées de la zone.
+     */
+    void setColor(const QColor &color);
+
+    /**
+     * @brief Bascule entre les modes texte, horloge, bandeau, image et vidéo (la bande repart vide).
+     * Quitter le mode Video arrête le flux.
+     */
+    void setDisplayMode(DisplayMode mode);
+
+    /**
+     * @brief Définit le mode de défilement.
+     */
+    void setScrollMode(ScrollMode mode);
+
+    /**
+     * @brief Active ou désactive le défilement du texte.
+     */
+    void setScrollEnabled(bool enabled);
+
+    /**
+     * @brief Définit la vitesse de défilement, sur l'échelle du slider (1 à 5).
+     * @param speed Vitesse souhaitée (2 : une colonne toutes les 50 ms).
+     */
+    void setScrollInterval(int speed);
+
+    /**
+     * @brief Active ou désactive l'affichage des secondes en mode horloge.
+     */
+    void setClockShowSeconds(bool enabled);
+
+    /**
+     * @brief Choisit le format horaire (24h ou 12h) du mode horloge.
+     */
+    void setClockFormat(ClockFormat format);
+
+signals:
+    /**
+     * @brief Émis lorsque l'image de la zone change.
+     * @param contentChanged Vrai pour un changement de contenu (texte, mode) pouvant déclencher une transition.
+     */
+    void changed(bool contentChanged);
+
+    /**
+     * @brief Émis lorsque la position ou la taille de la zone change.
+     */
+    void areaChanged();
+
+    /**
+     * @brief Émis à chaque réveil d'un timer de la zone (mesure des réveils).
+     */
+    void timerWokeUp();
+
+    /**
+     * @brief Émis à la fin du flux vidéo de la zone (fin du fichier, erreur de lecture).
+     * @param errorMessage Cause de l'arrêt, vide en fin de flux normale.
+     * @param statistics Compteurs du flux à son arrêt.
+     */
+    void videoFinished(const QString &errorMessage, const VideoFeed::Statistics &statistics);
+
+private slots:
+    /**
+     * @brief Réveil d'un timer : comptabilise le réveil puis appelle onTimeout().
+     */
+    void onTimerWakeup();
+
+    /**
+     * @brief Fin de la conversion d'image : installe les images converties (ou relance une conversion plus récente).
+     */
+    void onImageConverted();
+
+    /**
+     * @brief Nouvelle image du flux vidéo : reprise et rastérisation à la prochaine image.
+     */
+    void onVideoFrame();
+
+    /**
+     * @brief Fin du flux vidéo : émet videoFinished() avec la cause et les compteurs, la dernière image reste affichée.
+     */
+    void onVideoFinished(const QString &errorMessage);
+
+private:
+    /**
+     * @brief Encre d'un caractère, issue du balisage du texte.
+     */
+    struct TextInk {
+        enum Kind {
+            ZoneColor,
+            Fixed,
+            Rainbow
+        };
+        Kind kind = ZoneColor;
+        QRgb rgb = 0;
+    };
+
+    /**
+     * @brief Plage de caractères partageant la même encre, jusqu'au début de la plage suivante.
+     */
+    struct InkRun {
+        int start = 0;
+        TextInk ink;
+    };
+
+    /**
+     * @brief Sépare le texte de son balisage de couleur.
+     * @param markup Texte saisi.
+     * @param glyphs Indices de glyphes du texte sans balises, en majuscules (code Latin-1 du caractère).
+     * @param runs Plages d'encre, triées par début (vide si aucun balisage de couleur).
+     */
+    static void parseMarkup(const QString &markup, QByteArray *glyphs, QVector<InkRun> *runs);
+
+    /**
+     * @brief Indice de la plage d'encre contenant un caractère (recherche dichotomique).
+     */
+    int inkRunAt(int index) const;
+
+    /**
+     * @brief Mise à jour temporisée (horloge ou défilement).
+     */
+    void onTimeout();
+
+    /**
+     * @brief Relance le timer de défilement si les conditions sont réunies.
+     */
+    void restartScrollIfNeeded();
+
+    /**
+     * @brief Recalcule les colonnes LED de l'horloge à partir de l'heure fournie.
+     * @return Vrai si une colonne a changé.
+     */
+    bool updateClockColumns(const QTime &now);
+
+    /**
+     * @brief Programme le prochain réveil de l'horloge sur la frontière de seconde suivante.
+     */
+    void scheduleClockTick(const QTime &now);
+
+    /**
+     * @brief Fait avancer le défilement d'un nombre de pas donné (un pas = une colonne).
+     */
+    void advanceScroll(qint64 steps);
+
+    /**
+     * @brief Vide la bande du mode Ticker et libère ses colonnes.
+     */
+    void clearTicker();
+
+    /**
+     * @brief Agrandit la bande pour contenir un nombre de colonnes donné (puissance de deux, plafonnée).
+     * @return Faux si la capacité maximale de la bande ne le permet pas.
+     */
+    bool reserveTickerColumns(qint64 columns);
+
+    /**
+     * @brief Rastérise du texte en fin de bande, après une marge éventuelle jusqu'au bord droit de la zone.
+     * @param glyphs Indices de glyphes du texte.
+     * @param runs Plages d'encre du texte.
+     */
+    void appendTickerGlyphs(const QByteArray &glyphs, const QVector<InkRun> &runs);
+
+    /**
+     * @brief Ajoute une colonne en fin de bande (la capacité doit avoir été réservée).
+     * @param mask Colonne du glyphe (un bit par ligne).
+     * @param rgb Couleur de la colonne (kTickerZoneColor : couleur de la zone).
+     */
+    void pushTickerColumn(quint8 mask, QRgb rgb);
+
+    /**
+     * @brief Fait avancer la bande d'un nombre de pas donné et libère les colonnes sorties.
+     */
+    void advanceTicker(qint64 steps);
+
+    /**
+     * @brief Rastérise la partie visible de la bande.
+     */
+    void rasterizeTicker(quint8 zoneInk);
+
+    /**
+     * @brief Lance la conversion de l'image source aux dimensions courantes de la zone.
+     * Une conversion déjà en cours est laissée finir puis relancée avec la source à jour.
+     */
+    void startImageConversion();
+
+    /**
+     * @brief Démarre la lecture de l'animation à sa première image.
+     */
+    void startImagePlayback();
+
+    /**
+     * @brief Choisit l'image de l'animation correspondant au temps écoulé.
+     */
+    void advanceImage();
+
+    /**
+     * @brief Rastérise des codes de LED (LedImage) aux dimensions de la zone.
+     * @param codes Codes des LED, ligne par ligne.
+     * @param size Dimensions des codes : rien n'est dessiné si elles diffèrent de la zone.
+     */
+    void rasterizeCodes(const QByteArray &codes, const QSize &size, quint8 zoneInk);
+
+    /**
+     * @brief Largeur du texte courant en colonnes de LED.
+     */
+    int textWidthInCols() const;
+
+    /**
+     * @brief Rastérise le contenu courant dans le plan de la zone.
+     */
+    void rasterize();
+
+    /**
+     * @brief Marque le contenu comme modifié et le signale.
+     */
+    void markDirty(bool contentChanged);
+
+    /**
+     * @brief Position et taille de la zone, en LED.
+     */
+    QRect zoneArea;
+
+    /**
+     * @brief Texte affiché, en indices de glyphes (un octet par caractère, toujours en majuscules).
+     */
+    QByteArray textGlyphs;
+
+    /**
+     * @brief Plages d'encre de textGlyphs (vide : couleur de la zone partout).
+     */
+    QVector<InkRun> inkRuns;
+
+    /**
+     * @brief Couleur des LED allumées.
+     */
+    QColor pixelColor = QColor(0, 255, 0);
+
+    /**
+     * @brief Palette partagée des encres.
+     */
+    LedPalette *palette;
+
+    /**
+     * @brief Mode d'affichage actuel.
+     */
+    DisplayMode currentMode = Text;
+
+    /**
+     * @brief Timer du défilement.
+     */
+    QTimer *timer;
+
+    /**
+     * @brief Timer précis à tir unique, recalé sur chaque frontière de seconde en mode horloge.
+     */
+    QTimer *clockTimer;
+
+    /**
+     * @brief Colonnes LED de l'horloge (un octet par colonne de la zone, un bit par ligne de glyphe).
+     */
+    QVector<quint8> clockColumns;
+
+    /**
+     * @brief Colonnes calculées au réveil, comparées à clockColumns (réutilisées d'un réveil à l'autre).
+     */
+    QVector<quint8> nextClockColumns;
+
+    /**
+     * @brief Indique si les secondes sont affichées en mode horloge.
+     */
+    bool clockShowSeconds = false;
+
+    /**
+     * @brief Format horaire du mode horloge.
+     */
+    ClockFormat clockFormat = Format24h;
+
+    /**
+     * @brief Décalage courant du défilement, en colonnes de LED.
+     */
+    int scrollOffset = 0;
+
+    /**
+     * @brief Indique si le défilement est autorisé en mode texte.
+     */
+    bool scrollEnabled = false;
+
+    /**
+     * @brief Intervalle de défilement en millisecondes.
+     */
+    int scrollIntervalMs = 50;
+
+    /**
+     * @brief Mode de défilement actuel.
+     */
+    ScrollMode scrollMode = defaultMode;
+
+    /**
+     * @brief Direction actuelle du défilement en mode rebond.
+     */
+    int scrollDirection = 1;
+
+    /**
+     * @brief Indique si les timers de la zone sont suspendus.
+     */
+    bool suspended = false;
+
+    /**
+     * @brief Source de temps du défilement et de l'horloge.
+     */
+    const FrameClock *clock;
+
+    /**
+     * @brief Départ du défilement (référence clock, -1 : pas de départ) : la position est calculée à partir du temps écoulé.
+     */
+    qint64 scrollStartMs = -1;
+
+    /**
+     * @brief Nombre de pas de défilement déjà appliqués depuis scrollStartMs.
+     */
+    qint64 scrollSteps = 0;
+
+    /**
+     * @brief Masques des colonnes de la bande (tampon circulaire indexé par colonne absolue).
+     */
+    QVector<quint8> tickerMasks;
+
+    /**
+     * @brief Couleurs des colonnes de la bande, au même indice que tickerMasks.
+     */
+    QVector<QRgb> tickerColors;
+
+    /**
+     * @brief Texte ajouté en cours de conversion (tampons réutilisés d'un ajout à l'autre).
+     */
+    QByteArray appendGlyphs;
+
+    /**
+     * @brief Plages d'encre du texte ajouté en cours de conversion.
+     */
+    QVector<InkRun> appendRuns;
+
+    /**
+     * @brief Première colonne absolue encore conservée dans la bande.
+     */
+    qint64 tickerHead = 0;
+
+    /**
+     * @brief Colonne absolue suivant la dernière colonne ajoutée.
+     */
+    qint64 tickerTail = 0;
+
+    /**
+     * @brief Colonne absolue affichée au bord gauche de la zone.
+     */
+    qint64 tickerPosition = 0;
+
+    /**
+     * @brief Indique qu'une troncature de la bande a déjà été signalée.
+     */
+    bool tickerOverflowReported = false;
+
+    /**
+     * @brief Fichier de l'image source (vide : images fournies par setImage() ou setAnimation()).
+     */
+    QString imagePath;
+
+    /**
+     * @brief Images sources fournies directement, conservées pour reconvertir après un redimensionnement.
+     */
+    QVector<QImage> imageFrames;
+
+    /**
+     * @brief Durées des images de imageFrames, en millisecondes.
+     */
+    QVector<int> imageDelaysMs;
+
+    /**
+     * @brief Seuillage ou tramage appliqué aux images.
+     */
+    LedImage::Conversion imageConversion = LedImage::OrderedDither;
+
+    /**
+     * @brief Images converties en cours d'affichage.
+     */
+    LedImage image;
+
+    /**
+     * @brief Thread de la conversion en cours (nullptr si aucune).
+     */
+    QThread *imageThread = nullptr;
+
+    /**
+     * @brief Résultat écrit par le thread de conversion, lu à sa fin dans le thread de la zone.
+     */
+    LedImage convertedImage;
+
+    /**
+     * @brief Erreur éventuelle de la conversion, lue à sa fin.
+     */
+    QString conversionError;
+
+    /**
+     * @brief Indique que la source ou les dimensions ont changé pendant la conversion en cours.
+     */
+    bool imageConversionStale = false;
+
+    /**
+     * @brief Début de la lecture de l'animation (référence clock, -1 : pas de lecture).
+     */
+    qint64 imageStartMs = -1;
+
+    /**
+     * @brief Image de l'animation affichée.
+     */
+    int imageFrameIndex = 0;
+
+    /**
+     * @brief Flux vidéo du mode Video (nullptr hors de ce mode).
+     */
+    VideoFeed *videoFeed = nullptr;
+
+    /**
+     * @brief Dernière image reprise du flux vidéo.
+     */
+    QByteArray videoCodes;
+
+    /**
+     * @brief Dimensions de videoCodes, en LED.
+     */
+    QSize videoCodesSize;
+
+    /**
+     * @brief Plan d'intensité de la zone (contenu sans effets).
+     */
+    LedFrame zoneFrame;
+
+    /**
+     * @brief Indique que zoneFrame doit être rastérisé à nouveau.
+     */
+    bool dirty = true;
+};
+
+#endif // MATRIXZONE_H
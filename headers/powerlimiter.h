@@ -0,0 +1,176 @@
+#ifndef POWERLIMITER_H
+#define POWERLIMITER_H
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+#include <QString>
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+#include "headers/ledpalette.h"
+
+// Inclusion des headers standard nécessaires
+#include <array>
+
+/**
+ * @file powerlimiter.h
+ * @author G. Maxime
+ * @class PowerLimiter
+ * @brief Dernier étage avant la présentation : estime le courant consommé par chaque
+ * image et réduit la luminosité pour rester sous la limite de l'alimentation.
+ *
+ * Une LED consomme ledCurrent() en blanc à pleine intensité ; son courant est pondéré
+ * par son intensité et par la somme des composantes de sa couleur de palette. Le
+ * comptage parcourt le plan par mots de 8 LED : les mots éteints sont sautés, les LED
+ * allumées d'un mot sont repérées par un masque (un bit par octet non nul) compté par
+ * popcount. Au-delà de la limite, les intensités sont réduites d'un facteur commun
+ * appliqué immédiatement ; la luminosité remonte ensuite progressivement pour éviter
+ * le pompage, sans jamais dépasser la limite.
+ */
+class PowerLimiter
+{
+public:
+    /**
+     * @brief Mesures depuis le dernier reset().
+     */
+    struct Statistics {
+        quint64 frames = 0;                ///< Images mesurées
+        quint64 limitedFrames = 0;         ///< Images dont la luminosité a été réduite
+        int litLeds = 0;                   ///< LED allumées dans la dernière image
+        double requestedMa = 0.0;          ///< Courant demandé par la dernière image, en mA
+        double deliveredMa = 0.0;          ///< Courant après limitation de la dernière image, en mA
+        double brightness = 1.0;           ///< Facteur de luminosité appliqué à la dernière image
+        double peakRequestedMa = 0.0;      ///< Plus forte demande
+        double averageRequestedMa = 0.0;   ///< Demande moyenne par image
+        double peakDeliveredMa = 0.0;      ///< Plus fort courant après limitation
+    };
+
+    /**
+     * @brief Courant d'une LED RGB en blanc à pleine intensité (3 × 20 mA, type WS2812).
+     */
+    static constexpr double DefaultLedCurrentMa = 60.0;
+
+    /**
+     * @brief Durée de remontée de la luminosité de 0 à 100 % après une réduction.
+     */
+    static constexpr int ReleaseMs = 1000;
+
+    /**
+     * @brief Active ou désactive la mesure ; désactivée, apply() renvoie l'image telle quelle.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Indique si la mesure est active.
+     */
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Règle le modèle de consommation.
+     * @param ledCurrentMa Courant d'une LED en blanc à pleine intensité, en mA.
+     * @param limitMa Courant total autorisé, en mA (0 : mesure seule, sans limitation).
+     */
+    void setBudget(double ledCurrentMa, double limitMa);
+
+    /**
+     * @brief Courant d'une LED en blanc à pleine intensité, en mA.
+     */
+    double ledCurrent() const { return ledCurrentMa; }
+
+    /**
+     * @brief Courant total autorisé, en mA (0 : pas de limite).
+     */
+    double limit() const { return limitMa; }
+
+    /**
+     * @brief Mesure une image et la limite si nécessaire.
+     * @param frame Image à présenter.
+     * @param palette Couleurs des indices d'encre.
+     * @param nowMs Horloge courante en millisecondes (remontée de la luminosité).
+     * @return frame elle-même si elle tient dans la limite, sinon une copie atténuée.
+     */
+    const LedFrame &apply(const LedFrame &frame, const LedPalette &palette, qint64 nowMs);
+
+    /**
+     * @brief Indique que la luminosité remonte encore : des images supplémentaires sont nécessaires.
+     */
+    bool isRecovering() const { return enabled && recovering; }
+
+    /**
+     * @brief Somme, sur les LED allumées, de l'intensité multipliée par le poids de l'encre.
+     * @param inkWeights Poids de chaque indice d'encre (somme R + G + B).
+     * @param litLeds Nombre de LED allumées, renseigné si non nul.
+     */
+    static quint64 weightedLevels(const LedFrame &frame, const std::array<quint16, 256> &inkWeights, int *litLeds);
+
+    /**
+     * @brief Relevé des mesures.
+     */
+    Statistics statistics() const;
+
+    /**
+     * @brief Efface les mesures (pas la luminosité courante).
+     */
+    void reset();
+
+    /**
+     * @brief Résumé des mesures sur une ligne, pour les journaux.
+     */
+    static QString summary(const Statistics &statistics);
+
+private:
+    /**
+     * @brief Recalcule le poids de chaque indice d'encre (somme R + G + B) si la palette a changé.
+     */
+    void updateWeights(const LedPalette &palette);
+
+    /**
+     * @brief Vrai si la mesure est active.
+     */
+    bool enabled = false;
+
+    /**
+     * @brief Modèle de consommation.
+     */
+    double ledCurrentMa = DefaultLedCurrentMa;
+    double limitMa = 0.0;
+
+    /**
+     * @brief Somme R + G + B de chaque indice d'encre (0 à 765).
+     */
+    std::array<quint16, 256> inkWeights{};
+
+    /**
+     * @brief Couleurs ayant servi à calculer inkWeights.
+     */
+    std::array<QRgb, 256> weightedColors{};
+    int weightedColorCount = -1;
+
+    /**
+     * @brief Facteur de luminosité courant, de 0 à 256 (256 : pleine luminosité).
+     */
+    int brightness = 256;
+
+    /**
+     * @brief Vrai si la luminosité est sous celle que la dernière image autorisait.
+     */
+    bool recovering = false;
+
+    /**
+     * @brief Instant de la dernière image mesurée (-1 : aucune).
+     */
+    qint64 lastApplyMs = -1;
+
+    /**
+     * @brief Copie atténuée de la dernière image limitée.
+     */
+    LedFrame limitedFrame;
+
+    /**
+     * @brief Mesures.
+     */
+    Statistics stats;
+    double requestedTotalMa = 0.0;
+};
+
+#endif // POWERLIMITER_H
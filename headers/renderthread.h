@@ -0,0 +1,230 @@
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+// Inclusion des headers Qt nécessaires
+#include <QObject>
+#include <QColor>
+#include <QImage>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QRectF>
+#include <QSize>
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+#include "headers/ledpalette.h"
+#include "headers/ledrenderer.h"
+
+// Inclusion des headers standard nécessaires
+#include <atomic>
+
+class QThread;
+class QPainter;
+
+/**
+ * @struct RenderSnapshot
+ * @brief État de la matrice nécessaire au dessin d'une image, copié depuis le thread GUI.
+ */
+struct RenderSnapshot
+{
+    /**
+     * @brief Plan d'intensité à afficher (après effets).
+     */
+    LedFrame frame;
+
+    /**
+     * @brief Palette des encres du plan.
+     */
+    LedPalette palette;
+
+    /**
+     * @brief Couleur de fond.
+     */
+    QColor background;
+
+    /**
+     * @brief Taille du widget, en pixels logiques.
+     */
+    QSize size;
+
+    /**
+     * @brief Rapport pixels physiques / pixels logiques de l'écran.
+     */
+    qreal devicePixelRatio = 1.0;
+
+    /**
+     * @brief Rectangle occupé par la matrice.
+     */
+    QRectF matrixRect;
+
+    /**
+     * @brief Taille d'une cellule de LED.
+     */
+    float cellSize = 0.0f;
+
+    /**
+     * @brief Faux si seul le fond doit être dessiné (aucun contenu).
+     */
+    bool drawMatrix = false;
+
+    /**
+     * @brief Niveau de qualité du dessin des LED.
+     */
+    LedRenderer::Quality quality = LedRenderer::HighQuality;
+
+    /**
+     * @brief Style des LED.
+     */
+    LedRenderer::Style style = LedRenderer::DotStyle;
+
+    /**
+     * @brief Numéro de l'image calculée par le thread GUI (suivi de latence).
+     */
+    quint64 sequence = 0;
+};
+
+/**
+ * @file renderthread.h
+ * @author G. Maxime
+ * @class RenderThread
+ * @brief Thread de rendu dessinant les images de la matrice hors du thread GUI.
+ * Le thread GUI dépose un instantané (submit()) ; le thread de rendu le dessine
+ * dans l'image arrière puis l'échange avec l'image avant (double tampon) et
+ * signale frameReady(). paintEvent() n'a plus qu'à copier l'image avant (drawLatest()).
+ * Seul le dernier instantané compte : un thread GUI ralenti ne crée pas de retard.
+ * Le thread dort tant qu'aucun instantané n'est déposé.
+ */
+class RenderThread : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructeur : démarre le thread de rendu.
+     */
+    explicit RenderThread(QObject *parent = nullptr);
+
+    /**
+     * @brief Destructeur : arrête le thread de rendu et attend sa fin.
+     */
+    ~RenderThread() override;
+
+    /**
+     * @brief Dépose un instantané à dessiner (remplace l'instantané non encore dessiné).
+     */
+    void submit(const RenderSnapshot &snapshot);
+
+    /**
+     * @brief Copie la dernière image terminée à l'origine du peintre.
+     * @return Faux si aucune image n'est encore disponible.
+     */
+    bool drawLatest(QPainter &painter);
+
+    /**
+     * @brief Copie une partie de la dernière image terminée, mise à l'échelle (redimensionnement en cours).
+     * @param target Rectangle de destination, en pixels logiques du widget.
+     * @param source Rectangle source, en pixels logiques de l'image.
+     * @return Faux si aucune image n'est encore terminée.
+     */
+    bool drawLatest(QPainter &painter, const QRectF &target, const QRectF &source);
+
+    /**
+     * @brief Taille logique de la dernière image terminée (vide si aucune).
+     */
+    QSize latestSize();
+
+    /**
+     * @brief Durée du dessin de la dernière image terminée, en nanosecondes (0 si seul le fond a été dessiné).
+     */
+    qint64 lastRenderTime() const;
+
+    /**
+     * @brief Numéro (RenderSnapshot::sequence) de l'image avant, 0 tant qu'aucune image n'est terminée.
+     */
+    quint64 latestSequence();
+
+signals:
+    /**
+     * @brief Émis dans le thread GUI lorsqu'une nouvelle image est terminée.
+     */
+    void frameReady();
+
+private slots:
+    /**
+     * @brief Relaie dans le thread GUI la fin d'une image (au plus un relais en attente).
+     */
+    void deliverFrame();
+
+private:
+    /**
+     * @brief Boucle du thread de rendu.
+     */
+    void run();
+
+    /**
+     * @brief Dessine un instantané dans une image.
+     */
+    void renderSnapshot(const RenderSnapshot &snapshot, QImage *image);
+
+    /**
+     * @brief Thread de rendu.
+     */
+    QThread *thread = nullptr;
+
+    /**
+     * @brief Protège l'instantané en attente et l'échange des images.
+     */
+    QMutex mutex;
+
+    /**
+     * @brief Réveille le thread de rendu (instantané déposé ou arrêt).
+     */
+    QWaitCondition wakeCondition;
+
+    /**
+     * @brief Instantané en attente de dessin.
+     */
+    RenderSnapshot pending;
+
+    /**
+     * @brief Indique qu'un instantané attend d'être dessiné.
+     */
+    bool hasPending = false;
+
+    /**
+     * @brief Demande d'arrêt du thread de rendu.
+     */
+    bool stopping = false;
+
+    /**
+     * @brief Images avant et arrière.
+     */
+    QImage images[2];
+
+    /**
+     * @brief Indice de l'image avant (-1 tant qu'aucune image n'est terminée).
+     */
+    int frontIndex = -1;
+
+    /**
+     * @brief Numéro de l'instantané dessiné dans l'image avant.
+     */
+    quint64 frontSequence = 0;
+
+    /**
+     * @brief Vrai si un relais deliverFrame() est déjà programmé.
+     */
+    std::atomic<bool> readyPending{false};
+
+    /**
+     * @brief Durée du dessin de la dernière image, en nanosecondes.
+     */
+    std::atomic<qint64> lastRenderNs{0};
+
+    /**
+     * @brief Dessin des LED, propre au thread de rendu.
+     */
+    LedRenderer renderer;
+};
+
+#endif // RENDERTHREAD_H
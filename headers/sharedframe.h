@@ -0,0 +1,171 @@
+#ifndef SHAREDFRAME_H
+#define SHAREDFRAME_H
+
+// Inclusion des headers Qt nécessaires
+#include <QObject>
+#include <QString>
+#include <QSharedMemory>
+#include <QRgb>
+#include <QVector>
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+#include "headers/ledpalette.h"
+
+/**
+ * @file sharedframe.h
+ * @author G. Maxime
+ * @brief Publication du plan des LED dans un segment de mémoire partagée nommé.
+ *
+ * Le segment contient un en-tête, la palette, les intensités et le plan d'encre de
+ * la dernière image présentée. Il est protégé par un compteur de génération
+ * (seqlock) : l'écrivain le rend impair pendant l'écriture puis pair à la fin ;
+ * un lecteur copie l'image et recommence si le compteur a changé entre-temps.
+ * Aucun verrou n'est pris : un lecteur lent ou arrêté ne bloque jamais l'affichage.
+ */
+
+/**
+ * @struct SharedFrameInfo
+ * @brief Métadonnées de la dernière image lue.
+ */
+struct SharedFrameInfo
+{
+    quint64 frameNumber = 0;  ///< Numéro de l'image publiée (1 pour la première)
+    qint64 publishNs = 0;     ///< Instant de publication (SharedFrameReader::clockNs())
+    quint64 hash = 0;         ///< Empreinte LedFrame::hash() calculée par l'écrivain
+};
+
+/**
+ * @class SharedFramePublisher
+ * @brief Écrivain du segment : un seul par clé, dans le thread GUI de la matrice.
+ */
+class SharedFramePublisher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Nombre maximal de LED publiées par défaut (256 × 256).
+     */
+    static constexpr int DefaultMaxLeds = 256 * 256;
+
+    /**
+     * @brief Constructeur d'un écrivain sans segment.
+     * @param parent Objet parent (par défaut nullptr).
+     */
+    explicit SharedFramePublisher(QObject *parent = nullptr);
+
+    /**
+     * @brief Destructeur : détache le segment (il disparaît avec son dernier lecteur).
+     */
+    ~SharedFramePublisher() override;
+
+    /**
+     * @brief Crée le segment nommé. Un segment orphelin laissé par un processus arrêté est repris.
+     * @param key Nom du segment, partagé avec les lecteurs.
+     * @param maxLeds Nombre maximal de LED publiées ; une image plus grande est ignorée.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si le segment est prêt.
+     */
+    bool open(const QString &key, int maxLeds, QString *errorMessage);
+
+    /**
+     * @brief Nom du segment (vide s'il n'est pas ouvert).
+     */
+    QString key() const;
+
+    /**
+     * @brief Publie une image : copie du plan et de la palette, sans allocation ni verrou.
+     */
+    void publish(const LedFrame &frame, const LedPalette &palette);
+
+    /**
+     * @brief Nombre d'images publiées.
+     */
+    quint64 publishedFrames() const;
+
+private:
+    /**
+     * @brief Segment de mémoire partagée.
+     */
+    QSharedMemory memory;
+
+    /**
+     * @brief Nombre maximal de LED que le segment peut contenir.
+     */
+    int capacityLeds = 0;
+
+    /**
+     * @brief Nombre d'images publiées.
+     */
+    quint64 frameCount = 0;
+
+    /**
+     * @brief Indique qu'une image trop grande a déjà été signalée.
+     */
+    bool oversizeReported = false;
+};
+
+/**
+ * @class SharedFrameReader
+ * @brief Lecteur du segment, utilisable depuis n'importe quel processus.
+ */
+class SharedFrameReader
+{
+public:
+    /**
+     * @brief Nombre de tentatives d'une lecture avant d'abandonner (écrivain très actif).
+     */
+    static constexpr int MaxAttempts = 64;
+
+    /**
+     * @brief Horloge monotone commune aux processus de la machine, en nanosecondes.
+     */
+    static qint64 clockNs();
+
+    /**
+     * @brief S'attache au segment en lecture seule.
+     * @param key Nom du segment.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si le segment existe et a le format attendu.
+     */
+    bool attach(const QString &key, QString *errorMessage);
+
+    /**
+     * @brief Indique si une image plus récente que la dernière lue est publiée (sans copie).
+     */
+    bool hasNewFrame() const;
+
+    /**
+     * @brief Copie la dernière image publiée si elle est nouvelle.
+     * Le plan n'est réalloué que lorsque ses dimensions changent.
+     * @param frame Plan des LED.
+     * @param palette Couleurs des indices de palette.
+     * @param info Métadonnées de l'image.
+     * @return Faux si aucune nouvelle image n'a pu être lue de façon cohérente.
+     */
+    bool read(LedFrame *frame, QVector<QRgb> *palette, SharedFrameInfo *info);
+
+    /**
+     * @brief Nombre de lectures recommencées parce que l'écrivain publiait en même temps.
+     */
+    quint64 retries() const { return retryCount; }
+
+private:
+    /**
+     * @brief Segment de mémoire partagée.
+     */
+    QSharedMemory memory;
+
+    /**
+     * @brief Génération de la dernière image lue.
+     */
+    quint64 lastGeneration = 0;
+
+    /**
+     * @brief Lectures recommencées.
+     */
+    quint64 retryCount = 0;
+};
+
+#endif // SHAREDFRAME_H
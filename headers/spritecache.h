@@ -0,0 +1,194 @@
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+// Inclusion des headers Qt nécessaires
+#include <QImage>
+#include <QSize>
+#include <QPoint>
+#include <QRgb>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+
+// Inclusion des headers standard nécessaires
+#include <functional>
+#include <list>
+
+/**
+ * @struct SpriteKey
+ * @brief Identifie une image dérivée du rendu : type, police, taille de cellule, échelle et couleur.
+ * Deux matrices de même taille, même échelle et mêmes couleurs produisent des clés
+ * égales et partagent donc la même image.
+ */
+struct SpriteKey
+{
+    /**
+     * @brief Types d'images mises en cache.
+     */
+    enum Kind {
+        LedHalo, ///< Halo d'une LED (style glow)
+        LedGrid  ///< Couche des LED éteintes d'une grille complète
+    };
+
+    /**
+     * @brief Type de l'image.
+     */
+    Kind kind = LedHalo;
+
+    /**
+     * @brief Police de la matrice (0 : police matricielle intégrée).
+     */
+    int font = 0;
+
+    /**
+     * @brief Taille de cellule, en 1/64 de pixel physique.
+     */
+    int cellSize64 = 0;
+
+    /**
+     * @brief Rapport pixels physiques / pixels logiques, en millièmes.
+     */
+    int devicePixelRatio1000 = 1000;
+
+    /**
+     * @brief Couleur de l'image.
+     */
+    QRgb color = 0;
+
+    /**
+     * @brief Variante propre au type (niveau d'intensité, antialiasing...).
+     */
+    int variant = 0;
+
+    /**
+     * @brief Dimensions de la grille en LED (couches de grille).
+     */
+    QSize grid;
+
+    /**
+     * @brief Décalage sous-pixel de l'origine, en 1/64 de pixel physique (couches de grille).
+     */
+    QPoint phase64;
+
+    bool operator==(const SpriteKey &other) const
+    {
+        return kind == other.kind && font == other.font && cellSize64 == other.cellSize64
+               && devicePixelRatio1000 == other.devicePixelRatio1000 && color == other.color
+               && variant == other.variant && grid == other.grid && phase64 == other.phase64;
+    }
+
+    bool operator!=(const SpriteKey &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Empreinte d'une clé de sprite pour QHash.
+ */
+size_t qHash(const SpriteKey &key, size_t seed = 0);
+
+/**
+ * @file spritecache.h
+ * @author G. Maxime
+ * @class SpriteCache
+ * @brief Cache d'images dérivées partagé par tout le processus.
+ * Les images (halos de LED, couches de grille) sont calculées une seule fois pour
+ * toutes les matrices du processus et tous les threads de rendu. Elles sont rendues
+ * par pointeur partagé : une image en cours d'utilisation reste valide même après
+ * son éviction du cache, qui ne libère que sa propre référence.
+ *
+ * Le cache est borné en octets : au-delà du plafond, les images les moins
+ * récemment demandées sont évincées (LRU). Les consommateurs conservent leurs
+ * pointeurs d'une image à l'autre ; le cache n'est consulté que lorsqu'une taille,
+ * une échelle ou une couleur change.
+ */
+class SpriteCache
+{
+public:
+    /**
+     * @brief Statistiques mémoire et d'utilisation du cache.
+     */
+    struct Statistics {
+        int entries = 0;         ///< Images présentes dans le cache
+        qint64 bytes = 0;        ///< Octets des images présentes
+        qint64 peakBytes = 0;    ///< Maximum atteint par bytes
+        qint64 byteCap = 0;      ///< Plafond en octets
+        quint64 hits = 0;        ///< Demandes servies depuis le cache
+        quint64 misses = 0;      ///< Demandes ayant calculé l'image
+        quint64 evictions = 0;   ///< Images évincées pour respecter le plafond
+    };
+
+    /**
+     * @brief Cache partagé du processus.
+     */
+    static SpriteCache &instance();
+
+    /**
+     * @brief Image associée à une clé, calculée par build() si elle n'est pas en cache.
+     * Appelable depuis n'importe quel thread ; build() est appelé hors verrou.
+     */
+    QSharedPointer<const QImage> obtain(const SpriteKey &key, const std::function<QImage()> &build);
+
+    /**
+     * @brief Change le plafond du cache en octets (évince immédiatement si nécessaire).
+     */
+    void setByteCap(qint64 bytes);
+
+    /**
+     * @brief Plafond du cache en octets.
+     */
+    qint64 byteCap() const;
+
+    /**
+     * @brief Relevé des statistiques du cache.
+     */
+    Statistics statistics() const;
+
+    /**
+     * @brief Vide le cache (les images encore utilisées restent valides).
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Constructeur privé : le cache n'existe qu'en un exemplaire (instance()).
+     */
+    SpriteCache();
+
+    /**
+     * @brief Évince les images les moins récentes jusqu'à respecter le plafond (verrou tenu).
+     */
+    void evictToCap();
+
+    /**
+     * @brief Image en cache et sa position dans l'ordre LRU.
+     */
+    struct Entry {
+        QSharedPointer<const QImage> image;
+        qint64 bytes = 0;
+        std::list<SpriteKey>::iterator lruPosition;
+    };
+
+    /**
+     * @brief Protège toutes les données du cache.
+     */
+    mutable QMutex mutex;
+
+    /**
+     * @brief Images par clé.
+     */
+    QHash<SpriteKey, Entry> entries;
+
+    /**
+     * @brief Clés de la plus récemment demandée à la plus ancienne.
+     */
+    std::list<SpriteKey> lru;
+
+    /**
+     * @brief Statistiques courantes (octets, compteurs, plafond).
+     */
+    Statistics stats;
+};
+
+#endif // SPRITECACHE_H
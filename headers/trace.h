@@ -0,0 +1,116 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+#include <QString>
+
+#ifdef MATRIX_TRACING
+// Inclusion des headers standard nécessaires
+#include <atomic>
+#endif
+
+/**
+ * @file trace.h
+ * @author G. Maxime
+ * @brief Traces chronologiques des phases de la matrice (timers, mise en page, dessin).
+ * Compilées seulement avec l'option CMake MATRIX_TRACING : MATRIX_TRACE_SCOPE(nom)
+ * mesure alors la portée qui le contient. Chaque thread écrit ses événements sans verrou
+ * dans son propre tampon circulaire ; writeChromeTrace() les exporte au format JSON
+ * Chrome trace, lisible par Perfetto (ui.perfetto.dev) ou chrome://tracing.
+ *
+ * Sans l'option, MATRIX_TRACE_SCOPE ne produit aucun code. Avec l'option mais traces
+ * arrêtées, une portée ne coûte qu'une lecture atomique et un branchement.
+ */
+namespace Trace {
+
+/**
+ * @brief Indique si les traces sont compilées dans l'application.
+ */
+bool isAvailable();
+
+/**
+ * @brief Vide les tampons et démarre l'enregistrement (après l'arrêt des écritures en cours).
+ */
+void start();
+
+/**
+ * @brief Arrête l'enregistrement (les événements déjà enregistrés sont conservés).
+ * Attend la fin des événements en cours d'écriture : au retour, aucun thread ne modifie plus les tampons.
+ */
+void stop();
+
+/**
+ * @brief Arrête l'enregistrement et écrit les événements au format JSON Chrome trace.
+ * @param path Fichier de sortie.
+ * @param errorMessage Message d'erreur renseigné en cas d'échec.
+ * @return Vrai si le fichier a été écrit.
+ */
+bool writeChromeTrace(const QString &path, QString *errorMessage);
+
+#ifdef MATRIX_TRACING
+
+/**
+ * @brief Vrai pendant l'enregistrement.
+ */
+extern std::atomic<bool> enabled;
+
+/**
+ * @brief Indique si l'enregistrement est en cours (une lecture atomique relâchée).
+ */
+inline bool isEnabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Temps monotone en nanosecondes.
+ */
+qint64 nowNs();
+
+/**
+ * @brief Enregistre un événement terminé dans le tampon du thread appelant.
+ * @param name Nom de la phase (chaîne littérale : seul le pointeur est conservé).
+ */
+void record(const char *name, qint64 startNs, qint64 endNs);
+
+/**
+ * @class Scope
+ * @brief Mesure la durée de vie d'une portée (utilisé par MATRIX_TRACE_SCOPE).
+ */
+class Scope
+{
+public:
+    explicit Scope(const char *name)
+        : name(name),
+          startNs(isEnabled() ? nowNs() : -1)
+    {
+    }
+
+    ~Scope()
+    {
+        if (startNs >= 0)
+            record(name, startNs, nowNs());
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    const char *name;
+    qint64 startNs;
+};
+
+#endif // MATRIX_TRACING
+
+} // namespace Trace
+
+#ifdef MATRIX_TRACING
+#define MATRIX_TRACE_CONCAT_IMPL(a, b) a##b
+#define MATRIX_TRACE_CONCAT(a, b) MATRIX_TRACE_CONCAT_IMPL(a, b)
+#define MATRIX_TRACE_SCOPE(name) const Trace::Scope MATRIX_TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define MATRIX_TRACE_SCOPE(name) do {} while (false)
+#endif
+
+#endif // TRACE_H
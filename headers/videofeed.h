@@ -0,0 +1,329 @@
+#ifndef VIDEOFEED_H
+#define VIDEOFEED_H
+
+// Inclusion des headers Qt nécessaires
+#include <QObject>
+#include <QString>
+#include <QSize>
+#include <QRect>
+#include <QByteArray>
+#include <QMutex>
+#include <QWaitCondition>
+
+// Inclusion de mes headers
+#include "headers/ledimage.h"
+
+// Inclusion des headers standard nécessaires
+#include <atomic>
+#include <vector>
+
+class QThread;
+
+/**
+ * @file videofeed.h
+ * @author G. Maxime
+ * @class VideoFeed
+ * @brief Flux vidéo brut lu sur un descripteur (entrée standard, FIFO) et réduit aux LED d'une zone.
+ * Les images sont des RGB 24 bits de taille fixe, sans en-tête, par exemple la sortie
+ * de « ffmpeg -f rawvideo -pix_fmt rgb24 ». Un thread de lecture remplit des tampons
+ * préalloués et les place dans une file bornée ; quand la conversion prend du retard,
+ * l'image la plus ancienne de la file est abandonnée. Un thread de travail réduit
+ * chaque image par moyenne de blocs et la convertit en codes de LED (LedImage).
+ *
+ * Le thread GUI ne reçoit que la dernière image convertie : une image non affichée
+ * est remplacée par la suivante, et le signal frameAvailable() n'est pas répété tant
+ * que takeFrame() n'a pas été appelé. Aucun des trois threads n'alloue en régime établi.
+ *
+ * Disponible sur les systèmes Unix uniquement.
+ */
+class VideoFeed : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Compteurs du flux depuis son ouverture.
+     */
+    struct Statistics {
+        quint64 framesRead = 0;        ///< Images lues sur le descripteur
+        quint64 framesConverted = 0;   ///< Images réduites par le thread de travail
+        quint64 framesDisplayed = 0;   ///< Images reprises par le thread GUI
+        quint64 queueDrops = 0;        ///< Images lues abandonnées, conversion en retard
+        quint64 staleDrops = 0;        ///< Images converties remplacées avant d'être affichées
+        double averageConvertMs = 0.0; ///< Durée moyenne de réduction d'une image
+        qint64 elapsedMs = 0;          ///< Temps écoulé depuis le démarrage
+    };
+
+    /**
+     * @brief Constructeur d'un flux arrêté.
+     * @param frameSize Dimensions des images sources, en pixels.
+     * @param parent Objet parent (par défaut nullptr).
+     */
+    explicit VideoFeed(const QSize &frameSize, QObject *parent = nullptr);
+
+    /**
+     * @brief Destructeur : arrête les threads de lecture et de conversion.
+     */
+    ~VideoFeed() override;
+
+    /**
+     * @brief Démarre la lecture.
+     * @param path Fichier ou FIFO à lire, ou « - » pour l'entrée standard. Une FIFO est
+     *        ouverte par le thread de lecture : l'attente d'un écrivain ne bloque pas l'appelant.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si les threads ont démarré.
+     */
+    bool start(const QString &path, QString *errorMessage);
+
+    /**
+     * @brief Dimensions des images sources, en pixels.
+     */
+    QSize frameSize() const;
+
+    /**
+     * @brief Change les dimensions de sortie, en LED (appliqué à l'image suivante).
+     */
+    void setTargetSize(const QSize &size);
+
+    /**
+     * @brief Change le seuillage ou le tramage (appliqué à l'image suivante).
+     */
+    void setConversion(LedImage::Conversion conversion);
+
+    /**
+     * @brief Reprend la dernière image convertie (thread GUI).
+     * Les tampons sont échangés, pas copiés : codes reçoit l'image et rend son ancien tampon.
+     * @param codes Codes des LED (LedImage), ligne par ligne.
+     * @param size Dimensions de l'image, en LED.
+     * @return Faux si aucune nouvelle image n'est disponible.
+     */
+    bool takeFrame(QByteArray *codes, QSize *size);
+
+    /**
+     * @brief Relevé des compteurs du flux.
+     */
+    Statistics statistics() const;
+
+    /**
+     * @brief Compteurs du flux sur une ligne (journal).
+     */
+    QString statisticsSummary() const;
+
+    /**
+     * @brief Compteurs donnés sur une ligne, pour les journaux.
+     */
+    static QString summary(const Statistics &statistics);
+
+signals:
+    /**
+     * @brief Émis depuis le thread de travail quand une image convertie attend takeFrame().
+     */
+    void frameAvailable();
+
+    /**
+     * @brief Émis à la fin du flux (fin de fichier, erreur de lecture).
+     * @param errorMessage Vide pour une fin de fichier normale.
+     */
+    void finished(const QString &errorMessage);
+
+private:
+    /**
+     * @brief Boucle du thread de lecture.
+     */
+    void readLoop(const QString &path);
+
+    /**
+     * @brief Boucle du thread de conversion.
+     */
+    void convertLoop();
+
+    /**
+     * @brief Lit exactement une image ; attend les données par tranches pour rester interruptible.
+     * @return Faux en fin de flux, en cas d'erreur ou d'arrêt.
+     */
+    bool readFrame(int fd, quint8 *buffer, QString *errorMessage);
+
+    /**
+     * @brief Réduit une image brute aux dimensions de sortie et la convertit en codes de LED.
+     */
+    void convertFrame(const quint8 *rgb, const QSize &size, LedImage::Conversion conversion, QByteArray *codes);
+
+    /**
+     * @brief Recalcule les blocs de pixels de chaque LED pour des dimensions de sortie.
+     */
+    void updateSpans(const QSize &size);
+
+    /**
+     * @brief Nombre d'images que la file peut contenir.
+     */
+    static constexpr int kQueueCapacity = 2;
+
+    /**
+     * @brief Tampons bruts : la file, plus l'image en lecture et l'image en conversion.
+     */
+    static constexpr int kRawBuffers = kQueueCapacity + 2;
+
+    /**
+     * @brief Dimensions des images sources.
+     */
+    const QSize sourceSize;
+
+    /**
+     * @brief Taille d'une image brute, en octets.
+     */
+    const int frameBytes;
+
+    /**
+     * @brief Fichier lu (« - » : entrée standard).
+     */
+    QString sourcePath;
+
+    /**
+     * @brief Vrai une fois le fichier ouvert par le thread de lecture.
+     */
+    std::atomic<bool> opened{false};
+
+    /**
+     * @brief Thread de lecture.
+     */
+    QThread *readerThread = nullptr;
+
+    /**
+     * @brief Thread de conversion.
+     */
+    QThread *converterThread = nullptr;
+
+    /**
+     * @brief Demande d'arrêt des deux threads.
+     */
+    std::atomic<bool> stopping{false};
+
+    /**
+     * @brief Protège la file, les tampons libres et les paramètres de sortie.
+     */
+    QMutex queueMutex;
+
+    /**
+     * @brief Réveille le thread de conversion (image en file, fin de lecture ou arrêt).
+     */
+    QWaitCondition queueChanged;
+
+    /**
+     * @brief Tampons bruts préalloués.
+     */
+    std::vector<std::vector<quint8>> rawFrames;
+
+    /**
+     * @brief Indices des tampons libres.
+     */
+    std::vector<int> freeFrames;
+
+    /**
+     * @brief File circulaire des indices des images lues, de la plus ancienne à la plus récente.
+     */
+    int queue[kQueueCapacity] = {};
+
+    /**
+     * @brief Position de l'image la plus ancienne dans queue.
+     */
+    int queueHead = 0;
+
+    /**
+     * @brief Nombre d'images dans la file.
+     */
+    int queueCount = 0;
+
+    /**
+     * @brief Vrai quand le thread de lecture a terminé.
+     */
+    bool readerDone = false;
+
+    /**
+     * @brief Erreur de lecture éventuelle, transmise par finished().
+     */
+    QString readerError;
+
+    /**
+     * @brief Dimensions de sortie demandées, en LED.
+     */
+    QSize targetSize;
+
+    /**
+     * @brief Conversion demandée.
+     */
+    LedImage::Conversion targetConversion = LedImage::OrderedDither;
+
+    /**
+     * @brief Dimensions pour lesquelles les blocs ont été calculés (thread de conversion).
+     */
+    QSize spanSize;
+
+    /**
+     * @brief Rectangle de LED occupé par l'image (thread de conversion).
+     */
+    QRect spanRect;
+
+    /**
+     * @brief Bloc de colonnes sources de chaque colonne de LED : [colStarts, colEnds).
+     */
+    std::vector<int> colStarts;
+    std::vector<int> colEnds;
+
+    /**
+     * @brief Bloc de lignes sources de chaque ligne de LED : [rowStarts, rowEnds).
+     */
+    std::vector<int> rowStarts;
+    std::vector<int> rowEnds;
+
+    /**
+     * @brief Sommes des composantes d'une bande de lignes sources (thread de conversion).
+     */
+    std::vector<quint32> rowSums;
+
+    /**
+     * @brief Image en cours de conversion (thread de conversion).
+     */
+    QByteArray workCodes;
+
+    /**
+     * @brief Protège la dernière image convertie.
+     */
+    QMutex latestMutex;
+
+    /**
+     * @brief Dernière image convertie.
+     */
+    QByteArray latestCodes;
+
+    /**
+     * @brief Dimensions de la dernière image convertie.
+     */
+    QSize latestSize;
+
+    /**
+     * @brief Vrai si latestCodes n'a pas encore été repris.
+     */
+    bool latestPending = false;
+
+    /**
+     * @brief Vrai entre l'émission de frameAvailable() et l'appel de takeFrame().
+     */
+    std::atomic<bool> notifyPending{false};
+
+    /**
+     * @brief Compteurs du flux.
+     */
+    std::atomic<quint64> framesRead{0};
+    std::atomic<quint64> framesConverted{0};
+    std::atomic<quint64> framesDisplayed{0};
+    std::atomic<quint64> queueDrops{0};
+    std::atomic<quint64> staleDrops{0};
+    std::atomic<qint64> convertNsTotal{0};
+
+    /**
+     * @brief Instant du démarrage (horloge monotone, ms), -1 avant start().
+     */
+    std::atomic<qint64> startedMs{-1};
+};
+
+#endif // VIDEOFEED_H
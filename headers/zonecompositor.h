@@ -0,0 +1,215 @@
+#ifndef ZONECOMPOSITOR_H
+#define ZONECOMPOSITOR_H
+
+// Inclusion des headers Qt nécessaires
+#include <QObject>
+#include <QRect>
+#include <QVector>
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+#include "headers/matrixzone.h"
+#include "headers/ledpalette.h"
+#include "headers/frameclock.h"
+
+/**
+ * @file zonecompositor.h
+ * @author G. Maxime
+ * @class ZoneCompositor
+ * @brief Assemble les zones de la matrice dans un plan d'intensité unique.
+ * Les zones sont empilées dans leur ordre d'ajout : une zone ajoutée plus tard
+ * recouvre les précédentes là où elles se chevauchent. Seules les zones dont le
+ * contenu a changé sont recopiées dans le plan composé ; les autres ne coûtent
+ * rien. La zone 0 (zone principale) existe toujours et couvre par défaut toute la matrice.
+ *
+ * Le plan composé porte, pour chaque LED, un indice dans la palette partagée
+ * par toutes les zones.
+ */
+class ZoneCompositor : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructeur du compositeur.
+     * @param cols Nombre de colonnes de la matrice.
+     * @param rows Nombre de lignes de la matrice.
+     * @param parent Objet parent (par défaut nullptr).
+     */
+    ZoneCompositor(int cols, int rows, QObject *parent = nullptr);
+
+    /**
+     * @brief Nombre de colonnes de la matrice.
+     */
+    int cols() const;
+
+    /**
+     * @brief Nombre de lignes de la matrice.
+     */
+    int rows() const;
+
+    /**
+     * @brief Redimensionne la matrice.
+     * La zone principale suit la nouvelle taille si elle couvrait toute la matrice.
+     */
+    void setMatrixSize(int cols, int rows);
+
+    /**
+     * @brief Ajoute une zone au-dessus des zones existantes.
+     * @param area Position et taille de la zone, en LED.
+     * @return Indice de la nouvelle zone.
+     */
+    int addZone(const QRect &area);
+
+    /**
+     * @brief Supprime une zone (la zone principale ne peut pas être supprimée).
+     * Les indices des zones suivantes sont décalés.
+     */
+    void removeZone(int index);
+
+    /**
+     * @brief Nombre de zones, zone principale comprise.
+     */
+    int zoneCount() const;
+
+    /**
+     * @brief Zone d'indice donné (nullptr si l'indice est invalide).
+     */
+    MatrixZone *zone(int index) const;
+
+    /**
+     * @brief Zone principale, qui reçoit les réglages globaux de la matrice.
+     */
+    MatrixZone *primaryZone() const;
+
+    /**
+     * @brief Indique si au moins une zone a quelque chose à afficher.
+     */
+    bool hasContent() const;
+
+    /**
+     * @brief Palette des encres du plan composé.
+     */
+    const LedPalette &palette() const;
+
+    /**
+     * @brief Change la profondeur des indices de palette (4 ou 8 bits) et rastérise à nouveau toutes les zones.
+     */
+    void setPaletteDepth(int bits);
+
+    /**
+     * @brief Plan composé, mis à jour uniquement sur les zones modifiées.
+     */
+    const LedFrame &frame();
+
+    /**
+     * @brief Suspend les timers de toutes les zones.
+     */
+    void suspend();
+
+    /**
+     * @brief Reprend les timers de toutes les zones.
+     */
+    void resume();
+
+    /**
+     * @brief Change la source de temps de toutes les zones.
+     */
+    void setClock(const FrameClock *clock);
+
+    /**
+     * @brief Met toutes les zones à jour pour l'instant courant de l'horloge.
+     */
+    void tick();
+
+signals:
+    /**
+     * @brief Émis lorsque l'image composée change.
+     * @param contentChanged Vrai pour un changement de contenu pouvant déclencher une transition.
+     */
+    void changed(bool contentChanged);
+
+    /**
+     * @brief Émis à chaque réveil d'un timer de zone.
+     */
+    void timerWokeUp();
+
+    /**
+     * @brief Émis à la fin du flux vidéo d'une zone (voir MatrixZone::videoFinished()).
+     */
+    void videoFinished(const QString &errorMessage, const VideoFeed::Statistics &statistics);
+
+private slots:
+    /**
+     * @brief Réagit au déplacement ou au redimensionnement d'une zone.
+     */
+    void onZoneAreaChanged();
+
+private:
+    /**
+     * @brief Crée une zone et la relie au compositeur.
+     */
+    MatrixZone *createZone(const QRect &area);
+
+    /**
+     * @brief Recompose les zones modifiées (tout le plan après un changement de disposition).
+     */
+    void compose();
+
+    /**
+     * @brief Recompose un rectangle du plan à partir des zones qui le recouvrent.
+     */
+    void compositeArea(const QRect &area);
+
+    /**
+     * @brief Nombre de colonnes de la matrice.
+     */
+    int matrixCols;
+
+    /**
+     * @brief Nombre de lignes de la matrice.
+     */
+    int matrixRows;
+
+    /**
+     * @brief Zones, de la plus basse à la plus haute.
+     */
+    QVector<MatrixZone *> zones;
+
+    /**
+     * @brief Plan composé.
+     */
+    LedFrame composite;
+
+    /**
+     * @brief Palette partagée par les zones.
+     */
+    LedPalette ledPalette;
+
+    /**
+     * @brief Indique qu'une zone a été ajoutée, supprimée, déplacée ou redimensionnée.
+     */
+    bool layoutDirty = true;
+
+    /**
+     * @brief Rectangles à recomposer (réutilisés d'une image à l'autre).
+     */
+    QVector<QRect> dirtyAreas;
+
+    /**
+     * @brief Indique si les zones sont en veille (les nouvelles zones le sont aussi).
+     */
+    bool suspended = false;
+
+    /**
+     * @brief Indique que la saturation de la palette a déjà été signalée.
+     */
+    bool saturationReported = false;
+
+    /**
+     * @brief Source de temps des zones.
+     */
+    const FrameClock *clock = FrameClock::systemClock();
+};
+
+#endif // ZONECOMPOSITOR_H
@@ -0,0 +1,104 @@
+/**
+ * @file adaptivequality.cpp
+ * @author G. Maxime
+ * @brief Implémentation du contrôle adaptatif de la qualité de dessin.
+ */
+
+// Inclusion de mes headers
+#include "headers/adaptivequality.h"
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+
+/**
+ * @brief Poids d'une nouvelle image dans la moyenne lissée.
+ */
+static constexpr double kSmoothing = 0.2;
+
+/**
+ * @brief Images au-dessus du budget avant de baisser la qualité.
+ */
+static constexpr int kFramesBeforeDown = 8;
+
+/**
+ * @brief Images avec de la marge avant de remonter la qualité (avant doublements).
+ */
+static constexpr int kFramesBeforeUp = 90;
+
+/**
+ * @brief Fraction du budget sous laquelle une remontée est envisagée.
+ */
+static constexpr double kHeadroomRatio = 0.6;
+
+/**
+ * @brief Nombre maximal de doublements du délai de remontée.
+ */
+static constexpr int kMaxBackoff = 5;
+
+void AdaptiveQuality::setBudget(double budgetMs)
+{
+    this->budgetMs = std::max(0.0, budgetMs);
+    backoff = 0;
+    lastChangeWasUp = false;
+    changeLevel(LedRenderer::HighQuality);
+}
+
+double AdaptiveQuality::budget() const
+{
+    return budgetMs;
+}
+
+LedRenderer::Quality AdaptiveQuality::quality() const
+{
+    return static_cast<LedRenderer::Quality>(level);
+}
+
+double AdaptiveQuality::averageFrameTime() const
+{
+    return std::max(0.0, averageMs);
+}
+
+bool AdaptiveQuality::addSample(qint64 frameNs)
+{
+    const double frameMs = frameNs / 1e6;
+    averageMs = averageMs < 0.0 ? frameMs : averageMs + kSmoothing * (frameMs - averageMs);
+    if (budgetMs <= 0.0)
+        return false;
+
+    ++framesAtLevel;
+    // Une remontée tenue longtemps efface les rechutes passées
+    if (lastChangeWasUp && framesAtLevel >= 2 * (kFramesBeforeUp << backoff))
+        backoff = 0;
+
+    if (averageMs > budgetMs) {
+        underFrames = 0;
+        if (++overFrames >= kFramesBeforeDown && level < LedRenderer::LitLedsOnly) {
+            // Rechute juste après une remontée : la prochaine remontée attendra deux fois plus
+            if (lastChangeWasUp && framesAtLevel < 2 * (kFramesBeforeUp << backoff))
+                backoff = std::min(backoff + 1, kMaxBackoff);
+            lastChangeWasUp = false;
+            changeLevel(level + 1);
+            return true;
+        }
+    } else if (averageMs < budgetMs * kHeadroomRatio) {
+        overFrames = 0;
+        if (++underFrames >= (kFramesBeforeUp << backoff) && level > LedRenderer::HighQuality) {
+            lastChangeWasUp = true;
+            changeLevel(level - 1);
+            return true;
+        }
+    } else {
+        overFrames = 0;
+        underFrames = 0;
+    }
+    return false;
+}
+
+void AdaptiveQuality::changeLevel(int level)
+{
+    this->level = level;
+    averageMs = -1.0;
+    overFrames = 0;
+    underFrames = 0;
+    framesAtLevel = 0;
+}
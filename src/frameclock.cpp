@@ -0,0 +1,72 @@
+/**
+ * @file frameclock.cpp
+ * @author G. Maxime
+ * @brief Implémentation des sources de temps de la matrice.
+ */
+
+// Inclusion de mes headers
+#include "headers/frameclock.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QElapsedTimer>
+
+namespace {
+
+/**
+ * @brief Horloge système : QElapsedTimer démarré au premier usage.
+ */
+class SystemFrameClock : public FrameClock
+{
+public:
+    SystemFrameClock()
+    {
+        timer.start();
+    }
+
+    qint64 elapsedMs() const override
+    {
+        return timer.elapsed();
+    }
+
+    QTime currentTime() const override
+    {
+        return QTime::currentTime();
+    }
+
+private:
+    QElapsedTimer timer;
+};
+
+} // namespace
+
+const FrameClock *FrameClock::systemClock()
+{
+    static const SystemFrameClock clock;
+    return &clock;
+}
+
+ManualFrameClock::ManualFrameClock(const QTime &time)
+    : wallTime(time)
+{
+}
+
+qint64 ManualFrameClock::elapsedMs() const
+{
+    return nowMs;
+}
+
+QTime ManualFrameClock::currentTime() const
+{
+    return wallTime;
+}
+
+void ManualFrameClock::advance(qint64 ms)
+{
+    nowMs += ms;
+    wallTime = wallTime.addMSecs(static_cast<int>(ms));
+}
+
+void ManualFrameClock::setTime(const QTime &time)
+{
+    wallTime = time;
+}
@@ -0,0 +1,466 @@
+/**
+ * @file framestream.cpp
+ * @author G. Maxime
+ * @brief Implémentation de la diffusion TCP des images, compressée par différences.
+ */
+
+// Inclusion de mes headers
+#include "headers/framestream.h"
+#include "headers/trace.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QElapsedTimer>
+#include <QtEndian>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Intensité à partir de laquelle une LED est transmise allumée.
+ */
+constexpr quint8 kLitLevel = 128;
+
+/**
+ * @brief Plage d'octets inchangés à partir de laquelle une plage de XOR est close.
+ * En dessous, il coûte moins cher de transmettre les zéros que d'ouvrir une nouvelle plage.
+ */
+constexpr int kMinSkip = 4;
+
+/**
+ * @brief Taille de l'en-tête d'un message (type et longueur).
+ */
+constexpr int kMessageHeaderBytes = 5;
+
+/**
+ * @brief Taille maximale acceptée pour un message reçu.
+ */
+constexpr int kMaxMessageBytes = 16 * 1024 * 1024;
+
+void appendU16(QByteArray *out, quint16 value)
+{
+    out->append(static_cast<char>(value & 0xFF));
+    out->append(static_cast<char>(value >> 8));
+}
+
+void appendU32(QByteArray *out, quint32 value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+        out->append(static_cast<char>((value >> shift) & 0xFF));
+}
+
+void appendVarint(QByteArray *out, quint32 value)
+{
+    while (value >= 0x80) {
+        out->append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out->append(static_cast<char>(value));
+}
+
+/**
+ * @brief Ouvre un message : type et longueur provisoire, corrigée par finishMessage().
+ */
+void beginMessage(QByteArray *out, char type)
+{
+    out->clear();
+    out->append(type);
+    appendU32(out, 0);
+}
+
+void finishMessage(QByteArray *out)
+{
+    qToLittleEndian<quint32>(static_cast<quint32>(out->size() - kMessageHeaderBytes), out->data() + 1);
+}
+
+/**
+ * @brief Lecture bornée d'une charge de message.
+ */
+struct PayloadReader {
+    const quint8 *data;
+    int size;
+    int position = 0;
+
+    bool readU8(quint32 *value)
+    {
+        if (position + 1 > size)
+            return false;
+        *value = data[position++];
+        return true;
+    }
+
+    bool readU16(quint32 *value)
+    {
+        if (position + 2 > size)
+            return false;
+        *value = qFromLittleEndian<quint16>(data + position);
+        position += 2;
+        return true;
+    }
+
+    bool readU32(quint32 *value)
+    {
+        if (position + 4 > size)
+            return false;
+        *value = qFromLittleEndian<quint32>(data + position);
+        position += 4;
+        return true;
+    }
+
+    bool readVarint(quint32 *value)
+    {
+        *value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (position >= size)
+                return false;
+            const quint8 byte = data[position++];
+            *value |= static_cast<quint32>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool atEnd() const { return position >= size; }
+};
+
+} // namespace
+
+FrameStreamServer::FrameStreamServer(QObject *parent)
+    : QObject(parent)
+{
+    server = new QTcpServer(this);
+    connect(server, &QTcpServer::newConnection, this, &FrameStreamServer::onNewConnection);
+}
+
+bool FrameStreamServer::listen(quint16 port, QString *errorMessage)
+{
+    if (!server->listen(QHostAddress::Any, port)) {
+        *errorMessage = QStringLiteral("Cannot listen on port %1: %2").arg(port).arg(server->errorString());
+        return false;
+    }
+    return true;
+}
+
+quint16 FrameStreamServer::port() const
+{
+    return server->serverPort();
+}
+
+void FrameStreamServer::setMaxPendingBytes(qint64 bytes)
+{
+    pendingLimit = std::max<qint64>(1, bytes);
+}
+
+qint64 FrameStreamServer::maxPendingBytes() const
+{
+    return pendingLimit;
+}
+
+FrameStreamServer::Statistics FrameStreamServer::statistics() const
+{
+    Statistics current = stats;
+    current.clients = static_cast<int>(clients.size());
+    return current;
+}
+
+int FrameStreamServer::packedBytes(int cols, int rows, int inkBits)
+{
+    const int leds = cols * rows;
+    const int inkBytes = inkBits == 8 ? leds : (inkBits == 4 ? (leds + 1) / 2 : 0);
+    return (leds + 7) / 8 + inkBytes;
+}
+
+void FrameStreamServer::packFrame(const LedFrame &frame, std::vector<quint8> *packed)
+{
+    const int leds = frame.ledCount();
+    const int inkBits = frame.inkDepth();
+    packed->resize(static_cast<size_t>(packedBytes(frame.cols(), frame.rows(), inkBits)));
+    std::fill(packed->begin(), packed->end(), quint8(0));
+
+    // Encres des seules LED allumées : une LED éteinte ne change jamais le flux
+    quint8 *bits = packed->data();
+    quint8 *inks = bits + (leds + 7) / 8;
+    const quint8 *levels = frame.data();
+    for (int index = 0; index < leds; ++index) {
+        if (levels[index] < kLitLevel)
+            continue;
+        bits[index >> 3] |= static_cast<quint8>(1u << (index & 7));
+        if (inkBits == 8)
+            inks[index] = frame.inkAt(index);
+        else if (inkBits == 4)
+            inks[index >> 1] |= static_cast<quint8>(frame.inkAt(index) << ((index & 1) * 4));
+    }
+}
+
+void FrameStreamServer::publish(const LedFrame &frame, const LedPalette &palette)
+{
+    MATRIX_TRACE_SCOPE("FrameStreamServer::publish");
+    QElapsedTimer publishTimer;
+    publishTimer.start();
+
+    const bool geometryChanged = frame.cols() != cols || frame.rows() != rows || frame.inkDepth() != inkBits;
+    bool paletteChanged = palette.size() != colors.size();
+    for (int index = 0; !paletteChanged && index < colors.size(); ++index) {
+        paletteChanged = palette.color(index) != colors[index];
+    }
+
+    packFrame(frame, &nextPacked);
+    if (frameNumber > 0 && !geometryChanged && !paletteChanged && nextPacked == latestPacked)
+        return;
+
+    // Différence impossible après un changement de géométrie ou de palette : image clé pour tous
+    const bool deltaPossible = frameNumber > 0 && !geometryChanged && !paletteChanged;
+    if (deltaPossible) {
+        encodeDelta();
+        stats.deltaBytes += static_cast<quint64>(deltaMessage.size());
+    }
+    if (geometryChanged) {
+        cols = frame.cols();
+        rows = frame.rows();
+        inkBits = frame.inkDepth();
+    }
+    if (paletteChanged) {
+        colors.resize(palette.size());
+        for (int index = 0; index < colors.size(); ++index) {
+            colors[index] = palette.color(index);
+        }
+    }
+    std::swap(latestPacked, nextPacked);
+    ++frameNumber;
+    ++stats.framesEncoded;
+
+    for (Client &client : clients) {
+        // Client saturé : il saute les images et sera resynchronisé quand son tampon se videra
+        if (client.socket->bytesToWrite() > pendingLimit) {
+            client.needsKeyframe = true;
+            ++stats.framesSkipped;
+            continue;
+        }
+        if (client.needsKeyframe || !deltaPossible) {
+            send(client, keyframeMessage());
+            client.needsKeyframe = false;
+            ++stats.keyframesSent;
+        } else {
+            send(client, deltaMessage);
+            ++stats.deltasSent;
+        }
+    }
+    stats.publishNs += publishTimer.nsecsElapsed();
+}
+
+void FrameStreamServer::encodeDelta()
+{
+    MATRIX_TRACE_SCOPE("FrameStreamServer::encodeDelta");
+    beginMessage(&deltaMessage, 'D');
+    appendU32(&deltaMessage, frameNumber + 1);
+
+    const quint8 *next = nextPacked.data();
+    const quint8 *latest = latestPacked.data();
+    const int size = static_cast<int>(nextPacked.size());
+    int position = 0;
+    while (position < size) {
+        const int skipStart = position;
+        while (position < size && next[position] == latest[position])
+            ++position;
+        if (position == size)
+            break;
+
+        // Plage de XOR jusqu'à kMinSkip octets inchangés consécutifs
+        const int literalStart = position;
+        int unchanged = 0;
+        while (position < size && unchanged < kMinSkip) {
+            unchanged = next[position] == latest[position] ? unchanged + 1 : 0;
+            ++position;
+        }
+        const int literalEnd = position - unchanged;
+        appendVarint(&deltaMessage, static_cast<quint32>(literalStart - skipStart));
+        appendVarint(&deltaMessage, static_cast<quint32>(literalEnd - literalStart));
+        for (int index = literalStart; index < literalEnd; ++index) {
+            deltaMessage.append(static_cast<char>(next[index] ^ latest[index]));
+        }
+        position = literalEnd;
+    }
+    finishMessage(&deltaMessage);
+}
+
+const QByteArray &FrameStreamServer::keyframeMessage()
+{
+    if (cachedKeyframeNumber == frameNumber && !cachedKeyframe.isEmpty())
+        return cachedKeyframe;
+
+    beginMessage(&cachedKeyframe, 'K');
+    appendU32(&cachedKeyframe, frameNumber);
+    appendU16(&cachedKeyframe, static_cast<quint16>(cols));
+    appendU16(&cachedKeyframe, static_cast<quint16>(rows));
+    cachedKeyframe.append(static_cast<char>(inkBits));
+    appendU16(&cachedKeyframe, static_cast<quint16>(colors.size()));
+    for (QRgb color : colors) {
+        cachedKeyframe.append(static_cast<char>(qRed(color)));
+        cachedKeyframe.append(static_cast<char>(qGreen(color)));
+        cachedKeyframe.append(static_cast<char>(qBlue(color)));
+    }
+    cachedKeyframe.append(reinterpret_cast<const char *>(latestPacked.data()), static_cast<int>(latestPacked.size()));
+    finishMessage(&cachedKeyframe);
+    cachedKeyframeNumber = frameNumber;
+    stats.keyframeBytes = static_cast<quint64>(cachedKeyframe.size());
+    return cachedKeyframe;
+}
+
+void FrameStreamServer::send(Client &client, const QByteArray &message)
+{
+    client.socket->write(message);
+    stats.bytesSent += static_cast<quint64>(message.size());
+    stats.peakPendingBytes = std::max(stats.peakPendingBytes, client.socket->bytesToWrite());
+}
+
+void FrameStreamServer::onNewConnection()
+{
+    while (server->hasPendingConnections()) {
+        QTcpSocket *socket = server->nextPendingConnection();
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() { removeClient(socket); });
+        connect(socket, &QTcpSocket::bytesWritten, this, [this, socket]() { resyncClient(socket); });
+        clients.push_back(Client{socket, true});
+        resyncClient(socket);
+    }
+}
+
+void FrameStreamServer::resyncClient(QTcpSocket *socket)
+{
+    if (frameNumber == 0)
+        return;
+    for (Client &client : clients) {
+        if (client.socket != socket)
+            continue;
+        if (client.needsKeyframe && socket->bytesToWrite() <= pendingLimit) {
+            send(client, keyframeMessage());
+            client.needsKeyframe = false;
+            ++stats.keyframesSent;
+        }
+        return;
+    }
+}
+
+void FrameStreamServer::removeClient(QTcpSocket *socket)
+{
+    clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                 [socket](const Client &client) { return client.socket == socket; }),
+                  clients.end());
+    socket->deleteLater();
+}
+
+int FrameStreamDecoder::feed(const QByteArray &bytes, QString *errorMessage)
+{
+    pending.append(bytes);
+    int decoded = 0;
+    int offset = 0;
+    while (pending.size() - offset >= kMessageHeaderBytes) {
+        const char *message = pending.constData() + offset;
+        const quint32 length = qFromLittleEndian<quint32>(message + 1);
+        if (length > static_cast<quint32>(kMaxMessageBytes)) {
+            *errorMessage = QStringLiteral("Frame stream message too large (%1 bytes)").arg(length);
+            return -1;
+        }
+        if (pending.size() - offset < kMessageHeaderBytes + static_cast<int>(length))
+            break;
+        if (!decode(message[0], message + kMessageHeaderBytes, static_cast<int>(length), errorMessage))
+            return -1;
+        offset += kMessageHeaderBytes + static_cast<int>(length);
+        ++decoded;
+    }
+    pending.remove(0, offset);
+    return decoded;
+}
+
+bool FrameStreamDecoder::decode(char type, const char *payload, int size, QString *errorMessage)
+{
+    PayloadReader reader{reinterpret_cast<const quint8 *>(payload), size};
+    quint32 frame = 0;
+    if (!reader.readU32(&frame)) {
+        *errorMessage = QStringLiteral("Truncated frame stream message");
+        return false;
+    }
+
+    if (type == 'K') {
+        quint32 newCols = 0;
+        quint32 newRows = 0;
+        quint32 newInkBits = 0;
+        quint32 paletteSize = 0;
+        if (!reader.readU16(&newCols) || !reader.readU16(&newRows) || !reader.readU8(&newInkBits)
+            || !reader.readU16(&paletteSize)
+            || (newInkBits != 0 && newInkBits != 4 && newInkBits != 8)) {
+            *errorMessage = QStringLiteral("Invalid keyframe header");
+            return false;
+        }
+        const int bytes = FrameStreamServer::packedBytes(static_cast<int>(newCols), static_cast<int>(newRows),
+                                                         static_cast<int>(newInkBits));
+        if (reader.size - reader.position != static_cast<int>(paletteSize) * 3 + bytes) {
+            *errorMessage = QStringLiteral("Invalid keyframe size");
+            return false;
+        }
+        colors.resize(static_cast<int>(paletteSize));
+        for (int index = 0; index < colors.size(); ++index) {
+            const quint8 *rgb = reader.data + reader.position + index * 3;
+            colors[index] = qRgb(rgb[0], rgb[1], rgb[2]);
+        }
+        reader.position += static_cast<int>(paletteSize) * 3;
+        plane.assign(reader.data + reader.position, reader.data + reader.size);
+        frameCols = static_cast<int>(newCols);
+        frameRows = static_cast<int>(newRows);
+        frameInkBits = static_cast<int>(newInkBits);
+        number = frame;
+        synced = true;
+        ++keyframeCount;
+        return true;
+    }
+
+    if (type == 'D') {
+        // Différence reçue avant l'image clé : ignorée, l'image clé suivra
+        if (!synced)
+            return true;
+        const int planeSize = static_cast<int>(plane.size());
+        int position = 0;
+        while (!reader.atEnd()) {
+            quint32 skip = 0;
+            quint32 count = 0;
+            if (!reader.readVarint(&skip) || !reader.readVarint(&count)
+                || static_cast<qint64>(position) + skip + count > planeSize
+                || reader.position + static_cast<int>(count) > reader.size) {
+                *errorMessage = QStringLiteral("Invalid delta in frame %1").arg(frame);
+                return false;
+            }
+            position += static_cast<int>(skip);
+            for (quint32 index = 0; index < count; ++index) {
+                plane[position++] ^= reader.data[reader.position++];
+            }
+        }
+        number = frame;
+        ++deltaCount;
+        return true;
+    }
+
+    *errorMessage = QStringLiteral("Unknown frame stream message type %1").arg(static_cast<int>(type));
+    return false;
+}
+
+bool FrameStreamDecoder::isLit(int col, int row) const
+{
+    const int index = row * frameCols + col;
+    return (plane[index >> 3] >> (index & 7)) & 1;
+}
+
+quint8 FrameStreamDecoder::ink(int col, int row) const
+{
+    const int index = row * frameCols + col;
+    const quint8 *inks = plane.data() + (frameCols * frameRows + 7) / 8;
+    if (frameInkBits == 8)
+        return inks[index];
+    if (frameInkBits == 4)
+        return (inks[index >> 1] >> ((index & 1) * 4)) & 0x0F;
+    return 0;
+}
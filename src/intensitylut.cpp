@@ -0,0 +1,178 @@
+/**
+ * @file intensitylut.cpp
+ * @author G. Maxime
+ * @brief Implémentation de la table de réponse lumineuse et de la simulation par plans de bit.
+ */
+
+// Inclusion de mes headers
+#include "headers/intensitylut.h"
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Fenêtre d'exposition de la première image, ou après une pause, en millisecondes.
+ */
+constexpr qint64 kDefaultExposureMs = 16;
+
+/**
+ * @brief Fenêtre d'exposition maximale (persistance rétinienne), en millisecondes.
+ */
+constexpr qint64 kMaxExposureMs = 100;
+
+} // namespace
+
+IntensityLut::IntensityLut()
+{
+    rebuildResponse();
+}
+
+void IntensityLut::setResponse(double gamma, double brightness)
+{
+    gamma = std::clamp(gamma, 0.1, 5.0);
+    brightness = std::clamp(brightness, 0.0, 1.0);
+    if (gamma == gammaValue && brightness == brightnessValue)
+        return;
+
+    gammaValue = gamma;
+    brightnessValue = brightness;
+    rebuildResponse();
+    ++stats.tableBuilds;
+}
+
+void IntensityLut::setBitPlanes(int bits, int refreshHz)
+{
+    this->bits = std::clamp(bits, 0, MaxPlaneBits);
+    this->refreshHz = std::max(1, refreshHz);
+    animating = false;
+    if (this->bits == 0)
+        current = response;
+}
+
+void IntensityLut::rebuildResponse()
+{
+    identity = true;
+    response[0] = 0;
+    for (int level = 1; level < 256; ++level) {
+        const double mapped = 255.0 * brightnessValue * std::pow(level / 255.0, gammaValue);
+        response[static_cast<size_t>(level)] = static_cast<quint8>(std::lround(std::clamp(mapped, 0.0, 255.0)));
+        identity = identity && response[static_cast<size_t>(level)] == level;
+    }
+    if (bits == 0)
+        current = response;
+}
+
+bool IntensityLut::composePlanes(qint64 nowMs)
+{
+    const qint64 elapsedMs = lastApplyMs < 0 || nowMs <= lastApplyMs ? kDefaultExposureMs : nowMs - lastApplyMs;
+    const double windowUs = 1000.0 * static_cast<double>(std::min(elapsedMs, kMaxExposureMs));
+    const double endUs = 1000.0 * static_cast<double>(nowMs);
+    const double startUs = endUs - windowUs;
+
+    // Plan k : 2^k tops à partir du top 2^k - 1 de chaque cycle
+    const int maxCode = (1 << bits) - 1;
+    const double cycleUs = 1e6 / refreshHz;
+    const double tickUs = cycleUs / maxCode;
+    std::array<double, MaxPlaneBits> weights{};
+    for (int plane = 0; plane < bits; ++plane) {
+        const double planeStartUs = ((1 << plane) - 1) * tickUs;
+        const double planeUs = (1 << plane) * tickUs;
+        const auto litBefore = [&](double timeUs) {
+            const double cycles = std::floor(timeUs / cycleUs);
+            return cycles * planeUs + std::clamp(timeUs - cycles * cycleUs - planeStartUs, 0.0, planeUs);
+        };
+        weights[static_cast<size_t>(plane)] = (litBefore(endUs) - litBefore(startUs)) / windowUs;
+    }
+
+    // Intensité perçue de chaque code du panneau, puis table composée avec la réponse
+    std::array<quint8, 256> codeLevels{};
+    for (int code = 1; code <= maxCode; ++code) {
+        double lit = 0.0;
+        for (int plane = 0; plane < bits; ++plane) {
+            if (code & (1 << plane))
+                lit += weights[static_cast<size_t>(plane)];
+        }
+        codeLevels[static_cast<size_t>(code)] = static_cast<quint8>(std::lround(std::min(lit, 1.0) * 255.0));
+    }
+    std::array<quint8, 256> next;
+    for (int level = 0; level < 256; ++level) {
+        const int code = (response[static_cast<size_t>(level)] * maxCode + 127) / 255;
+        next[static_cast<size_t>(level)] = codeLevels[static_cast<size_t>(code)];
+    }
+    ++stats.planeTables;
+
+    const bool changed = next != current;
+    current = next;
+    return changed;
+}
+
+void IntensityLut::applyTable(quint8 *levels, int count, const std::array<quint8, 256> &table)
+{
+    int i = 0;
+#if defined(__AVX2__)
+    // Table de 256 entrées vue comme 16 tables de 16 lues par vpshufb, 32 LED à la fois.
+    // Pour la table h, l'index value - 16h est décalé de 0x70 avec saturation : le bit 7
+    // (résultat nul) n'est libre que si value est dans [16h, 16h + 16), et le quartet bas
+    // reste l'entrée
+    __m256i subTables[16];
+    for (int high = 0; high < 16; ++high) {
+        subTables[high] = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(table.data() + high * 16)));
+    }
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i step = _mm256_set1_epi8(16);
+    const __m256i bias = _mm256_set1_epi8(0x70);
+    for (; i + 32 <= count; i += 32) {
+        __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(levels + i));
+        if (_mm256_testz_si256(value, value))
+            continue;
+        __m256i mapped = zero;
+        for (int high = 0; high < 16; ++high) {
+            mapped = _mm256_or_si256(mapped, _mm256_shuffle_epi8(subTables[high], _mm256_adds_epu8(value, bias)));
+            value = _mm256_sub_epi8(value, step);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(levels + i), mapped);
+    }
+#elif defined(__SSE2__)
+    // Sans AVX2, lectures scalaires (la même décomposition en pshufb sur 16 octets ne bat pas
+    // la boucle scalaire) : seuls les blocs de 16 LED éteintes, le cas courant d'un texte
+    // sur fond noir, sont sautés d'une comparaison
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(levels + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(value, zero)) == 0xFFFF)
+            continue;
+        for (int led = i; led < i + 16; ++led)
+            levels[led] = table[levels[led]];
+    }
+#endif
+    for (; i < count; ++i)
+        levels[i] = table[levels[i]];
+}
+
+const LedFrame &IntensityLut::apply(const LedFrame &frame, qint64 nowMs)
+{
+    if (isIdentity()) {
+        lastApplyMs = nowMs;
+        return frame;
+    }
+
+    ++stats.frames;
+    if (bits != 0)
+        animating = composePlanes(nowMs);
+    lastApplyMs = nowMs;
+
+    // Copie sans allocation en régime établi : les tampons gardent leur capacité
+    mappedFrame = frame;
+    applyTable(mappedFrame.data(), mappedFrame.ledCount(), current);
+    return mappedFrame;
+}
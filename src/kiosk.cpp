@@ -0,0 +1,1057 @@
+/**
+ * @file kiosk.cpp
+ * @author G. Maxime
+ * @brief Implémentation du mode kiosque : configuration par ligne de commande ou fichier INI,
+ * affichage de la MatrixDisplay seule et sortie framebuffer hors écran.
+ */
+
+// Inclusion de mes headers
+#include "headers/kiosk.h"
+#include "headers/spritecache.h"
+#include "headers/trace.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QCommandLineOption>
+#include <QSettings>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QTimer>
+#include <QPainter>
+#include <QDebug>
+
+// Inclusion des headers standard nécessaires
+#include <cstring>
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Espacement ajouté après chaque message du bandeau.
+ */
+const QString kTickerSeparator = QStringLiteral("   ");
+
+/**
+ * @brief Intervalle minimal entre deux messages de qualité adaptative, en millisecondes.
+ */
+constexpr int kQualityLogIntervalMs = 10000;
+
+/**
+ * @brief Convertit une politique de défilement textuelle (auto, off, default, bounce).
+ */
+bool parseScrollPolicy(const QString &value, KioskConfig::ScrollPolicy *policy)
+{
+    const QString key = value.trimmed().toLower();
+    if (key == QStringLiteral("auto")) {
+        *policy = KioskConfig::ScrollAuto;
+    } else if (key == QStringLiteral("off")) {
+        *policy = KioskConfig::ScrollOff;
+    } else if (key == QStringLiteral("default")) {
+        *policy = KioskConfig::ScrollDefault;
+    } else if (key == QStringLiteral("bounce")) {
+        *policy = KioskConfig::ScrollBounce;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Convertit un nom de transition (none, crossfade, wipe).
+ */
+bool parseTransition(const QString &value, LedEffects::Transition *transition)
+{
+    const QString key = value.trimmed().toLower();
+    if (key == QStringLiteral("none")) {
+        *transition = LedEffects::NoTransition;
+    } else if (key == QStringLiteral("crossfade")) {
+        *transition = LedEffects::Crossfade;
+    } else if (key == QStringLiteral("wipe")) {
+        *transition = LedEffects::Wipe;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Convertit un style de LED textuel (dot, glow).
+ */
+bool parseLedStyle(const QString &value, LedRenderer::Style *style)
+{
+    const QString key = value.trimmed().toLower();
+    if (key == QStringLiteral("dot")) {
+        *style = LedRenderer::DotStyle;
+    } else if (key == QStringLiteral("glow")) {
+        *style = LedRenderer::GlowStyle;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Vérifie qu'un fichier image est lisible (en-tête seulement : le décodage a lieu au chargement).
+ */
+bool checkImage(const QString &path, QString *errorMessage)
+{
+    QImageReader reader(path);
+    if (!reader.canRead()) {
+        *errorMessage = QStringLiteral("Cannot read image %1: %2").arg(path, reader.errorString());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Convertit une durée positive ou nulle en millisecondes.
+ */
+bool parseDuration(const QString &value, int *durationMs)
+{
+    bool ok = false;
+    const int parsed = value.toInt(&ok);
+    if (!ok || parsed < 0)
+        return false;
+    *durationMs = parsed;
+    return true;
+}
+
+/**
+ * @brief Convertit un courant positif ou nul en milliampères.
+ */
+bool parseCurrent(const QString &value, double *milliamps)
+{
+    bool ok = false;
+    const double parsed = value.toDouble(&ok);
+    if (!ok || parsed < 0.0)
+        return false;
+    *milliamps = parsed;
+    return true;
+}
+
+/**
+ * @brief Convertit une taille au format LARGEURxHAUTEUR.
+ */
+bool parseSize(const QString &value, QSize *size)
+{
+    const QStringList parts = value.trimmed().toLower().split(QLatin1Char('x'));
+    if (parts.size() != 2)
+        return false;
+
+    bool okWidth = false;
+    bool okHeight = false;
+    const int w = parts[0].toInt(&okWidth);
+    const int h = parts[1].toInt(&okHeight);
+    if (!okWidth || !okHeight || w <= 0 || h <= 0)
+        return false;
+
+    *size = QSize(w, h);
+    return true;
+}
+
+/**
+ * @brief Convertit une profondeur de palette (4 ou 8 bits).
+ */
+bool parsePaletteBits(const QString &value, int *bits)
+{
+    bool ok = false;
+    const int parsed = value.toInt(&ok);
+    if (!ok || (parsed != 4 && parsed != 8))
+        return false;
+    *bits = parsed;
+    return true;
+}
+
+/**
+ * @brief Convertit un réel compris entre minimum et maximum.
+ */
+bool parseBoundedReal(const QString &value, double minimum, double maximum, double *result)
+{
+    bool ok = false;
+    const double parsed = value.toDouble(&ok);
+    if (!ok || parsed < minimum || parsed > maximum)
+        return false;
+    *result = parsed;
+    return true;
+}
+
+/**
+ * @brief Convertit une profondeur de panneau simulé (0 à 8 bits).
+ */
+bool parsePlaneBits(const QString &value, int *bits)
+{
+    bool ok = false;
+    const int parsed = value.toInt(&ok);
+    if (!ok || parsed < 0 || parsed > IntensityLut::MaxPlaneBits)
+        return false;
+    *bits = parsed;
+    return true;
+}
+
+/**
+ * @brief Convertit une fréquence de rafraîchissement strictement positive, en Hz.
+ */
+bool parseRefresh(const QString &value, int *hertz)
+{
+    bool ok = false;
+    const int parsed = value.toInt(&ok);
+    if (!ok || parsed <= 0)
+        return false;
+    *hertz = parsed;
+    return true;
+}
+
+/**
+ * @brief Convertit un rectangle au format x,y,largeur,hauteur (en LED).
+ */
+bool parseArea(const QString &value, QRect *area)
+{
+    const QStringList parts = value.trimmed().split(QLatin1Char(','));
+    if (parts.size() != 4)
+        return false;
+
+    int numbers[4];
+    for (int i = 0; i < 4; ++i) {
+        bool ok = false;
+        numbers[i] = parts[i].trimmed().toInt(&ok);
+        if (!ok)
+            return false;
+    }
+    if (numbers[2] <= 0 || numbers[3] <= 0)
+        return false;
+
+    *area = QRect(numbers[0], numbers[1], numbers[2], numbers[3]);
+    return true;
+}
+
+/**
+ * @brief Convertit une couleur (#RRGGBB ou nom SVG) en signalant les valeurs invalides.
+ */
+bool parseColor(const QString &value, QColor *color, const QString &name, QString *errorMessage)
+{
+    const QColor parsed(value.trimmed());
+    if (!parsed.isValid()) {
+        *errorMessage = QStringLiteral("Invalid %1 color: %2").arg(name, value);
+        return false;
+    }
+    *color = parsed;
+    return true;
+}
+
+/**
+ * @brief Convertit une vitesse de défilement (1 à 5).
+ */
+bool parseSpeed(const QString &value, int *speed, QString *errorMessage)
+{
+    bool ok = false;
+    const int parsed = value.toInt(&ok);
+    if (!ok || parsed < 1 || parsed > 5) {
+        *errorMessage = QStringLiteral("Invalid speed (expected 1 to 5): %1").arg(value);
+        return false;
+    }
+    *speed = parsed;
+    return true;
+}
+
+} // namespace
+
+bool KioskConfig::requestsFramebuffer(int argc, char *argv[])
+{
+    QString configPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--framebuffer") == 0 || std::strncmp(argv[i], "--framebuffer=", 14) == 0)
+            return true;
+        if (std::strcmp(argv[i], "--config") == 0 && i + 1 < argc)
+            configPath = QString::fromLocal8Bit(argv[i + 1]);
+        else if (std::strncmp(argv[i], "--config=", 9) == 0)
+            configPath = QString::fromLocal8Bit(argv[i] + 9);
+    }
+
+    if (configPath.isEmpty())
+        return false;
+
+    const QSettings settings(configPath, QSettings::IniFormat);
+    return !settings.value(QStringLiteral("kiosk/framebuffer")).toString().isEmpty();
+}
+
+bool KioskConfig::loadFile(const QString &path, QString *errorMessage)
+{
+    if (!QFileInfo(path).exists()) {
+        *errorMessage = QStringLiteral("Config file not found: %1").arg(path);
+        return false;
+    }
+
+    QSettings settings(path, QSettings::IniFormat);
+    if (settings.status() != QSettings::NoError) {
+        *errorMessage = QStringLiteral("Cannot read config file: %1").arg(path);
+        return false;
+    }
+
+    settings.beginGroup(QStringLiteral("kiosk"));
+    text = settings.value(QStringLiteral("text"), text).toString();
+    if (settings.contains(QStringLiteral("pixelColor"))
+        && !parseColor(settings.value(QStringLiteral("pixelColor")).toString(), &pixelColor, QStringLiteral("pixel"), errorMessage))
+        return false;
+    if (settings.contains(QStringLiteral("backgroundColor"))
+        && !parseColor(settings.value(QStringLiteral("backgroundColor")).toString(), &backgroundColor, QStringLiteral("background"), errorMessage))
+        return false;
+    if (settings.contains(QStringLiteral("scroll"))
+        && !parseScrollPolicy(settings.value(QStringLiteral("scroll")).toString(), &scroll)) {
+        *errorMessage = QStringLiteral("Invalid scroll mode in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("speed"))
+        && !parseSpeed(settings.value(QStringLiteral("speed")).toString(), &speed, errorMessage))
+        return false;
+    if (settings.contains(QStringLiteral("transition"))
+        && !parseTransition(settings.value(QStringLiteral("transition")).toString(), &transition)) {
+        *errorMessage = QStringLiteral("Invalid transition in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("transitionMs"))
+        && !parseDuration(settings.value(QStringLiteral("transitionMs")).toString(), &transitionMs)) {
+        *errorMessage = QStringLiteral("Invalid transitionMs in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("afterglowMs"))
+        && !parseDuration(settings.value(QStringLiteral("afterglowMs")).toString(), &afterglowMs)) {
+        *errorMessage = QStringLiteral("Invalid afterglowMs in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("ledStyle"))
+        && !parseLedStyle(settings.value(QStringLiteral("ledStyle")).toString(), &ledStyle)) {
+        *errorMessage = QStringLiteral("Invalid ledStyle in %1").arg(path);
+        return false;
+    }
+    clock = settings.value(QStringLiteral("clock"), clock).toBool();
+    clockSeconds = settings.value(QStringLiteral("clockSeconds"), clockSeconds).toBool();
+    clock12h = settings.value(QStringLiteral("clock12h"), clock12h).toBool();
+    fullscreen = settings.value(QStringLiteral("fullscreen"), fullscreen).toBool();
+    framebufferPath = settings.value(QStringLiteral("framebuffer"), framebufferPath).toString();
+    if (settings.contains(QStringLiteral("framebufferSize"))
+        && !parseSize(settings.value(QStringLiteral("framebufferSize")).toString(), &framebufferSize)) {
+        *errorMessage = QStringLiteral("Invalid framebufferSize in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("startupBudgetMs"))) {
+        bool ok = false;
+        startupBudgetMs = settings.value(QStringLiteral("startupBudgetMs")).toInt(&ok);
+        if (!ok || startupBudgetMs <= 0) {
+            *errorMessage = QStringLiteral("Invalid startupBudgetMs in %1").arg(path);
+            return false;
+        }
+    }
+    strictStartup = settings.value(QStringLiteral("strictStartup"), strictStartup).toBool();
+    measureWakeups = settings.value(QStringLiteral("measureWakeups"), measureWakeups).toBool();
+    measureLatency = settings.value(QStringLiteral("measureLatency"), measureLatency).toBool();
+    measurePower = settings.value(QStringLiteral("measurePower"), measurePower).toBool();
+    if (settings.contains(QStringLiteral("ledCurrentMa"))
+        && !parseCurrent(settings.value(QStringLiteral("ledCurrentMa")).toString(), &ledCurrentMa)) {
+        *errorMessage = QStringLiteral("Invalid ledCurrentMa in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("powerLimitMa"))
+        && !parseCurrent(settings.value(QStringLiteral("powerLimitMa")).toString(), &powerLimitMa)) {
+        *errorMessage = QStringLiteral("Invalid powerLimitMa in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("gamma"))
+        && !parseBoundedReal(settings.value(QStringLiteral("gamma")).toString(), 0.1, 5.0, &gamma)) {
+        *errorMessage = QStringLiteral("Invalid gamma (expected 0.1 to 5) in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("brightness"))
+        && !parseBoundedReal(settings.value(QStringLiteral("brightness")).toString(), 0.0, 1.0, &brightness)) {
+        *errorMessage = QStringLiteral("Invalid brightness (expected 0 to 1) in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("bitPlanes"))
+        && !parsePlaneBits(settings.value(QStringLiteral("bitPlanes")).toString(), &bitPlanes)) {
+        *errorMessage = QStringLiteral("Invalid bitPlanes (expected 0 to 8) in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("pwmRefreshHz"))
+        && !parseRefresh(settings.value(QStringLiteral("pwmRefreshHz")).toString(), &pwmRefreshHz)) {
+        *errorMessage = QStringLiteral("Invalid pwmRefreshHz in %1").arg(path);
+        return false;
+    }
+    renderThread = settings.value(QStringLiteral("renderThread"), renderThread).toBool();
+    tickerStdin = settings.value(QStringLiteral("tickerStdin"), tickerStdin).toBool();
+    tracePath = settings.value(QStringLiteral("traceFile"), tracePath).toString();
+    imagePath = settings.value(QStringLiteral("image"), imagePath).toString();
+    if (settings.contains(QStringLiteral("imageDither"))
+        && !LedImage::parseConversion(settings.value(QStringLiteral("imageDither")).toString(), &imageConversion)) {
+        *errorMessage = QStringLiteral("Invalid imageDither in %1").arg(path);
+        return false;
+    }
+    videoPath = settings.value(QStringLiteral("video"), videoPath).toString();
+    if (settings.contains(QStringLiteral("videoSize"))
+        && !parseSize(settings.value(QStringLiteral("videoSize")).toString(), &videoSize)) {
+        *errorMessage = QStringLiteral("Invalid videoSize in %1").arg(path);
+        return false;
+    }
+    sharedFrameKey = settings.value(QStringLiteral("sharedFrame"), sharedFrameKey).toString();
+    streamPort = settings.value(QStringLiteral("streamPort"), streamPort).toInt();
+    if (streamPort < 0 || streamPort > 65535) {
+        *errorMessage = QStringLiteral("Invalid streamPort in %1").arg(path);
+        return false;
+    }
+    spriteCacheMb = settings.value(QStringLiteral("spriteCacheMb"), spriteCacheMb).toInt();
+    if (spriteCacheMb < 0) {
+        *errorMessage = QStringLiteral("Invalid spriteCacheMb in %1").arg(path);
+        return false;
+    }
+    frameBudgetMs = settings.value(QStringLiteral("frameBudgetMs"), frameBudgetMs).toDouble();
+    if (frameBudgetMs < 0.0) {
+        *errorMessage = QStringLiteral("Invalid frameBudgetMs in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("matrixSize"))
+        && !parseSize(settings.value(QStringLiteral("matrixSize")).toString(), &matrixSize)) {
+        *errorMessage = QStringLiteral("Invalid matrixSize in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("area"))
+        && !parseArea(settings.value(QStringLiteral("area")).toString(), &area)) {
+        *errorMessage = QStringLiteral("Invalid area in %1").arg(path);
+        return false;
+    }
+    if (settings.contains(QStringLiteral("paletteBits"))
+        && !parsePaletteBits(settings.value(QStringLiteral("paletteBits")).toString(), &paletteBits)) {
+        *errorMessage = QStringLiteral("Invalid paletteBits (expected 4 or 8) in %1").arg(path);
+        return false;
+    }
+    settings.endGroup();
+
+    // Zones supplémentaires : sections [zone1], [zone2]... dans l'ordre d'empilement
+    zones.clear();
+    for (int index = 1; settings.childGroups().contains(QStringLiteral("zone%1").arg(index)); ++index) {
+        const QString group = QStringLiteral("zone%1").arg(index);
+        KioskZoneConfig zone;
+        settings.beginGroup(group);
+        if (!parseArea(settings.value(QStringLiteral("area")).toString(), &zone.area)) {
+            *errorMessage = QStringLiteral("Missing or invalid area in [%1] of %2").arg(group, path);
+            return false;
+        }
+        zone.text = settings.value(QStringLiteral("text")).toString();
+        if (settings.contains(QStringLiteral("pixelColor"))
+            && !parseColor(settings.value(QStringLiteral("pixelColor")).toString(), &zone.pixelColor, group, errorMessage))
+            return false;
+        ScrollPolicy zoneScroll = ScrollAuto;
+        if (settings.contains(QStringLiteral("scroll"))
+            && !parseScrollPolicy(settings.value(QStringLiteral("scroll")).toString(), &zoneScroll)) {
+            *errorMessage = QStringLiteral("Invalid scroll mode in [%1] of %2").arg(group, path);
+            return false;
+        }
+        zone.scroll = zoneScroll;
+        if (settings.contains(QStringLiteral("speed"))
+            && !parseSpeed(settings.value(QStringLiteral("speed")).toString(), &zone.speed, errorMessage))
+            return false;
+        zone.clock = settings.value(QStringLiteral("clock"), false).toBool();
+        zone.clockSeconds = settings.value(QStringLiteral("clockSeconds"), false).toBool();
+        zone.clock12h = settings.value(QStringLiteral("clock12h"), false).toBool();
+        zone.image = settings.value(QStringLiteral("image")).toString();
+        if (!zone.image.isEmpty() && !checkImage(zone.image, errorMessage))
+            return false;
+        if (settings.contains(QStringLiteral("imageDither"))
+            && !LedImage::parseConversion(settings.value(QStringLiteral("imageDither")).toString(), &zone.imageConversion)) {
+            *errorMessage = QStringLiteral("Invalid imageDither in [%1] of %2").arg(group, path);
+            return false;
+        }
+        settings.endGroup();
+        zones.append(zone);
+    }
+
+    return true;
+}
+
+bool KioskConfig::parse(const QStringList &arguments, QString *errorMessage)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("LED matrix display simulator"));
+    parser.addHelpOption();
+
+    const QCommandLineOption kioskOption(QStringLiteral("kiosk"),
+        QStringLiteral("Show only the matrix, without the control strip."));
+    const QCommandLineOption configOption(QStringLiteral("config"),
+        QStringLiteral("Read the kiosk configuration from an INI file ([kiosk] section)."), QStringLiteral("file"));
+    const QCommandLineOption textOption(QStringLiteral("text"),
+        QStringLiteral("Text to display ({red}, {#ff8000}, {rainbow} and {} select the color)."), QStringLiteral("text"));
+    const QCommandLineOption colorOption(QStringLiteral("color"),
+        QStringLiteral("LED color (#RRGGBB or color name)."), QStringLiteral("color"));
+    const QCommandLineOption backgroundOption(QStringLiteral("background"),
+        QStringLiteral("Background color (#RRGGBB or color name)."), QStringLiteral("color"));
+    const QCommandLineOption scrollOption(QStringLiteral("scroll"),
+        QStringLiteral("Scroll mode: auto, off, default or bounce."), QStringLiteral("mode"));
+    const QCommandLineOption speedOption(QStringLiteral("speed"),
+        QStringLiteral("Scroll speed, from 1 to 5."), QStringLiteral("speed"));
+    const QCommandLineOption transitionOption(QStringLiteral("transition"),
+        QStringLiteral("Transition between messages: none, crossfade or wipe."), QStringLiteral("effect"));
+    const QCommandLineOption transitionMsOption(QStringLiteral("transition-ms"),
+        QStringLiteral("Transition duration in milliseconds."), QStringLiteral("ms"));
+    const QCommandLineOption afterglowOption(QStringLiteral("afterglow"),
+        QStringLiteral("LED afterglow decay time in milliseconds (0 disables it, at most 10000)."), QStringLiteral("ms"));
+    const QCommandLineOption ledStyleOption(QStringLiteral("led-style"),
+        QStringLiteral("LED style: dot or glow (precomputed halo)."), QStringLiteral("style"));
+    const QCommandLineOption clockOption(QStringLiteral("clock"),
+        QStringLiteral("Display the clock instead of the text."));
+    const QCommandLineOption clockSecondsOption(QStringLiteral("clock-seconds"),
+        QStringLiteral("Display seconds in clock mode."));
+    const QCommandLineOption clock12hOption(QStringLiteral("clock-12h"),
+        QStringLiteral("Use the 12h format in clock mode."));
+    const QCommandLineOption fullscreenOption(QStringLiteral("fullscreen"),
+        QStringLiteral("Show the matrix fullscreen."));
+    const QCommandLineOption framebufferOption(QStringLiteral("framebuffer"),
+        QStringLiteral("Render frames into a raw 32-bit framebuffer file instead of a window."), QStringLiteral("file"));
+    const QCommandLineOption framebufferSizeOption(QStringLiteral("framebuffer-size"),
+        QStringLiteral("Framebuffer size in pixels (WIDTHxHEIGHT)."), QStringLiteral("size"));
+    const QCommandLineOption budgetOption(QStringLiteral("startup-budget"),
+        QStringLiteral("Startup-to-first-frame budget in milliseconds."), QStringLiteral("ms"));
+    const QCommandLineOption strictStartupOption(QStringLiteral("strict-startup"),
+        QStringLiteral("Exit with status 2 when the first frame misses the startup budget."));
+    const QCommandLineOption wakeupsOption(QStringLiteral("measure-wakeups"),
+        QStringLiteral("Log timer wake-ups per minute."));
+    const QCommandLineOption latencyOption(QStringLiteral("measure-latency"),
+        QStringLiteral("Log the input-to-photon latency of content changes (p50/p99/max) every minute."));
+    const QCommandLineOption powerOption(QStringLiteral("measure-power"),
+        QStringLiteral("Log the estimated LED current (average and peak) every minute."));
+    const QCommandLineOption ledCurrentOption(QStringLiteral("led-current"),
+        QStringLiteral("Current of one LED at full white, in mA (60 by default)."), QStringLiteral("ma"));
+    const QCommandLineOption powerLimitOption(QStringLiteral("power-limit"),
+        QStringLiteral("Total LED current limit in mA; brightness is scaled down to hold it (0 disables)."), QStringLiteral("ma"));
+    const QCommandLineOption gammaOption(QStringLiteral("gamma"),
+        QStringLiteral("Gamma exponent of the LED response (1 is linear)."), QStringLiteral("gamma"));
+    const QCommandLineOption brightnessOption(QStringLiteral("brightness"),
+        QStringLiteral("Global LED brightness, from 0 to 1."), QStringLiteral("level"));
+    const QCommandLineOption bitPlanesOption(QStringLiteral("bit-planes"),
+        QStringLiteral("Simulate the binary-coded PWM refresh of a panel with this bit depth (1 to 8, 0 disables)."),
+        QStringLiteral("bits"));
+    const QCommandLineOption pwmRefreshOption(QStringLiteral("pwm-refresh"),
+        QStringLiteral("Refresh rate of the simulated panel in Hz (240 by default)."), QStringLiteral("hz"));
+    const QCommandLineOption renderThreadOption(QStringLiteral("render-thread"),
+        QStringLiteral("Draw frames on a dedicated render thread instead of the GUI thread."));
+    const QCommandLineOption frameBudgetOption(QStringLiteral("frame-budget"),
+        QStringLiteral("Frame-time budget in milliseconds; LED quality is lowered to hold it (0 disables)."), QStringLiteral("ms"));
+    const QCommandLineOption tickerStdinOption(QStringLiteral("ticker-stdin"),
+        QStringLiteral("Append each line read on standard input to a continuously scrolling ticker."));
+    const QCommandLineOption spriteCacheOption(QStringLiteral("sprite-cache-mb"),
+        QStringLiteral("Byte cap of the shared LED sprite cache, in MiB (32 by default)."), QStringLiteral("mb"));
+    const QCommandLineOption imageOption(QStringLiteral("image"),
+        QStringLiteral("Image or animated GIF to display instead of the text."), QStringLiteral("file"));
+    const QCommandLineOption imageDitherOption(QStringLiteral("image-dither"),
+        QStringLiteral("Image conversion: threshold, ordered (4x4 Bayer) or color (8-color ordered dither)."), QStringLiteral("mode"));
+    const QCommandLineOption videoOption(QStringLiteral("video"),
+        QStringLiteral("Raw RGB24 video feed to display (file, FIFO or - for standard input)."), QStringLiteral("file"));
+    const QCommandLineOption videoSizeOption(QStringLiteral("video-size"),
+        QStringLiteral("Frame size of the raw video feed (WIDTHxHEIGHT), 640x360 by default."), QStringLiteral("size"));
+    const QCommandLineOption sharedFrameOption(QStringLiteral("shared-frame"),
+        QStringLiteral("Publish every presented LED frame into the named shared-memory segment."), QStringLiteral("key"));
+    const QCommandLineOption streamPortOption(QStringLiteral("stream-port"),
+        QStringLiteral("Stream every presented LED frame to TCP viewers on this port (keyframe, then deltas)."), QStringLiteral("port"));
+    const QCommandLineOption traceOption(QStringLiteral("trace"),
+        QStringLiteral("Write a Chrome trace (Perfetto) of timer, layout and paint phases on exit (MATRIX_TRACING builds)."), QStringLiteral("file"));
+    const QCommandLineOption matrixSizeOption(QStringLiteral("matrix-size"),
+        QStringLiteral("LED grid size (COLSxROWS), 100x12 by default."), QStringLiteral("size"));
+    const QCommandLineOption paletteBitsOption(QStringLiteral("palette-bits"),
+        QStringLiteral("Palette index depth for per-LED colors: 4 (16 colors) or 8 (256 colors)."), QStringLiteral("bits"));
+
+    parser.addOptions({kioskOption, configOption, textOption, colorOption, backgroundOption,
+                       scrollOption, speedOption, transitionOption, transitionMsOption,
+                       afterglowOption, ledStyleOption, clockOption, clockSecondsOption, clock12hOption,
+                       fullscreenOption, framebufferOption, framebufferSizeOption, budgetOption, strictStartupOption,
+                       wakeupsOption, latencyOption, powerOption, ledCurrentOption, powerLimitOption,
+                       gammaOption, brightnessOption, bitPlanesOption, pwmRefreshOption, renderThreadOption,
+                       frameBudgetOption, tickerStdinOption, spriteCacheOption, imageOption, imageDitherOption, videoOption, videoSizeOption, sharedFrameOption,
+                       streamPortOption, traceOption, matrixSizeOption, paletteBitsOption});
+
+    if (!parser.parse(arguments)) {
+        *errorMessage = parser.errorText();
+        return false;
+    }
+    if (parser.isSet(QStringLiteral("help"))) {
+        parser.showHelp();
+    }
+
+    // Le fichier est lu en premier : la ligne de commande a toujours le dernier mot
+    if (parser.isSet(configOption)) {
+        if (!loadFile(parser.value(configOption), errorMessage))
+            return false;
+        enabled = true;
+    }
+
+    if (parser.isSet(textOption))
+        text = parser.value(textOption);
+    if (parser.isSet(colorOption)
+        && !parseColor(parser.value(colorOption), &pixelColor, QStringLiteral("pixel"), errorMessage))
+        return false;
+    if (parser.isSet(backgroundOption)
+        && !parseColor(parser.value(backgroundOption), &backgroundColor, QStringLiteral("background"), errorMessage))
+        return false;
+    if (parser.isSet(scrollOption) && !parseScrollPolicy(parser.value(scrollOption), &scroll)) {
+        *errorMessage = QStringLiteral("Invalid scroll mode: %1").arg(parser.value(scrollOption));
+        return false;
+    }
+    if (parser.isSet(speedOption) && !parseSpeed(parser.value(speedOption), &speed, errorMessage))
+        return false;
+    if (parser.isSet(transitionOption) && !parseTransition(parser.value(transitionOption), &transition)) {
+        *errorMessage = QStringLiteral("Invalid transition: %1").arg(parser.value(transitionOption));
+        return false;
+    }
+    if (parser.isSet(transitionMsOption) && !parseDuration(parser.value(transitionMsOption), &transitionMs)) {
+        *errorMessage = QStringLiteral("Invalid transition duration: %1").arg(parser.value(transitionMsOption));
+        return false;
+    }
+    if (parser.isSet(afterglowOption) && !parseDuration(parser.value(afterglowOption), &afterglowMs)) {
+        *errorMessage = QStringLiteral("Invalid afterglow: %1").arg(parser.value(afterglowOption));
+        return false;
+    }
+    if (parser.isSet(ledStyleOption) && !parseLedStyle(parser.value(ledStyleOption), &ledStyle)) {
+        *errorMessage = QStringLiteral("Invalid LED style: %1").arg(parser.value(ledStyleOption));
+        return false;
+    }
+    if (parser.isSet(clockOption))
+        clock = true;
+    if (parser.isSet(clockSecondsOption))
+        clockSeconds = true;
+    if (parser.isSet(clock12hOption))
+        clock12h = true;
+    if (parser.isSet(fullscreenOption))
+        fullscreen = true;
+    if (parser.isSet(framebufferOption))
+        framebufferPath = parser.value(framebufferOption);
+    if (parser.isSet(framebufferSizeOption) && !parseSize(parser.value(framebufferSizeOption), &framebufferSize)) {
+        *errorMessage = QStringLiteral("Invalid framebuffer size: %1").arg(parser.value(framebufferSizeOption));
+        return false;
+    }
+    if (parser.isSet(budgetOption)) {
+        bool ok = false;
+        startupBudgetMs = parser.value(budgetOption).toInt(&ok);
+        if (!ok || startupBudgetMs <= 0) {
+            *errorMessage = QStringLiteral("Invalid startup budget: %1").arg(parser.value(budgetOption));
+            return false;
+        }
+    }
+    if (parser.isSet(strictStartupOption))
+        strictStartup = true;
+    if (parser.isSet(wakeupsOption))
+        measureWakeups = true;
+    if (parser.isSet(latencyOption))
+        measureLatency = true;
+    if (parser.isSet(powerOption))
+        measurePower = true;
+    if (parser.isSet(ledCurrentOption) && !parseCurrent(parser.value(ledCurrentOption), &ledCurrentMa)) {
+        *errorMessage = QStringLiteral("Invalid LED current: %1").arg(parser.value(ledCurrentOption));
+        return false;
+    }
+    if (parser.isSet(powerLimitOption) && !parseCurrent(parser.value(powerLimitOption), &powerLimitMa)) {
+        *errorMessage = QStringLiteral("Invalid power limit: %1").arg(parser.value(powerLimitOption));
+        return false;
+    }
+    if (parser.isSet(gammaOption) && !parseBoundedReal(parser.value(gammaOption), 0.1, 5.0, &gamma)) {
+        *errorMessage = QStringLiteral("Invalid gamma (expected 0.1 to 5): %1").arg(parser.value(gammaOption));
+        return false;
+    }
+    if (parser.isSet(brightnessOption) && !parseBoundedReal(parser.value(brightnessOption), 0.0, 1.0, &brightness)) {
+        *errorMessage = QStringLiteral("Invalid brightness (expected 0 to 1): %1").arg(parser.value(brightnessOption));
+        return false;
+    }
+    if (parser.isSet(bitPlanesOption) && !parsePlaneBits(parser.value(bitPlanesOption), &bitPlanes)) {
+        *errorMessage = QStringLiteral("Invalid bit-plane depth (expected 0 to 8): %1").arg(parser.value(bitPlanesOption));
+        return false;
+    }
+    if (parser.isSet(pwmRefreshOption) && !parseRefresh(parser.value(pwmRefreshOption), &pwmRefreshHz)) {
+        *errorMessage = QStringLiteral("Invalid PWM refresh rate: %1").arg(parser.value(pwmRefreshOption));
+        return false;
+    }
+    if (parser.isSet(renderThreadOption))
+        renderThread = true;
+    if (parser.isSet(tickerStdinOption))
+        tickerStdin = true;
+    if (parser.isSet(spriteCacheOption)) {
+        bool ok = false;
+        spriteCacheMb = parser.value(spriteCacheOption).toInt(&ok);
+        if (!ok || spriteCacheMb < 0) {
+            *errorMessage = QStringLiteral("Invalid sprite cache size: %1").arg(parser.value(spriteCacheOption));
+            return false;
+        }
+    }
+    if (parser.isSet(imageOption))
+        imagePath = parser.value(imageOption);
+    if (parser.isSet(imageDitherOption) && !LedImage::parseConversion(parser.value(imageDitherOption), &imageConversion)) {
+        *errorMessage = QStringLiteral("Invalid image conversion: %1").arg(parser.value(imageDitherOption));
+        return false;
+    }
+    if (!imagePath.isEmpty() && !checkImage(imagePath, errorMessage))
+        return false;
+    if (parser.isSet(videoOption))
+        videoPath = parser.value(videoOption);
+    if (parser.isSet(videoSizeOption) && !parseSize(parser.value(videoSizeOption), &videoSize)) {
+        *errorMessage = QStringLiteral("Invalid video size: %1").arg(parser.value(videoSizeOption));
+        return false;
+    }
+    if (parser.isSet(sharedFrameOption))
+        sharedFrameKey = parser.value(sharedFrameOption);
+    if (parser.isSet(streamPortOption)) {
+        bool ok = false;
+        streamPort = parser.value(streamPortOption).toInt(&ok);
+        if (!ok || streamPort <= 0 || streamPort > 65535) {
+            *errorMessage = QStringLiteral("Invalid stream port: %1").arg(parser.value(streamPortOption));
+            return false;
+        }
+    }
+    if (parser.isSet(traceOption))
+        tracePath = parser.value(traceOption);
+    if (parser.isSet(frameBudgetOption)) {
+        bool ok = false;
+        frameBudgetMs = parser.value(frameBudgetOption).toDouble(&ok);
+        if (!ok || frameBudgetMs < 0.0) {
+            *errorMessage = QStringLiteral("Invalid frame budget: %1").arg(parser.value(frameBudgetOption));
+            return false;
+        }
+    }
+    if (parser.isSet(matrixSizeOption) && !parseSize(parser.value(matrixSizeOption), &matrixSize)) {
+        *errorMessage = QStringLiteral("Invalid matrix size: %1").arg(parser.value(matrixSizeOption));
+        return false;
+    }
+    if (parser.isSet(paletteBitsOption) && !parsePaletteBits(parser.value(paletteBitsOption), &paletteBits)) {
+        *errorMessage = QStringLiteral("Invalid palette depth (expected 4 or 8): %1").arg(parser.value(paletteBitsOption));
+        return false;
+    }
+
+    if (!tracePath.isEmpty() && !Trace::isAvailable()) {
+        *errorMessage = QStringLiteral("Tracing is not compiled in, reconfigure with -DMATRIX_TRACING=ON to use --trace");
+        return false;
+    }
+
+    if (tickerStdin && videoPath == QStringLiteral("-")) {
+        *errorMessage = QStringLiteral("--ticker-stdin and --video - cannot both read standard input");
+        return false;
+    }
+
+#ifndef Q_OS_UNIX
+    if (tickerStdin) {
+        *errorMessage = QStringLiteral("The standard input ticker is not supported on this platform");
+        return false;
+    }
+    if (!videoPath.isEmpty()) {
+        *errorMessage = QStringLiteral("Video feeds are not supported on this platform");
+        return false;
+    }
+#endif
+
+    if (parser.isSet(kioskOption) || !framebufferPath.isEmpty())
+        enabled = true;
+
+    return true;
+}
+
+KioskSession::KioskSession(const KioskConfig &config, const QElapsedTimer &startupTimer, QObject *parent)
+    : QObject(parent),
+      config(config),
+      startupTimer(startupTimer)
+{
+    qualityLogTimer.setSingleShot(true);
+    qualityLogTimer.setInterval(kQualityLogIntervalMs);
+    connect(&qualityLogTimer, &QTimer::timeout, this, &KioskSession::flushRenderQualityLog);
+}
+
+KioskSession::~KioskSession()
+{
+    delete display;
+    if (framebufferMemory) {
+        framebufferFile.unmap(framebufferMemory);
+    }
+}
+
+bool KioskSession::start(QString *errorMessage)
+{
+    display = new MatrixDisplay();
+    display->setWindowTitle(QStringLiteral("Matrix Display"));
+    connect(display, &MatrixDisplay::framePainted, this, &KioskSession::reportFirstFrame);
+    connect(display, &MatrixDisplay::wakeupRateMeasured, this, &KioskSession::logWakeupRate);
+    connect(display, &MatrixDisplay::renderQualityChanged, this, &KioskSession::logRenderQuality);
+    connect(display, &MatrixDisplay::latencyMeasured, this, &KioskSession::logLatency);
+    connect(display, &MatrixDisplay::powerMeasured, this, &KioskSession::logPower);
+    connect(display, &MatrixDisplay::videoFinished, this, &KioskSession::logVideoFinished);
+    if (!config.sharedFrameKey.isEmpty() && !display->setSharedFrameKey(config.sharedFrameKey, errorMessage))
+        return false;
+    if (config.streamPort > 0 && !display->startFrameStream(static_cast<quint16>(config.streamPort), errorMessage))
+        return false;
+
+#ifdef Q_OS_UNIX
+    if (config.tickerStdin) {
+        tickerNotifier = new QSocketNotifier(STDIN_FILENO, QSocketNotifier::Read, this);
+        connect(tickerNotifier, &QSocketNotifier::activated, this, &KioskSession::readTickerInput);
+    }
+#endif
+
+    if (!config.framebufferPath.isEmpty()) {
+        if (!openFramebuffer(errorMessage))
+            return false;
+
+        // Sans fenêtre, la matrice n'est jamais « visible » : la veille ne doit pas l'arrêter
+        display->setPowerSavingEnabled(false);
+        display->resize(config.framebufferSize);
+        connect(display, &MatrixDisplay::frameChanged, this, &KioskSession::scheduleFramebufferWrite);
+        applyConfig();
+        // Première écriture depuis la boucle d'événements : reportFirstFrame peut alors la terminer
+        scheduleFramebufferWrite();
+        return true;
+    }
+
+    applyConfig();
+    if (config.fullscreen) {
+        display->setCursor(Qt::BlankCursor);
+        display->showFullScreen();
+    } else {
+        display->show();
+    }
+    return true;
+}
+
+void KioskSession::applyConfig()
+{
+    SpriteCache::instance().setByteCap(static_cast<qint64>(config.spriteCacheMb) * 1024 * 1024);
+    if (config.matrixSize.isValid()) {
+        display->setMatrixSize(config.matrixSize.width(), config.matrixSize.height());
+    }
+    display->setPaletteDepth(config.paletteBits);
+    display->setColor_Background(config.backgroundColor);
+    display->setWakeupMonitoringEnabled(config.measureWakeups);
+    display->setLatencyMonitoringEnabled(config.measureLatency);
+    const bool powerBudget = config.measurePower || config.powerLimitMa > 0.0;
+    display->setPowerBudget(powerBudget ? config.ledCurrentMa : 0.0, config.powerLimitMa);
+    display->setIntensityResponse(config.gamma, config.brightness);
+    display->setBitPlaneSimulation(config.bitPlanes, config.pwmRefreshHz);
+    display->setRenderThreadEnabled(config.renderThread);
+    display->setFrameTimeBudget(config.frameBudgetMs);
+    display->setTransitionEffect(config.transition, config.transitionMs);
+    display->setAfterglow(config.afterglowMs);
+    display->setLedStyle(config.ledStyle);
+
+    // La zone principale reprend les réglages globaux de la section [kiosk]
+    KioskZoneConfig primary;
+    primary.area = config.area;
+    primary.text = config.text;
+    primary.pixelColor = config.pixelColor;
+    primary.scroll = config.scroll;
+    primary.speed = config.speed;
+    primary.clock = config.clock;
+    primary.clockSeconds = config.clockSeconds;
+    primary.clock12h = config.clock12h;
+    primary.image = config.imagePath;
+    primary.imageConversion = config.imageConversion;
+    applyZone(display->zone(0), primary);
+    if (config.tickerStdin) {
+        // Le texte configuré ouvre le bandeau, les lignes lues à la suite
+        display->setDisplayMode(MatrixDisplay::Ticker);
+        display->appendText(config.text + kTickerSeparator);
+    }
+    if (!config.videoPath.isEmpty()) {
+        QString error;
+        display->setImageConversion(config.imageConversion);
+        if (!display->openVideo(config.videoPath, config.videoSize, &error))
+            qWarning().noquote() << QStringLiteral("Kiosk: %1").arg(error);
+    }
+
+    for (const KioskZoneConfig &zoneConfig : config.zones) {
+        const int index = display->addZone(zoneConfig.area);
+        if (index < 0) {
+            qWarning().noquote() << QStringLiteral("Kiosk: too many zones, ignoring the remaining ones");
+            break;
+        }
+        applyZone(display->zone(index), zoneConfig);
+    }
+}
+
+void KioskSession::applyZone(MatrixZone *zone, const KioskZoneConfig &zoneConfig)
+{
+    if (zoneConfig.area.isValid()) {
+        zone->setArea(zoneConfig.area);
+    }
+    zone->setColor(zoneConfig.pixelColor);
+    zone->setClockShowSeconds(zoneConfig.clockSeconds);
+    zone->setClockFormat(zoneConfig.clock12h ? MatrixZone::Format12h : MatrixZone::Format24h);
+
+    if (zoneConfig.clock) {
+        zone->setDisplayMode(MatrixZone::Clock);
+        return;
+    }
+
+    if (!zoneConfig.image.isEmpty()) {
+        zone->setImageConversion(zoneConfig.imageConversion);
+        zone->loadImage(zoneConfig.image);
+        return;
+    }
+
+    zone->setText(zoneConfig.text);
+    zone->setScrollMode(zoneConfig.scroll == KioskConfig::ScrollBounce ? MatrixZone::bounceMode
+                                                                      : MatrixZone::defaultMode);
+    bool scrollEnabled = false;
+    switch (zoneConfig.scroll) {
+    case KioskConfig::ScrollAuto:
+        scrollEnabled = zone->requiresScrolling();
+        break;
+    case KioskConfig::ScrollOff:
+        scrollEnabled = false;
+        break;
+    case KioskConfig::ScrollDefault:
+    case KioskConfig::ScrollBounce:
+        scrollEnabled = true;
+        break;
+    }
+    zone->setScrollEnabled(scrollEnabled);
+    zone->setScrollInterval(zoneConfig.speed);
+}
+
+void KioskSession::logWakeupRate(double wakeupsPerMinute)
+{
+    qInfo().noquote() << QStringLiteral("Kiosk: %1 wake-ups/min%2")
+                             .arg(wakeupsPerMinute, 0, 'f', 1)
+                             .arg(display->isSuspended() ? QStringLiteral(" (suspended)") : QString());
+}
+
+void KioskSession::logLatency(const LatencyTracker::Report &report)
+{
+    qInfo().noquote() << QStringLiteral("Kiosk: input-to-photon latency: %1").arg(LatencyTracker::summary(report));
+}
+
+void KioskSession::logPower(const PowerLimiter::Statistics &statistics)
+{
+    qInfo().noquote() << QStringLiteral("Kiosk: estimated LED current: %1").arg(PowerLimiter::summary(statistics));
+}
+
+void KioskSession::logVideoFinished(const QString &errorMessage, const VideoFeed::Statistics &statistics)
+{
+    if (!errorMessage.isEmpty())
+        qWarning().noquote() << QStringLiteral("Kiosk: %1").arg(errorMessage);
+    qInfo().noquote() << QStringLiteral("Kiosk: video feed ended: %1").arg(VideoFeed::summary(statistics));
+}
+
+void KioskSession::logRenderQuality()
+{
+    ++pendingQualityChanges;
+    if (!qualityLogTimer.isActive())
+        flushRenderQualityLog();
+}
+
+void KioskSession::flushRenderQualityLog()
+{
+    if (pendingQualityChanges == 0)
+        return;
+
+    // Une qualité qui oscille ne produit qu'un message par intervalle, avec le nombre de changements
+    const QString grouped = pendingQualityChanges > 1
+        ? QStringLiteral(", %1 changes in %2 s").arg(pendingQualityChanges).arg(kQualityLogIntervalMs / 1000)
+        : QString();
+    qInfo().noquote() << QStringLiteral("Kiosk: render quality %1 (%2 ms per frame, budget %3 ms%4)")
+                             .arg(LedRenderer::qualityName(display->renderQuality()))
+                             .arg(display->lastFrameTime(), 0, 'f', 2)
+                             .arg(display->frameTimeBudget(), 0, 'f', 2)
+                             .arg(grouped);
+    pendingQualityChanges = 0;
+    qualityLogTimer.start();
+}
+
+void KioskSession::readTickerInput()
+{
+#ifdef Q_OS_UNIX
+    // Une seule lecture par notification : l'entrée standard n'est jamais attendue
+    char buffer[4096];
+    const ssize_t count = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+    if (count <= 0) {
+        // Fin de flux : le bandeau termine de défiler ce qu'il a reçu
+        tickerNotifier->setEnabled(false);
+        if (!tickerPending.isEmpty()) {
+            display->appendText(QString::fromUtf8(tickerPending) + kTickerSeparator);
+            tickerPending.clear();
+        }
+        return;
+    }
+
+    tickerPending.append(buffer, static_cast<int>(count));
+    int lineStart = 0;
+    for (int newline = tickerPending.indexOf('\n'); newline >= 0;
+         newline = tickerPending.indexOf('\n', lineStart)) {
+        const QString line = QString::fromUtf8(tickerPending.constData() + lineStart, newline - lineStart).trimmed();
+        if (!line.isEmpty())
+            display->appendText(line + kTickerSeparator);
+        lineStart = newline + 1;
+    }
+    tickerPending.remove(0, lineStart);
+#endif
+}
+
+bool KioskSession::openFramebuffer(QString *errorMessage)
+{
+    const QSize size = config.framebufferSize;
+    frameImage = QImage(size, QImage::Format_RGB32);
+    const qint64 byteCount = frameImage.sizeInBytes();
+
+    framebufferFile.setFileName(config.framebufferPath);
+    if (!framebufferFile.open(QIODevice::ReadWrite)) {
+        *errorMessage = QStringLiteral("Cannot open framebuffer %1: %2")
+                            .arg(config.framebufferPath, framebufferFile.errorString());
+        return false;
+    }
+
+    // Fichier ordinaire : on l'ajuste à la taille d'une image avant de le projeter
+    if (framebufferFile.size() != byteCount) {
+        framebufferFile.resize(byteCount);
+    }
+
+    framebufferMemory = framebufferFile.map(0, byteCount);
+    if (framebufferMemory) {
+        // Rendu direct dans la mémoire projetée, sans copie intermédiaire
+        frameImage = QImage(framebufferMemory, size.width(), size.height(),
+                            size.width() * 4, QImage::Format_RGB32);
+    } else {
+        qWarning().noquote() << QStringLiteral("Framebuffer %1 cannot be mapped, falling back to writes")
+                                    .arg(config.framebufferPath);
+    }
+    return true;
+}
+
+void KioskSession::scheduleFramebufferWrite()
+{
+    if (framebufferWritePending)
+        return;
+
+    framebufferWritePending = true;
+    QTimer::singleShot(0, this, &KioskSession::writeFramebuffer);
+}
+
+void KioskSession::writeFramebuffer()
+{
+    framebufferWritePending = false;
+    display->render(&frameImage);
+
+    if (!framebufferMemory) {
+        framebufferFile.seek(0);
+        framebufferFile.write(reinterpret_cast<const char *>(frameImage.constBits()), frameImage.sizeInBytes());
+        framebufferFile.flush();
+    }
+}
+
+void KioskSession::reportFirstFrame()
+{
+    if (firstFrameReported)
+        return;
+
+    firstFrameReported = true;
+    const qint64 elapsedMs = startupTimer.elapsed();
+    if (elapsedMs > config.startupBudgetMs && config.strictStartup) {
+        qCritical().noquote() << QStringLiteral("Kiosk: first frame after %1 ms, over the %2 ms budget")
+                                     .arg(elapsedMs).arg(config.startupBudgetMs);
+        QCoreApplication::exit(StartupBudgetExitCode);
+    } else if (elapsedMs > config.startupBudgetMs) {
+        qWarning().noquote() << QStringLiteral("Kiosk: first frame after %1 ms, over the %2 ms budget")
+                                    .arg(elapsedMs).arg(config.startupBudgetMs);
+    } else {
+        qInfo().noquote() << QStringLiteral("Kiosk: first frame after %1 ms (budget %2 ms)")
+                                 .arg(elapsedMs).arg(config.startupBudgetMs);
+    }
+}
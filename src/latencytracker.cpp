@@ -0,0 +1,214 @@
+/**
+ * @file latencytracker.cpp
+ * @author G. Maxime
+ * @brief Implémentation de la mesure du délai entre un changement de contenu et son affichage.
+ */
+
+// Inclusion de mes headers
+#include "headers/latencytracker.h"
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <chrono>
+
+qint64 LatencyTracker::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+QString LatencyTracker::sourceName(Source source)
+{
+    switch (source) {
+    case TextChange:
+        return QStringLiteral("text");
+    case ModeChange:
+        return QStringLiteral("mode");
+    case Resize:
+        return QStringLiteral("resize");
+    case PostedChange:
+        return QStringLiteral("posted");
+    case SourceCount:
+        break;
+    }
+    return QString();
+}
+
+void LatencyTracker::setEnabled(bool enabled)
+{
+    if (this->enabled == enabled)
+        return;
+
+    this->enabled = enabled;
+    pendingCount = 0;
+}
+
+void LatencyTracker::markInput(Source source, qint64 inputNs)
+{
+    if (!enabled)
+        return;
+    if (pendingCount == MaxPending) {
+        ++droppedCount;
+        return;
+    }
+    PendingChange &change = pending[pendingCount++];
+    change.source = source;
+    change.inputNs = inputNs;
+    change.layoutNs = -1;
+    change.rasterNs = -1;
+    change.sequence = 0;
+}
+
+void LatencyTracker::markLayout()
+{
+    if (!enabled || pendingCount == 0)
+        return;
+    const qint64 now = nowNs();
+    for (int index = 0; index < pendingCount; ++index) {
+        if (pending[index].layoutNs < 0)
+            pending[index].layoutNs = now;
+    }
+}
+
+void LatencyTracker::markRasterized(quint64 sequence)
+{
+    if (!enabled || pendingCount == 0)
+        return;
+    const qint64 now = nowNs();
+    for (int index = 0; index < pendingCount; ++index) {
+        PendingChange &change = pending[index];
+        if (change.rasterNs >= 0)
+            continue;
+        // Changement sans invalidation (valeur identique) : mise en page confondue avec la rastérisation
+        if (change.layoutNs < 0)
+            change.layoutNs = now;
+        change.rasterNs = now;
+        change.sequence = sequence;
+    }
+}
+
+void LatencyTracker::markPresented(quint64 sequence)
+{
+    if (!enabled || pendingCount == 0)
+        return;
+    const qint64 now = nowNs();
+    int kept = 0;
+    for (int index = 0; index < pendingCount; ++index) {
+        const PendingChange &change = pending[index];
+        if (change.rasterNs < 0 || change.sequence > sequence) {
+            pending[kept++] = change;
+            continue;
+        }
+        const qint64 totalUs = (now - change.inputNs) / 1000;
+        sourceTotals[change.source].add(totalUs);
+        total.add(totalUs);
+        layoutStage.add((change.layoutNs - change.inputNs) / 1000);
+        rasterStage.add((change.rasterNs - change.layoutNs) / 1000);
+        presentStage.add((now - change.rasterNs) / 1000);
+    }
+    pendingCount = kept;
+}
+
+LatencyTracker::Report LatencyTracker::report() const
+{
+    Report result;
+    for (int source = 0; source < SourceCount; ++source) {
+        result.sources[source] = sourceTotals[source].distribution();
+    }
+    result.total = total.distribution();
+    result.layout = layoutStage.distribution();
+    result.raster = rasterStage.distribution();
+    result.present = presentStage.distribution();
+    result.dropped = droppedCount;
+    return result;
+}
+
+void LatencyTracker::reset()
+{
+    pendingCount = 0;
+    droppedCount = 0;
+    for (Histogram &histogram : sourceTotals) {
+        histogram.clear();
+    }
+    total.clear();
+    layoutStage.clear();
+    rasterStage.clear();
+    presentStage.clear();
+}
+
+QString LatencyTracker::summary(const Report &report)
+{
+    const auto describe = [](const Distribution &distribution) {
+        return QStringLiteral("p50 %1 us, p99 %2 us, max %3 us")
+            .arg(distribution.p50Us).arg(distribution.p99Us).arg(distribution.maxUs);
+    };
+    QString line = QStringLiteral("%1 changes, %2").arg(report.total.count).arg(describe(report.total));
+    line += QStringLiteral(" (layout p50 %1 us, raster p50 %2 us, present p50 %3 us)")
+                .arg(report.layout.p50Us).arg(report.raster.p50Us).arg(report.present.p50Us);
+    if (report.dropped > 0)
+        line += QStringLiteral(", %1 untracked").arg(report.dropped);
+    return line;
+}
+
+void LatencyTracker::Histogram::add(qint64 valueUs)
+{
+    valueUs = std::max<qint64>(0, valueUs);
+    ++counts[static_cast<size_t>(bucketFor(valueUs))];
+    ++count;
+    maxUs = std::max(maxUs, valueUs);
+}
+
+LatencyTracker::Distribution LatencyTracker::Histogram::distribution() const
+{
+    Distribution result;
+    result.count = count;
+    result.p50Us = percentile(50);
+    result.p99Us = percentile(99);
+    result.maxUs = maxUs;
+    return result;
+}
+
+void LatencyTracker::Histogram::clear()
+{
+    counts.fill(0);
+    count = 0;
+    maxUs = 0;
+}
+
+int LatencyTracker::Histogram::bucketFor(qint64 valueUs)
+{
+    if (valueUs < LinearBuckets)
+        return static_cast<int>(valueUs);
+    // Puissance de deux, puis les trois bits suivants
+    int exponent = 63;
+    while (!(static_cast<quint64>(valueUs) >> exponent))
+        --exponent;
+    const int bucket = LinearBuckets + (exponent - 4) * SubBuckets
+                       + static_cast<int>((valueUs >> (exponent - 3)) & (SubBuckets - 1));
+    return std::min(bucket, BucketCount - 1);
+}
+
+qint64 LatencyTracker::Histogram::bucketValue(int bucket)
+{
+    if (bucket < LinearBuckets)
+        return bucket;
+    const int exponent = 4 + (bucket - LinearBuckets) / SubBuckets;
+    const qint64 sub = (bucket - LinearBuckets) % SubBuckets;
+    // Milieu de la classe
+    const qint64 lower = (qint64(1) << exponent) + (sub << (exponent - 3));
+    return lower + (qint64(1) << (exponent - 4));
+}
+
+qint64 LatencyTracker::Histogram::percentile(int percent) const
+{
+    if (count == 0)
+        return 0;
+    const quint64 rank = std::max<quint64>(1, (count * static_cast<quint64>(percent) + 99) / 100);
+    quint64 seen = 0;
+    for (int bucket = 0; bucket < BucketCount; ++bucket) {
+        seen += counts[static_cast<size_t>(bucket)];
+        if (seen >= rank)
+            return std::min(bucketValue(bucket), maxUs);
+    }
+    return maxUs;
+}
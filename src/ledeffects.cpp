@@ -0,0 +1,160 @@
+/**
+ * @file ledeffects.cpp
+ * @author G. Maxime
+ * @brief Implémentation de l'étage d'effets : fondu, balayage et rémanence des LED.
+ */
+
+// Inclusion de mes headers
+#include "headers/ledeffects.h"
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Mélange deux plans : out = (from * (256 - weight) + to * weight) / 256.
+ * @param weight Poids du plan d'arrivée, de 0 à 256.
+ */
+void blendLevels(const quint8 *from, const quint8 *to, quint8 *out, int count, int weight)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weightTo = _mm_set1_epi16(static_cast<short>(weight));
+    const __m128i weightFrom = _mm_set1_epi16(static_cast<short>(256 - weight));
+    for (; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(to + i));
+        const __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), weightFrom),
+                                                        _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), weightTo)), 8);
+        const __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), weightFrom),
+                                                        _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), weightTo)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; ++i)
+        out[i] = static_cast<quint8>((from[i] * (256 - weight) + to[i] * weight) >> 8);
+}
+
+/**
+ * @brief Rémanence : out = max(base, out * factor / 256).
+ * @param factor Facteur de décroissance, de 0 à 255.
+ */
+void decayLevels(const quint8 *base, quint8 *out, int count, int factor)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i scale = _mm_set1_epi16(static_cast<short>(factor));
+    for (; i + 16 <= count; i += 16) {
+        const __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i *>(out + i));
+        const __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(previous, zero), scale), 8);
+        const __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(previous, zero), scale), 8);
+        const __m128i decayed = _mm_packus_epi16(lo, hi);
+        const __m128i target = _mm_loadu_si128(reinterpret_cast<const __m128i *>(base + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_max_epu8(decayed, target));
+    }
+#endif
+    for (; i < count; ++i)
+        out[i] = std::max(base[i], static_cast<quint8>((out[i] * factor) >> 8));
+}
+
+} // namespace
+
+void LedEffects::setTransition(Transition newTransition, int durationMs)
+{
+    transition = newTransition;
+    transitionDurationMs = std::max(1, durationMs);
+    if (transition == NoTransition)
+        transitionActive = false;
+}
+
+void LedEffects::setAfterglow(int decayMs)
+{
+    afterglowMs = std::clamp(decayMs, 0, MaxAfterglowMs);
+    if (afterglowMs == 0)
+        glowing = false;
+}
+
+bool LedEffects::isEnabled() const
+{
+    return transition != NoTransition || afterglowMs > 0;
+}
+
+bool LedEffects::isAnimating() const
+{
+    return transitionActive || glowing;
+}
+
+void LedEffects::setTarget(const LedFrame &target, bool contentChanged, qint64 nowMs)
+{
+    const bool sameSize = outputFrame.sameSize(target) && outputFrame.inkDepth() == target.inkDepth();
+    if (contentChanged && transition != NoTransition && sameSize && lastProcessMs >= 0) {
+        // La transition part de ce qui est réellement affiché (rémanence comprise)
+        fromFrame = outputFrame;
+        transitionActive = true;
+        transitionStartMs = nowMs;
+    }
+
+    targetFrame = target;
+    if (!sameSize) {
+        outputFrame = target;
+        blendFrame.resize(target.cols(), target.rows());
+        transitionActive = false;
+        glowing = false;
+    }
+}
+
+const LedFrame &LedEffects::process(qint64 nowMs)
+{
+    const int count = targetFrame.ledCount();
+    const LedFrame *base = &targetFrame;
+
+    if (transitionActive) {
+        const qint64 elapsed = nowMs - transitionStartMs;
+        if (elapsed >= transitionDurationMs) {
+            transitionActive = false;
+        } else {
+            const int weight = static_cast<int>(std::max<qint64>(0, elapsed) * 256 / transitionDurationMs);
+            if (transition == Crossfade) {
+                blendLevels(fromFrame.data(), targetFrame.data(), blendFrame.data(), count, weight);
+            } else {
+                // Balayage de gauche à droite : nouveau contenu avant la frontière, ancien après
+                const int cols = targetFrame.cols();
+                const int boundary = std::min(cols, (cols * weight) >> 8);
+                for (int row = 0; row < targetFrame.rows(); ++row) {
+                    const size_t offset = static_cast<size_t>(row) * cols;
+                    std::memcpy(blendFrame.data() + offset, targetFrame.data() + offset, boundary);
+                    std::memcpy(blendFrame.data() + offset + boundary, fromFrame.data() + offset + boundary,
+                                cols - boundary);
+                }
+            }
+            base = &blendFrame;
+        }
+    }
+
+    if (afterglowMs > 0 && lastProcessMs >= 0) {
+        const double dt = static_cast<double>(std::max<qint64>(0, nowMs - lastProcessMs));
+        // Plafonné à 255 : chaque image retire au moins un niveau et la rémanence finit toujours,
+        // même quand exp(-dt / afterglowMs) s'arrondit à 1
+        const int factor = std::clamp(static_cast<int>(std::lround(256.0 * std::exp(-dt / afterglowMs))), 0, 255);
+        decayLevels(base->data(), outputFrame.data(), count, factor);
+        glowing = count > 0 && std::memcmp(outputFrame.data(), base->data(), count) != 0;
+    } else {
+        if (count > 0)
+            std::memcpy(outputFrame.data(), base->data(), count);
+        glowing = false;
+    }
+    // Les LED qui s'éteignent gardent leur couleur jusqu'à extinction complète
+    outputFrame.mergeInks(targetFrame);
+
+    lastProcessMs = nowMs;
+    return outputFrame;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file ledframe.cpp
+ * @author G. Maxime
+ * @brief Implémentation du plan d'intensité des LED.
+ */
+
+// Inclusion de mes headers
+#include "headers/ledframe.h"
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <cstring>
+
+LedFrame::LedFrame(int cols, int rows)
+{
+    resize(cols, rows);
+}
+
+void LedFrame::resize(int cols, int rows)
+{
+    columnCount = std::max(0, cols);
+    rowCount = std::max(0, rows);
+    levels.assign(static_cast<size_t>(columnCount) * rowCount, 0);
+    setInkDepth(inkBits);
+}
+
+void LedFrame::clear()
+{
+    std::fill(levels.begin(), levels.end(), quint8(0));
+    std::fill(inks.begin(), inks.end(), quint8(0));
+}
+
+void LedFrame::setInkDepth(int bits)
+{
+    inkBits = (bits >= 8) ? 8 : (bits > 0 ? 4 : 0);
+    const size_t count = static_cast<size_t>(columnCount) * rowCount;
+    inks.assign(inkBits == 8 ? count : (inkBits == 4 ? (count + 1) / 2 : 0), 0);
+}
+
+bool LedFrame::sameSize(const LedFrame &other) const
+{
+    return columnCount == other.columnCount && rowCount == other.rowCount;
+}
+
+void LedFrame::drawColumnMask(int col, int firstRow, quint32 mask, quint8 level, quint8 ink)
+{
+    if (col < 0 || col >= columnCount)
+        return;
+
+    for (int bit = 0; mask != 0; ++bit, mask >>= 1) {
+        const int row = firstRow + bit;
+        if ((mask & 1u) && row >= 0 && row < rowCount) {
+            const int index = row * columnCount + col;
+            levels[index] = level;
+            setInkAt(index, ink);
+        }
+    }
+}
+
+void LedFrame::clearRect(int col, int row, int cols, int rows)
+{
+    const int left = std::max(0, col);
+    const int right = std::min(columnCount, col + cols);
+    const int top = std::max(0, row);
+    const int bottom = std::min(rowCount, row + rows);
+    if (left >= right)
+        return;
+
+    for (int y = top; y < bottom; ++y) {
+        std::memset(levels.data() + static_cast<size_t>(y) * columnCount + left, 0, right - left);
+        if (inkBits == 8) {
+            std::memset(inks.data() + static_cast<size_t>(y) * columnCount + left, 0, right - left);
+        } else if (inkBits == 4) {
+            for (int x = left; x < right; ++x)
+                setInkAt(y * columnCount + x, 0);
+        }
+    }
+}
+
+void LedFrame::copyRect(const LedFrame &source, int sourceCol, int sourceRow, int col, int row, int cols, int rows)
+{
+    // Rognage simultané côté source et côté destination
+    int dx = 0;
+    int dy = 0;
+    dx = std::max({dx, -sourceCol, -col});
+    dy = std::max({dy, -sourceRow, -row});
+    const int width = std::min({cols, source.columnCount - sourceCol, columnCount - col}) - dx;
+    const int height = std::min({rows, source.rowCount - sourceRow, rowCount - row}) - dy;
+    if (width <= 0 || height <= 0)
+        return;
+
+    for (int y = dy; y < dy + height; ++y) {
+        const quint8 *from = source.levels.data()
+                             + static_cast<size_t>(sourceRow + y) * source.columnCount + sourceCol + dx;
+        quint8 *to = levels.data() + static_cast<size_t>(row + y) * columnCount + col + dx;
+        std::memcpy(to, from, width);
+
+        // Encres : copie directe en 8 bits, LED par LED en 4 bits (demi-octets non alignés)
+        if (inkBits == 0)
+            continue;
+        const int sourceIndex = (sourceRow + y) * source.columnCount + sourceCol + dx;
+        const int index = (row + y) * columnCount + col + dx;
+        if (inkBits == 8 && source.inkBits == 8) {
+            std::memcpy(inks.data() + index, source.inks.data() + sourceIndex, width);
+        } else {
+            for (int x = 0; x < width; ++x)
+                setInkAt(index + x, source.inkAt(sourceIndex + x));
+        }
+    }
+}
+
+void LedFrame::mergeInks(const LedFrame &target)
+{
+    if (inkBits == 0 || !sameSize(target))
+        return;
+
+    if (inkBits == 8 && target.inkBits == 8) {
+        const size_t count = levels.size();
+        for (size_t i = 0; i < count; ++i) {
+            if (target.levels[i])
+                inks[i] = target.inks[i];
+        }
+        return;
+    }
+
+    const int count = ledCount();
+    for (int i = 0; i < count; ++i) {
+        if (target.levels[i])
+            setInkAt(i, target.inkAt(i));
+    }
+}
+
+bool LedFrame::hasLitLed() const
+{
+    return std::any_of(levels.cbegin(), levels.cend(), [](quint8 level) { return level != 0; });
+}
+
+bool LedFrame::operator==(const LedFrame &other) const
+{
+    return sameSize(other)
+           && inkBits == other.inkBits
+           && (levels.empty() || std::memcmp(levels.data(), other.levels.data(), levels.size()) == 0)
+           && (inks.empty() || std::memcmp(inks.data(), other.inks.data(), inks.size()) == 0);
+}
+
+quint64 LedFrame::hash() const
+{
+    quint64 value = 14695981039346656037ULL;
+    const auto mix = [&value](quint8 byte) {
+        value = (value ^ byte) * 1099511628211ULL;
+    };
+    for (int shift = 0; shift < 32; shift += 8) {
+        mix(static_cast<quint8>(columnCount >> shift));
+        mix(static_cast<quint8>(rowCount >> shift));
+    }
+    mix(static_cast<quint8>(inkBits));
+    for (quint8 level : levels) {
+        mix(level);
+    }
+    for (quint8 ink : inks) {
+        mix(ink);
+    }
+    return value;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file ledimage.cpp
+ * @author G. Maxime
+ * @brief Implémentation de la conversion d'images et d'animations en états de LED.
+ */
+
+// Inclusion de mes headers
+#include "headers/ledimage.h"
+#include "headers/trace.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QImageReader>
+#include <QDebug>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief Durée appliquée aux images d'animation sans délai exploitable (comme les navigateurs).
+ */
+constexpr int kDefaultFrameDelayMs = 100;
+
+/**
+ * @brief Délai en dessous duquel une image d'animation reçoit kDefaultFrameDelayMs.
+ */
+constexpr int kMinFrameDelayMs = 10;
+
+/**
+ * @brief Matrice de Bayer 4×4 du tramage ordonné.
+ */
+constexpr int kBayer4[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5}
+};
+
+/**
+ * @brief Poids de la moyenne de surface le long d'un axe.
+ * Les sources de la cible t sont index[begin[t]] à index[begin[t + 1] - 1] ;
+ * une source à cheval sur deux cibles est partagée au prorata de sa couverture.
+ */
+struct AreaWeights {
+    QVector<int> begin;
+    QVector<int> index;
+    QVector<float> weight;
+};
+
+AreaWeights areaWeights(int sourceLength, int targetLength)
+{
+    AreaWeights weights;
+    weights.begin.reserve(targetLength + 1);
+    const double ratio = static_cast<double>(sourceLength) / targetLength;
+    for (int target = 0; target < targetLength; ++target) {
+        weights.begin.append(weights.index.size());
+        const double start = target * ratio;
+        const double end = (target + 1) * ratio;
+        for (int source = static_cast<int>(start); source < end && source < sourceLength; ++source) {
+            const double cover = std::min(end, source + 1.0) - std::max(start, static_cast<double>(source));
+            if (cover > 0.0) {
+                weights.index.append(source);
+                weights.weight.append(static_cast<float>(cover / ratio));
+            }
+        }
+    }
+    weights.begin.append(weights.index.size());
+    return weights;
+}
+
+} // namespace
+
+QString LedImage::conversionName(Conversion conversion)
+{
+    switch (conversion) {
+    case Threshold:
+        return QStringLiteral("threshold");
+    case OrderedDither:
+        return QStringLiteral("ordered");
+    case ColorDither:
+        return QStringLiteral("color");
+    }
+    return QString();
+}
+
+bool LedImage::parseConversion(const QString &value, Conversion *conversion)
+{
+    const QString key = value.trimmed().toLower();
+    if (key == QStringLiteral("threshold")) {
+        *conversion = Threshold;
+    } else if (key == QStringLiteral("ordered")) {
+        *conversion = OrderedDither;
+    } else if (key == QStringLiteral("color")) {
+        *conversion = ColorDither;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+QRgb LedImage::codeColor(quint8 code)
+{
+    return qRgb((code & 4) ? 255 : 0, (code & 2) ? 255 : 0, (code & 1) ? 255 : 0);
+}
+
+QRect LedImage::fitRect(const QSize &source, const QSize &leds)
+{
+    if (source.isEmpty() || leds.isEmpty())
+        return QRect();
+
+    // Proportions conservées : chaque LED est une cellule carrée, l'image est centrée dans la zone
+    const double scale = std::min(static_cast<double>(leds.width()) / source.width(),
+                                  static_cast<double>(leds.height()) / source.height());
+    const int cols = std::clamp(static_cast<int>(std::lround(source.width() * scale)), 1, leds.width());
+    const int rows = std::clamp(static_cast<int>(std::lround(source.height() * scale)), 1, leds.height());
+    return QRect((leds.width() - cols) / 2, (leds.height() - rows) / 2, cols, rows);
+}
+
+quint8 LedImage::quantize(float red, float green, float blue, int col, int row, Conversion conversion)
+{
+    // Seuil du tramage calé sur la position de la LED dans la zone
+    float threshold = 127.5f;
+    if (conversion != Threshold)
+        threshold = (kBayer4[row & 3][col & 3] + 0.5f) * (255.0f / 16.0f);
+
+    if (conversion == ColorDither) {
+        return static_cast<quint8>((red > threshold ? 4 : 0) | (green > threshold ? 2 : 0)
+                                   | (blue > threshold ? 1 : 0));
+    }
+    const float luminance = 0.299f * red + 0.587f * green + 0.114f * blue;
+    return luminance > threshold ? ZoneColorCode : 0;
+}
+
+bool LedImage::readFrames(const QString &path, QVector<QImage> *frames, QVector<int> *delaysMs,
+                          QString *errorMessage)
+{
+    frames->clear();
+    delaysMs->clear();
+
+    QImageReader reader(path);
+    while (frames->size() < MaxFrames && reader.canRead()) {
+        const QImage image = reader.read();
+        if (image.isNull())
+            break;
+        frames->append(image);
+        // Délai nul ou quasi nul : durée par défaut, comme les navigateurs
+        const int delay = reader.nextImageDelay();
+        delaysMs->append(delay <= kMinFrameDelayMs ? kDefaultFrameDelayMs : delay);
+    }
+
+    if (frames->isEmpty()) {
+        *errorMessage = QStringLiteral("Cannot read image %1: %2").arg(path, reader.errorString());
+        return false;
+    }
+    if (frames->size() == MaxFrames && reader.canRead()) {
+        qWarning().noquote() << QStringLiteral("LedImage: %1 has more than %2 frames, the animation is truncated")
+                                    .arg(path).arg(MaxFrames);
+    }
+    return true;
+}
+
+LedImage LedImage::convert(const QVector<QImage> &frames, const QVector<int> &delaysMs,
+                           const QSize &size, Conversion conversion)
+{
+    MATRIX_TRACE_SCOPE("LedImage::convert");
+
+    LedImage image;
+    image.ledSize = size;
+    if (size.isEmpty())
+        return image;
+
+    const int count = std::min<int>(frames.size(), MaxFrames);
+    image.frames.reserve(count);
+    qint64 endMs = 0;
+    for (int index = 0; index < count; ++index) {
+        image.frames.append(convertFrame(frames.at(index), size, conversion));
+        if (count > 1) {
+            const int delayMs = std::max(1, index < delaysMs.size() ? delaysMs.at(index) : kDefaultFrameDelayMs);
+            endMs += delayMs;
+            image.frameEndsMs.append(endMs);
+            image.shortestMs = index == 0 ? delayMs : std::min(image.shortestMs, delayMs);
+        }
+    }
+    return image;
+}
+
+QByteArray LedImage::convertFrame(const QImage &source, const QSize &size, Conversion conversion)
+{
+    const int cols = size.width();
+    const int rows = size.height();
+    QByteArray codes(cols * rows, '\0');
+    if (source.isNull())
+        return codes;
+
+    // Prémultiplié : une zone transparente compte comme des LED éteintes, sans déteindre sur ses voisines
+    const QImage pixels = source.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    const QRect target = fitRect(pixels.size(), size);
+    const int targetCols = target.width();
+    const int targetRows = target.height();
+    const int originCol = target.x();
+    const int originRow = target.y();
+
+    // Moyenne de surface séparable : réduction des lignes, puis des colonnes
+    const AreaWeights horizontal = areaWeights(pixels.width(), targetCols);
+    const AreaWeights vertical = areaWeights(pixels.height(), targetRows);
+
+    QVector<float> reducedRows;
+    reducedRows.fill(0.0f, pixels.height() * targetCols * 3);
+    for (int y = 0; y < pixels.height(); ++y) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(pixels.constScanLine(y));
+        float *out = reducedRows.data() + y * targetCols * 3;
+        for (int col = 0; col < targetCols; ++col) {
+            float red = 0.0f;
+            float green = 0.0f;
+            float blue = 0.0f;
+            for (int k = horizontal.begin[col]; k < horizontal.begin[col + 1]; ++k) {
+                const QRgb pixel = line[horizontal.index[k]];
+                const float weight = horizontal.weight[k];
+                red += qRed(pixel) * weight;
+                green += qGreen(pixel) * weight;
+                blue += qBlue(pixel) * weight;
+            }
+            out[col * 3] = red;
+            out[col * 3 + 1] = green;
+            out[col * 3 + 2] = blue;
+        }
+    }
+
+    for (int row = 0; row < targetRows; ++row) {
+        const int ledRow = originRow + row;
+        for (int col = 0; col < targetCols; ++col) {
+            float red = 0.0f;
+            float green = 0.0f;
+            float blue = 0.0f;
+            for (int k = vertical.begin[row]; k < vertical.begin[row + 1]; ++k) {
+                const float *in = reducedRows.constData() + (vertical.index[k] * targetCols + col) * 3;
+                const float weight = vertical.weight[k];
+                red += in[0] * weight;
+                green += in[1] * weight;
+                blue += in[2] * weight;
+            }
+
+            const int ledCol = originCol + col;
+            const quint8 code = quantize(red, green, blue, ledCol, ledRow, conversion);
+            codes[ledRow * cols + ledCol] = static_cast<char>(code);
+        }
+    }
+    return codes;
+}
+
+int LedImage::frameAt(qint64 elapsedMs) const
+{
+    if (frameEndsMs.isEmpty())
+        return 0;
+
+    // Recherche dichotomique dans le cycle : constante quelle que soit la durée de lecture
+    const qint64 cycleMs = frameEndsMs.last();
+    const qint64 phase = ((elapsedMs % cycleMs) + cycleMs) % cycleMs;
+    const auto it = std::upper_bound(frameEndsMs.cbegin(), frameEndsMs.cend(), phase);
+    return static_cast<int>(it - frameEndsMs.cbegin());
+}
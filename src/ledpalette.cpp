@@ -0,0 +1,87 @@
+/**
+ * @file ledpalette.cpp
+ * @author G. Maxime
+ * @brief Implémentation de la palette indexée des LED.
+ */
+
+// Inclusion de mes headers
+#include "headers/ledpalette.h"
+
+// Inclusion des headers standard nécessaires
+#include <limits>
+
+LedPalette::LedPalette(int bits)
+{
+    setDepth(bits);
+}
+
+int LedPalette::depth() const
+{
+    return bits;
+}
+
+void LedPalette::setDepth(int newBits)
+{
+    bits = (newBits >= 8) ? 8 : 4;
+    clear();
+}
+
+int LedPalette::capacity() const
+{
+    return 1 << bits;
+}
+
+int LedPalette::size() const
+{
+    return entries.size();
+}
+
+QRgb LedPalette::color(int index) const
+{
+    if (index < 0 || index >= entries.size())
+        return qRgb(0, 0, 0);
+    return entries[index];
+}
+
+quint8 LedPalette::entryFor(QRgb color)
+{
+    color |= 0xFF000000u;
+    const auto found = lookup.constFind(color);
+    if (found != lookup.constEnd())
+        return found.value();
+
+    if (entries.size() < capacity()) {
+        const quint8 index = static_cast<quint8>(entries.size());
+        entries.append(color);
+        lookup.insert(color, index);
+        return index;
+    }
+
+    // Palette pleine : couleur la plus proche (distance euclidienne RVB)
+    overflowed = true;
+    int best = 0;
+    int bestDistance = std::numeric_limits<int>::max();
+    for (int i = 0; i < entries.size(); ++i) {
+        const int dr = qRed(entries[i]) - qRed(color);
+        const int dg = qGreen(entries[i]) - qGreen(color);
+        const int db = qBlue(entries[i]) - qBlue(color);
+        const int distance = dr * dr + dg * dg + db * db;
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = i;
+        }
+    }
+    return static_cast<quint8>(best);
+}
+
+void LedPalette::clear()
+{
+    entries.clear();
+    lookup.clear();
+    overflowed = false;
+}
+
+bool LedPalette::hasOverflowed() const
+{
+    return overflowed;
+}
@@ -0,0 +1,291 @@
+/**
+ * @file ledrenderer.cpp
+ * @author G. Maxime
+ * @brief Implémentation du dessin des LED de la matrice.
+ */
+
+// Inclusion de mes headers
+#include "headers/ledrenderer.h"
+#include "headers/trace.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QPainter>
+#include <QPaintDevice>
+#include <QColor>
+
+// Inclusion des headers standard nécessaires
+#include <cmath>
+
+/**
+ * @brief Nombre de niveaux d'intensité distincts au dessin.
+ */
+static constexpr int kIntensityBuckets = LedRenderer::IntensityBuckets;
+
+/**
+ * @brief Diamètre du halo, en cellules.
+ */
+static constexpr float kHaloCells = 2.5f;
+
+/**
+ * @brief Écart type du halo gaussien, en cellules.
+ */
+static constexpr float kHaloSigmaCells = 0.45f;
+
+/**
+ * @brief Opacité du halo au centre d'une LED à pleine intensité.
+ */
+static constexpr float kHaloStrength = 0.45f;
+
+QString LedRenderer::qualityName(Quality quality)
+{
+    switch (quality) {
+    case HighQuality:
+        return QStringLiteral("high");
+    case NoAntialiasing:
+        return QStringLiteral("no-antialiasing");
+    case SquareLeds:
+        return QStringLiteral("square-leds");
+    case LitLedsOnly:
+        return QStringLiteral("lit-leds-only");
+    }
+    return QString();
+}
+
+QString LedRenderer::styleName(Style style)
+{
+    switch (style) {
+    case DotStyle:
+        return QStringLiteral("dot");
+    case GlowStyle:
+        return QStringLiteral("glow");
+    }
+    return QString();
+}
+
+void LedRenderer::paint(QPainter &painter, const LedFrame &frame, const LedPalette &palette,
+                        const QRectF &matrixRect, float cellSize, Quality quality, Style style)
+{
+    // Ni save()/restore() ni clip : les LED tiennent dans matrixRect et l'état du peintre n'est pas réalloué
+    painter.setRenderHint(QPainter::Antialiasing, quality == HighQuality);
+    painter.setPen(Qt::NoPen);
+
+    paintGrid(painter, frame.cols(), frame.rows(), matrixRect, cellSize, quality);
+    paintLitLeds(painter, frame, palette, matrixRect, cellSize, quality <= NoAntialiasing);
+    if (style == GlowStyle && quality == HighQuality)
+        paintGlow(painter, palette, cellSize);
+}
+
+void LedRenderer::paintGrid(QPainter &painter, int cols, int rows, const QRectF &matrixRect,
+                            float cellSize, Quality quality)
+{
+    MATRIX_TRACE_SCOPE("LedRenderer::grid");
+
+    // Grille des LED éteintes : omise au niveau le plus bas, les LED allumées restent lisibles sur le fond
+    if (quality <= NoAntialiasing) {
+        paintRoundGrid(painter, cols, rows, matrixRect, cellSize, quality == HighQuality);
+        return;
+    }
+    if (quality == LitLedsOnly)
+        return;
+
+    const float pixelDiameter = cellSize * 0.8f;
+    const float pixelOffset = (cellSize - pixelDiameter) / 2.0f;
+    const float xBase = static_cast<float>(matrixRect.x());
+    const float yOffset = static_cast<float>(matrixRect.y());
+    painter.setBrush(gridBrush);
+    for (int row = 0; row < rows; ++row) {
+        const float y = yOffset + row * cellSize + pixelOffset;
+        gridRow.clear();
+        for (int col = 0; col < cols; ++col) {
+            const float x = xBase + col * cellSize + pixelOffset;
+            gridRow.append(QRectF(x, y, pixelDiameter, pixelDiameter));
+        }
+        painter.drawRects(gridRow.constData(), gridRow.size());
+    }
+}
+
+void LedRenderer::paintLitLeds(QPainter &painter, const LedFrame &frame, const LedPalette &palette,
+                               const QRectF &matrixRect, float cellSize, bool roundLeds)
+{
+    MATRIX_TRACE_SCOPE("LedRenderer::glyphs");
+
+    const float pixelDiameter = cellSize * 0.8f;
+    const float pixelOffset = (cellSize - pixelDiameter) / 2.0f;
+    const int matrixCols = frame.cols();
+    const int matrixRows = frame.rows();
+    const float xBase = static_cast<float>(matrixRect.x());
+    const float yOffset = static_cast<float>(matrixRect.y());
+
+    const int bucketCount = palette.capacity() * kIntensityBuckets;
+    if (levelBuckets.size() != bucketCount) {
+        levelBuckets.resize(bucketCount);
+        bucketBrushes.fill(QBrush(), bucketCount);
+        bucketBrushInks.fill(0, bucketCount);
+    }
+    for (int bucket : usedBuckets) {
+        levelBuckets[bucket].clear();
+    }
+    usedBuckets.clear();
+
+    const quint8 *levels = frame.data();
+    for (int row = 0; row < matrixRows; ++row) {
+        const float y = yOffset + row * cellSize + pixelOffset;
+        for (int col = 0; col < matrixCols; ++col) {
+            const int index = row * matrixCols + col;
+            const quint8 level = levels[index];
+            if (!level)
+                continue;
+            const int bucket = frame.inkAt(index) * kIntensityBuckets + level * kIntensityBuckets / 256;
+            QVector<QRectF> &rects = levelBuckets[bucket];
+            if (rects.isEmpty())
+                usedBuckets.append(bucket);
+            const float x = xBase + col * cellSize + pixelOffset;
+            rects.append(QRectF(x, y, pixelDiameter, pixelDiameter));
+        }
+    }
+
+    for (int bucket : usedBuckets) {
+        const QRgb ink = palette.color(bucket / kIntensityBuckets);
+        QBrush &brush = bucketBrushes[bucket];
+        if (brush.style() == Qt::NoBrush || bucketBrushInks[bucket] != ink) {
+            // Niveau maximal : couleur exacte ; sinon mélange vers le noir des LED éteintes
+            const int level = (bucket % kIntensityBuckets + 1) * 256 / kIntensityBuckets - 1;
+            brush = QBrush(QColor(qRed(ink) * level / 255,
+                                  qGreen(ink) * level / 255,
+                                  qBlue(ink) * level / 255));
+            bucketBrushInks[bucket] = ink;
+        }
+        painter.setBrush(brush);
+        const QVector<QRectF> &leds = levelBuckets[bucket];
+        if (roundLeds) {
+            for (const QRectF &led : leds) {
+                painter.drawEllipse(led);
+            }
+        } else {
+            painter.drawRects(leds.constData(), leds.size());
+        }
+    }
+}
+
+void LedRenderer::paintGlow(QPainter &painter, const LedPalette &palette, float cellSize)
+{
+    MATRIX_TRACE_SCOPE("LedRenderer::glow");
+
+    // Halos calculés pour une taille de cellule en pixels physiques : recalculés si elle change
+    const qreal devicePixelRatio = painter.device() ? painter.device()->devicePixelRatio() : 1.0;
+    const float cellPixels = static_cast<float>(cellSize * devicePixelRatio);
+    if (cellPixels != haloCellPixels || devicePixelRatio != haloDevicePixelRatio
+        || bucketHalos.size() != levelBuckets.size()) {
+        bucketHalos.fill(QSharedPointer<const QImage>(), levelBuckets.size());
+        bucketHaloInks.fill(0, levelBuckets.size());
+        haloCellPixels = cellPixels;
+        haloDevicePixelRatio = devicePixelRatio;
+    }
+
+    // Une seule passe additive : les halos voisins se cumulent comme la lumière
+    painter.setCompositionMode(QPainter::CompositionMode_Plus);
+    for (int bucket : usedBuckets) {
+        const QImage &halo = haloSprite(bucket, palette.color(bucket / kIntensityBuckets));
+        const qreal haloSize = halo.width() / devicePixelRatio;
+        for (const QRectF &led : levelBuckets[bucket]) {
+            const QPointF center = led.center();
+            painter.drawImage(QPointF(center.x() - haloSize / 2.0, center.y() - haloSize / 2.0), halo);
+        }
+    }
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+}
+
+const QImage &LedRenderer::haloSprite(int bucket, QRgb ink)
+{
+    QSharedPointer<const QImage> &halo = bucketHalos[bucket];
+    if (halo && bucketHaloInks[bucket] == ink)
+        return *halo;
+
+    const int level = (bucket % kIntensityBuckets + 1) * 256 / kIntensityBuckets - 1;
+    SpriteKey key;
+    key.kind = SpriteKey::LedHalo;
+    key.cellSize64 = qRound(haloCellPixels * 64.0f);
+    key.devicePixelRatio1000 = qRound(haloDevicePixelRatio * 1000.0);
+    key.color = ink;
+    key.variant = level;
+
+    const float cellPixels = haloCellPixels;
+    const qreal devicePixelRatio = haloDevicePixelRatio;
+    halo = SpriteCache::instance().obtain(key, [cellPixels, devicePixelRatio, level, ink] {
+        const int side = std::max(1, static_cast<int>(std::ceil(cellPixels * kHaloCells)));
+        const float center = side / 2.0f;
+        const float sigma = std::max(0.5f, cellPixels * kHaloSigmaCells);
+        const float peak = kHaloStrength * level / 255.0f;
+
+        // Flou gaussien calculé une fois par groupe, en couleur prémultipliée pour l'ajout
+        QImage image(side, side, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(devicePixelRatio);
+        for (int y = 0; y < side; ++y) {
+            QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+            const float dy = y + 0.5f - center;
+            for (int x = 0; x < side; ++x) {
+                const float dx = x + 0.5f - center;
+                const float alpha = peak * std::exp(-(dx * dx + dy * dy) / (2.0f * sigma * sigma));
+                line[x] = qRgba(static_cast<int>(qRed(ink) * alpha), static_cast<int>(qGreen(ink) * alpha),
+                                static_cast<int>(qBlue(ink) * alpha), static_cast<int>(255 * alpha));
+            }
+        }
+        return image;
+    });
+    bucketHaloInks[bucket] = ink;
+    return *halo;
+}
+
+void LedRenderer::paintRoundGrid(QPainter &painter, int cols, int rows, const QRectF &matrixRect,
+                                 float cellSize, bool antialiased)
+{
+    // La couche est posée sur un pixel physique entier ; le reste sous-pixel de l'origine
+    // fait partie de la clé, pour un placement identique au dessin LED par LED
+    const qreal devicePixelRatio = painter.device() ? painter.device()->devicePixelRatio() : 1.0;
+    const qreal originX = matrixRect.x() * devicePixelRatio;
+    const qreal originY = matrixRect.y() * devicePixelRatio;
+    const qreal pixelX = std::floor(originX);
+    const qreal pixelY = std::floor(originY);
+
+    SpriteKey key;
+    key.kind = SpriteKey::LedGrid;
+    key.cellSize64 = qRound(cellSize * devicePixelRatio * 64.0);
+    key.devicePixelRatio1000 = qRound(devicePixelRatio * 1000.0);
+    key.color = gridBrush.color().rgb();
+    key.variant = antialiased ? 1 : 0;
+    key.grid = QSize(cols, rows);
+    key.phase64 = QPoint(qRound((originX - pixelX) * 64.0), qRound((originY - pixelY) * 64.0));
+
+    if (!gridLayer || key != gridLayerKey) {
+        const QBrush brush = gridBrush;
+        gridLayer = SpriteCache::instance().obtain(key, [key, brush] {
+            const qreal ratio = key.devicePixelRatio1000 / 1000.0;
+            const qreal cellPixels = key.cellSize64 / 64.0;
+            const QSize pixelSize(static_cast<int>(std::ceil(key.grid.width() * cellPixels)) + 1,
+                                  static_cast<int>(std::ceil(key.grid.height() * cellPixels)) + 1);
+            QImage image(pixelSize, QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::transparent);
+
+            // Même géométrie que les LED allumées, exprimée en pixels physiques
+            const qreal diameter = cellPixels * 0.8;
+            const qreal offset = (cellPixels - diameter) / 2.0;
+            const qreal phaseX = key.phase64.x() / 64.0;
+            const qreal phaseY = key.phase64.y() / 64.0;
+            QPainter layerPainter(&image);
+            layerPainter.setRenderHint(QPainter::Antialiasing, key.variant != 0);
+            layerPainter.setPen(Qt::NoPen);
+            layerPainter.setBrush(brush);
+            for (int row = 0; row < key.grid.height(); ++row) {
+                for (int col = 0; col < key.grid.width(); ++col) {
+                    layerPainter.drawEllipse(QRectF(phaseX + col * cellPixels + offset,
+                                                    phaseY + row * cellPixels + offset, diameter, diameter));
+                }
+            }
+            layerPainter.end();
+            image.setDevicePixelRatio(ratio);
+            return image;
+        });
+        gridLayerKey = key;
+    }
+    painter.drawImage(QPointF(pixelX / devicePixelRatio, pixelY / devicePixelRatio), *gridLayer);
+}
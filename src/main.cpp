@@ -4,11 +4,18 @@
  * @date 2025-10-17
 */
 
-// Inclusion de mon headers
+// Inclusion de mes headers
 #include "headers/mainwindow.h"
+#include "headers/kiosk.h"
+#include "headers/trace.h"
+#ifdef MATRIX_QUICK
+#include "headers/matrixquickitem.h"
+#endif
 
-// Inclusion du header Qt nécessaire
+// Inclusion des headers Qt nécessaires
 #include <QApplication>
+#include <QElapsedTimer>
+#include <QDebug>
 
 /**
  * @brief Fonction principale de l'application
@@ -18,8 +25,52 @@
  */
 int main(int argc, char *argv[])
 {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
+    // Sortie framebuffer sans écran : plateforme offscreen, sauf si l'utilisateur en impose une
+    if (KioskConfig::requestsFramebuffer(argc, argv) && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     QApplication a(argc, argv);
-    MainWindow w;
-    w.show();
-    return a.exec();
-}
\ No newline at end of file
+
+#ifdef MATRIX_QUICK
+    // Type LedMatrix disponible pour les scènes QML chargées par l'application
+    MatrixQuickItem::registerQmlType();
+#endif
+
+    KioskConfig config;
+    QString errorMessage;
+    if (!config.parse(a.arguments(), &errorMessage)) {
+        qCritical().noquote() << errorMessage;
+        return 1;
+    }
+
+    // Enregistrement démarré avant le premier affichage : la trace couvre aussi la mise en page initiale
+    if (!config.tracePath.isEmpty())
+        Trace::start();
+
+    int exitCode = 0;
+    if (config.enabled) {
+        KioskSession session(config, startupTimer);
+        if (!session.start(&errorMessage)) {
+            qCritical().noquote() << errorMessage;
+            return 1;
+        }
+        exitCode = a.exec();
+    } else {
+        MainWindow w;
+        w.show();
+        exitCode = a.exec();
+    }
+
+    if (!config.tracePath.isEmpty()) {
+        if (!Trace::writeChromeTrace(config.tracePath, &errorMessage)) {
+            qCritical().noquote() << errorMessage;
+            return exitCode ? exitCode : 1;
+        }
+        qInfo().noquote() << QStringLiteral("Trace: written to %1").arg(config.tracePath);
+    }
+    return exitCode;
+}
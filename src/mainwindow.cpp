@@ -22,6 +22,7 @@
 #include <QShortcut>
 #include <QKeySequence>
 #include <QLabel>
+#include <QDebug>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
@@ -54,12 +55,23 @@ MainWindow::MainWindow(QWidget *parent)
     clockCheckBox = new QCheckBox("Show Clock", this);
     controlsLayout->addWidget(clockCheckBox);
 
+    secondsCheckBox = new QCheckBox("Seconds", this);
+    secondsCheckBox->setVisible(false);
+    controlsLayout->addWidget(secondsCheckBox);
+
+    twelveHourCheckBox = new QCheckBox("12h", this);
+    twelveHourCheckBox->setVisible(false);
+    controlsLayout->addWidget(twelveHourCheckBox);
+
     scrollCheckBox = new QCheckBox("Scroll", this);
     controlsLayout->addWidget(scrollCheckBox);
 
     bounceCheckBox = new QCheckBox("Bounce Scroll", this);
     controlsLayout->addWidget(bounceCheckBox);
 
+    glowCheckBox = new QCheckBox("LED Glow", this);
+    controlsLayout->addWidget(glowCheckBox);
+
     speedLabel = new QLabel("Speed:", this);
     controlsLayout->addWidget(speedLabel);
     speedSlider = new QSlider(Qt::Horizontal, this);
@@ -82,6 +94,12 @@ MainWindow::MainWindow(QWidget *parent)
     toggleShortcut->setContext(Qt::ApplicationShortcut);
     connect(toggleShortcut, &QShortcut::activated, this, &MainWindow::toggleControlsVisibility);
 
+    // Ajout du raccourci clavier Ctrl+M pour mesurer les réveils par minute de la matrice
+    auto *wakeupShortcut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+M")), this);
+    wakeupShortcut->setContext(Qt::ApplicationShortcut);
+    connect(wakeupShortcut, &QShortcut::activated, this, &MainWindow::toggleWakeupMonitoring);
+    connect(matrixDisplay, &MatrixDisplay::wakeupRateMeasured, this, &MainWindow::logWakeupRate);
+
     // Connexions des signaux du controllLayout aux slots 
     connect(updateButton, &QPushButton::clicked, this, &MainWindow::updateMatrixText);
     connect(textInput, &QLineEdit::returnPressed, this, &MainWindow::updateMatrixText);
@@ -91,6 +109,17 @@ MainWindow::MainWindow(QWidget *parent)
     connect(scrollCheckBox, &QCheckBox::toggled, matrixDisplay, &MatrixDisplay::setScrollEnabled);
     connect(scrollCheckBox, &QCheckBox::toggled, this, &MainWindow::toggleSpeedControlVisibility);
     connect(scrollCheckBox, &QCheckBox::toggled, this, &MainWindow::toggleBounceCheckboxVisibility);
+    connect(secondsCheckBox, &QCheckBox::toggled, matrixDisplay, &MatrixDisplay::setClockShowSeconds);
+    connect(twelveHourCheckBox, &QCheckBox::toggled, [this](bool checked){
+        if (matrixDisplay) {
+            matrixDisplay->setClockFormat(checked ? MatrixDisplay::Format12h : MatrixDisplay::Format24h);
+        }
+    });
+    connect(glowCheckBox, &QCheckBox::toggled, [this](bool checked){
+        if (matrixDisplay) {
+            matrixDisplay->setLedStyle(checked ? LedRenderer::GlowStyle : LedRenderer::DotStyle);
+        }
+    });
     connect(bounceCheckBox, &QCheckBox::toggled, [this](bool checked){
         if (matrixDisplay) {
             if (checked) {
@@ -145,6 +174,8 @@ void MainWindow::toggleClock(bool checked)
         matrixDisplay->setDisplayMode(MatrixDisplay::Clock);
         textInput->setEnabled(false);
         textInput->setVisible(false);
+        secondsCheckBox->setVisible(true);
+        twelveHourCheckBox->setVisible(true);
 
         this->toggleSpeedControlVisibility();
         this->toggleBounceCheckboxVisibility();
@@ -152,6 +183,8 @@ void MainWindow::toggleClock(bool checked)
     } else {
         scrollCheckBox->setVisible(true);
         textInput->setVisible(true);
+        secondsCheckBox->setVisible(false);
+        twelveHourCheckBox->setVisible(false);
         matrixDisplay->setDisplayMode(MatrixDisplay::Text);
         if (textInput->text().trimmed().isEmpty()) {
             textInput->setText(defaultText);
@@ -188,4 +221,17 @@ void MainWindow::toggleBounceCheckboxVisibility()
         bounceCheckBox->setVisible(true);
     else
         bounceCheckBox->setVisible(false);
+}
+
+void MainWindow::toggleWakeupMonitoring()
+{
+    wakeupMonitoringEnabled = !wakeupMonitoringEnabled;
+    matrixDisplay->setWakeupMonitoringEnabled(wakeupMonitoringEnabled);
+}
+
+void MainWindow::logWakeupRate(double wakeupsPerMinute)
+{
+    qInfo().noquote() << QStringLiteral("MainWindow: %1 wake-ups/min%2")
+                             .arg(wakeupsPerMinute, 0, 'f', 1)
+                             .arg(matrixDisplay->isSuspended() ? QStringLiteral(" (suspended)") : QString());
 }
\ No newline at end of file
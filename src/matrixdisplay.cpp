@@ -11,12 +11,15 @@
  // Inclusion de mes headers
 #include "headers/matrixdisplay.h"
 #include "headers/matrixfont.h"
+#include "headers/trace.h"
 
 // Inclusion des headers Qt nécessaires
 #include <QPainter>
 #include <QPaintEvent>
-#include <QTime>
 #include <QSizePolicy>
+#include <QGuiApplication>
+#include <QWindow>
+#include <QMetaObject>
 
 // Inclusion des headers standard nécessaires
 #include <cmath>
@@ -28,139 +31,210 @@
 static constexpr float kMaxHeightUsage = 0.95f;
 static constexpr float kMinCellSize = 2.0f;
 static constexpr float kMaxCellSize = 36.0f;
-static constexpr int MatrixCols = 100;
-static constexpr int MatrixRows = CHAR_ROWS + 4;
+static constexpr int kDefaultMatrixCols = 100;
+static constexpr int kDefaultMatrixRows = CHAR_ROWS + 4;
 static constexpr float kDefaultCellSize = 12.0f;
-static constexpr int defaultScrollIntervalMs = 50;
+static constexpr int kWakeupReportIntervalMs = 60000;
+static constexpr int kEffectsFrameIntervalMs = 33;
+static constexpr int kMailboxFrameIntervalMs = 16;
+static constexpr int kResizeSettleMs = 150;
 
 MatrixDisplay::MatrixDisplay(QWidget *parent)
-    : QWidget(parent),
-      pixelColor(0, 255, 0),
-      currentMode(Text),
-      scrollOffset(0),
-      scrollEnabled(false)
+    : QWidget(parent)
 {
     setAttribute(Qt::WA_OpaquePaintEvent, true);
     setAutoFillBackground(false);
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
-    const int defaultWidth = static_cast<int>(MatrixCols * kDefaultCellSize);
-    const int defaultHeight = static_cast<int>(MatrixRows * kDefaultCellSize);
+    const int defaultWidth = static_cast<int>(kDefaultMatrixCols * kDefaultCellSize);
+    const int defaultHeight = static_cast<int>(kDefaultMatrixRows * kDefaultCellSize);
     setMinimumSize(defaultWidth / 2, defaultHeight / 2);
     setBaseSize(defaultWidth, defaultHeight);
 
-    timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &MatrixDisplay::onTimeout);
+    // Zones de la matrice : la zone principale couvre toute la grille
+    compositor = new ZoneCompositor(kDefaultMatrixCols, kDefaultMatrixRows, this);
+    connect(compositor, &ZoneCompositor::changed, this, &MatrixDisplay::onZonesChanged);
+    connect(compositor, &ZoneCompositor::timerWokeUp, this, &MatrixDisplay::onTimerWakeup);
+    connect(compositor, &ZoneCompositor::videoFinished, this, &MatrixDisplay::videoFinished);
+
+    // Étage d'effets (30 images/s tant qu'un effet est en cours)
+    effectsTimer = new QTimer(this);
+    effectsTimer->setInterval(kEffectsFrameIntervalMs);
+    connect(effectsTimer, &QTimer::timeout, this, &MatrixDisplay::onEffectsTick);
+
+    // Mesure des réveils : un seul réveil grossier par minute, non comptabilisé
+    wakeupReportTimer = new QTimer(this);
+    wakeupReportTimer->setTimerType(Qt::VeryCoarseTimer);
+    wakeupReportTimer->setInterval(kWakeupReportIntervalMs);
+    connect(wakeupReportTimer, &QTimer::timeout, this, &MatrixDisplay::reportWakeupRate);
+
+    latencyReportTimer = new QTimer(this);
+    latencyReportTimer->setTimerType(Qt::VeryCoarseTimer);
+    latencyReportTimer->setInterval(kWakeupReportIntervalMs);
+    connect(latencyReportTimer, &QTimer::timeout, this, &MatrixDisplay::reportLatency);
+
+    // Relevé du courant estimé, une fois par minute
+    powerReportTimer = new QTimer(this);
+    powerReportTimer->setTimerType(Qt::VeryCoarseTimer);
+    powerReportTimer->setInterval(kWakeupReportIntervalMs);
+    connect(powerReportTimer, &QTimer::timeout, this, &MatrixDisplay::reportPower);
+
+    // Redimensionnement : un rendu complet quand la taille s'est stabilisée
+    resizeSettleTimer = new QTimer(this);
+    resizeSettleTimer->setSingleShot(true);
+    resizeSettleTimer->setInterval(kResizeSettleMs);
+    connect(resizeSettleTimer, &QTimer::timeout, this, &MatrixDisplay::finishResize);
+
+    // Boîte des producteurs : relevée au plus une fois par image
+    mailboxTimer = new QTimer(this);
+    mailboxTimer->setSingleShot(true);
+    connect(mailboxTimer, &QTimer::timeout, this, &MatrixDisplay::drainMailbox);
+
+    connect(qGuiApp, &QGuiApplication::applicationStateChanged, this, &MatrixDisplay::updateSuspendState);
 }
 
 QSize MatrixDisplay::sizeHint() const
 {
     return {
-        static_cast<int>(MatrixCols * kDefaultCellSize),
-        static_cast<int>(MatrixRows * kDefaultCellSize)
+        static_cast<int>(compositor->cols() * kDefaultCellSize),
+        static_cast<int>(compositor->rows() * kDefaultCellSize)
     };
 }
 
-void MatrixDisplay::setScrollMode(ScrollMode mode)
+void MatrixDisplay::setMatrixSize(int cols, int rows)
 {
-    if (scrollMode == mode)
-        return;
+    compositor->setMatrixSize(cols, rows);
+    updateGeometry();
+}
+
+QSize MatrixDisplay::matrixSize() const
+{
+    return QSize(compositor->cols(), compositor->rows());
+}
+
+int MatrixDisplay::addZone(const QRect &area)
+{
+    return compositor->addZone(area);
+}
+
+void MatrixDisplay::setPaletteDepth(int bits)
+{
+    compositor->setPaletteDepth(bits);
+}
+
+int MatrixDisplay::paletteDepth() const
+{
+    return compositor->palette().depth();
+}
+
+void MatrixDisplay::removeZone(int index)
+{
+    compositor->removeZone(index);
+}
+
+int MatrixDisplay::zoneCount() const
+{
+    return compositor->zoneCount();
+}
 
-    scrollMode = mode;
-    scrollOffset = 0.0f;
-    scrollDirection = 1;
-    restartScrollIfNeeded();
-    update();
+MatrixZone *MatrixDisplay::zone(int index) const
+{
+    return compositor->zone(index);
 }
 
+bool MatrixDisplay::openVideo(const QString &path, const QSize &frameSize, QString *errorMessage)
+{
+    return compositor->primaryZone()->openVideo(path, frameSize, errorMessage);
+}
+
+void MatrixDisplay::setScrollMode(ScrollMode mode)
+{
+    compositor->primaryZone()->setScrollMode(mode);
+}
 
 void MatrixDisplay::setText(const QString &text)
 {
-    currentText = text.toUpper();
-    scrollOffset = 0.0f;
-    if (currentMode == Text) {
-        restartScrollIfNeeded();
-    }
-    update();
+    latency.markInput(LatencyTracker::TextChange);
+    compositor->primaryZone()->setText(text);
+}
+
+void MatrixDisplay::appendText(const QString &text)
+{
+    latency.markInput(LatencyTracker::TextChange);
+    compositor->primaryZone()->appendText(text);
+}
+
+void MatrixDisplay::loadImage(const QString &path)
+{
+    compositor->primaryZone()->loadImage(path);
+}
+
+void MatrixDisplay::setImage(const QImage &image)
+{
+    compositor->primaryZone()->setImage(image);
+}
+
+void MatrixDisplay::setImageConversion(LedImage::Conversion conversion)
+{
+    compositor->primaryZone()->setImageConversion(conversion);
 }
 
 void MatrixDisplay::setColor(const QColor &color)
 {
-    pixelColor = color;
-    update();
+    compositor->primaryZone()->setColor(color);
 }
 
 void MatrixDisplay::setColor_Background(const QColor &color)
 {
     backgroundColor = color;
-    update();
+    invalidateFrame();
 }
 
 void MatrixDisplay::setDisplayMode(DisplayMode mode)
 {
-    if (currentMode == mode)
-        return;
-
-    currentMode = mode;
-    timer->stop();
-
-    if (currentMode == Clock) {
-        scrollEnabled = false;
-        scrollOffset = 0.0f;
-        onTimeout();
-        timer->start(1000);
-    } else {
-        restartScrollIfNeeded();
-    }
-    update();
+    latency.markInput(LatencyTracker::ModeChange);
+    compositor->primaryZone()->setDisplayMode(mode);
 }
 
 void MatrixDisplay::setScrollEnabled(bool enabled)
 {
-    bool allowScroll = enabled && currentMode == Text;
-
-    if (scrollEnabled == allowScroll)
-        return;
-
-    scrollEnabled = allowScroll;
-    scrollOffset = 0.0f;
-
-    if (currentMode == Text) {
-        timer->stop();
-        if (scrollEnabled) {
-            restartScrollIfNeeded();
-        }
-    }
-    update();
+    compositor->primaryZone()->setScrollEnabled(enabled);
 }
 
 void MatrixDisplay::setScrollInterval(int interval)
 {
-    if (interval <= 0) {
-        return;
-    }
+    compositor->primaryZone()->setScrollInterval(interval);
+}
 
-    if (timer->isActive()) {
-        timer->stop();
-        scrollIntervalMs = (2.0f/interval * defaultScrollIntervalMs);
-        timer->start(scrollIntervalMs);
-    }
+void MatrixDisplay::setClockShowSeconds(bool enabled)
+{
+    compositor->primaryZone()->setClockShowSeconds(enabled);
 }
 
+void MatrixDisplay::setClockFormat(ClockFormat format)
+{
+    compositor->primaryZone()->setClockFormat(format);
+}
 
 float MatrixDisplay::calculateCellSize() const
 {
-    if (MatrixRows <= 0)
-        return kMinCellSize;
+    return cellSizeFor(size());
+}
+
+float MatrixDisplay::cellSizeFor(const QSize &size) const
+{
+    MATRIX_TRACE_SCOPE("MatrixDisplay::calculateCellSize");
+    const int matrixCols = compositor->cols();
+    const int matrixRows = compositor->rows();
 
-    int w = width();
-    int h = height();
+    int w = size.width();
+    int h = size.height();
     if (w <= 0 || h <= 0)
         return kMinCellSize;
 
     float usableHeight = h * kMaxHeightUsage;
-    float sizeByHeight = usableHeight / static_cast<float>(MatrixRows);
-    float sizeByWidth = static_cast<float>(w) / static_cast<float>(MatrixCols);
+    float sizeByHeight = usableHeight / static_cast<float>(matrixRows);
+    float sizeByWidth = static_cast<float>(w) / static_cast<float>(matrixCols);
     float chosen = std::min(sizeByHeight, sizeByWidth);
 
     if (chosen < kMinCellSize)
@@ -179,174 +253,697 @@ float MatrixDisplay::calculateCellSize() const
     return chosen;
 }
 
+QRectF MatrixDisplay::matrixRect(float cellSize) const
+{
+    return matrixRectFor(cellSize, size());
+}
+
+QRectF MatrixDisplay::matrixRectFor(float cellSize, const QSize &size) const
+{
+    const float matrixWidth = compositor->cols() * cellSize;
+    const float matrixHeight = compositor->rows() * cellSize;
+    return QRectF((size.width() - matrixWidth) / 2.0f, (size.height() - matrixHeight) / 2.0f, matrixWidth, matrixHeight);
+}
+
+QSize MatrixDisplay::renderSize() const
+{
+    return resizing ? interimSize : size();
+}
+
 void MatrixDisplay::resizeEvent(QResizeEvent *event)
 {
+    MATRIX_TRACE_SCOPE("MatrixDisplay::resizeEvent");
+    latency.markInput(LatencyTracker::Resize);
     QWidget::resizeEvent(event);
 
-    if (currentMode == Text){
-        restartScrollIfNeeded();
+    // Le défilement se compte en colonnes de LED : la taille du widget ne le concerne pas,
+    // et le plan des LED reste valide. Seul le dessin dépend de la taille de cellule.
+    const QSize oldSize = event->oldSize();
+    if (!isVisible() || !oldSize.isValid() || oldSize.isEmpty()) {
+        requestRepaint();
+        return;
     }
-    onTimeout();
-    update();
+
+    // Étapes intermédiaires : LED dessinées à la taille de départ (caches déjà prêts) puis mises
+    // à l'échelle ; le rendu à la nouvelle taille attend que la taille se stabilise
+    if (!resizing) {
+        resizing = true;
+        interimSize = oldSize;
+        interimStale = true;
+    }
+    resizeSettleTimer->start();
+    requestRepaint();
 }
 
+void MatrixDisplay::finishResize()
+{
+    resizing = false;
+    interimImage = QImage();
+    requestRepaint();
+}
 
-void MatrixDisplay::restartScrollIfNeeded()
+void MatrixDisplay::onTimerWakeup()
 {
-    timer->stop();
-    scrollOffset = 0.0f;
+    if (wakeupMonitoring) {
+        ++wakeupCount;
+    }
+}
 
-    if (currentMode != Text || !scrollEnabled)
+void MatrixDisplay::setWakeupMonitoringEnabled(bool enabled)
+{
+    if (wakeupMonitoring == enabled)
         return;
 
-    if (currentText.isEmpty())
+    wakeupMonitoring = enabled;
+    wakeupCount = 0;
+    if (wakeupMonitoring) {
+        wakeupWindow.start();
+        wakeupReportTimer->start();
+    } else {
+        wakeupReportTimer->stop();
+    }
+}
+
+void MatrixDisplay::reportWakeupRate()
+{
+    const qint64 elapsedMs = wakeupWindow.restart();
+    if (elapsedMs <= 0)
         return;
 
-    timer->start(scrollIntervalMs);
+    lastWakeupRate = wakeupCount * 60000.0 / static_cast<double>(elapsedMs);
+    wakeupCount = 0;
+    emit wakeupRateMeasured(lastWakeupRate);
 }
 
-void MatrixDisplay::onTimeout()
+void MatrixDisplay::setLatencyMonitoringEnabled(bool enabled)
 {
-    if (currentMode == Clock) {
-        QString timeText = QTime::currentTime().toString("HH:mm");
-        
-        if (QTime::currentTime().second() % 2 == 0) {
-            timeText[2] = ' ';
-        }
+    if (latency.isEnabled() == enabled)
+        return;
 
-        if (currentText != timeText) {
-            currentText = timeText;
-            update();
-        }
+    latency.setEnabled(enabled);
+    latency.reset();
+    if (enabled) {
+        latencyReportTimer->start();
+    } else {
+        latencyReportTimer->stop();
+    }
+}
 
-    } else if (currentMode == Text && scrollEnabled) {
-        const float cellSize = calculateCellSize();
-        int numChars = currentText.length();
-
-        float totalTextWidthInCols = numChars * CHAR_COLS;
-            + (numChars > 1 ? (numChars - 1) : 0);
-        
-        float totalTextWidthInPixels = totalTextWidthInCols * cellSize;
-        float matrixWidth = MatrixCols * cellSize;
-
-        if (scrollMode == bounceMode) {
-            float bounceRange = (totalTextWidthInPixels >= matrixWidth)
-                                    ? (totalTextWidthInPixels - matrixWidth)
-                                    : (matrixWidth - totalTextWidthInPixels);
-            if (bounceRange <= 0.0f) {
-                scrollOffset = 0.0f;
-                scrollDirection = 1;
-                update();
-                return;
-            }
-
-            scrollOffset += scrollDirection * cellSize;
-
-            if (scrollOffset >= bounceRange) {
-                scrollOffset = bounceRange;
-                scrollDirection = -1;
-            } else if (scrollOffset <= 0.0f) {
-                scrollOffset = 0.0f;
-                scrollDirection = 1;
-            }
-            update();
-        } else {
-            int wrapWidth = static_cast<int>(totalTextWidthInPixels + matrixWidth);
-            if (wrapWidth > 0) {
-                scrollOffset += cellSize;
-                if (scrollOffset >= wrapWidth) {
-                    scrollOffset = std::fmod(scrollOffset, wrapWidth);
-                }
-            }
-            update();
-        }
+void MatrixDisplay::reportLatency()
+{
+    const LatencyTracker::Report report = latency.report();
+    if (report.total.count == 0 && report.dropped == 0)
+        return;
+
+    emit latencyMeasured(report);
+    latency.reset();
+}
+
+LatencyTracker::Report MatrixDisplay::latencyReport() const
+{
+    return latency.report();
+}
+
+void MatrixDisplay::resetLatency()
+{
+    latency.reset();
+}
+
+void MatrixDisplay::setPowerBudget(double ledCurrentMa, double limitMa)
+{
+    const bool enabled = ledCurrentMa > 0.0;
+    power.setBudget(ledCurrentMa, limitMa);
+    if (power.isEnabled() != enabled) {
+        power.setEnabled(enabled);
+        power.reset();
     }
+    if (enabled) {
+        powerReportTimer->start();
+    } else {
+        powerReportTimer->stop();
+    }
+    requestRepaint();
+}
+
+void MatrixDisplay::reportPower()
+{
+    const PowerLimiter::Statistics statistics = power.statistics();
+    if (statistics.frames == 0)
+        return;
+
+    emit powerMeasured(statistics);
+    power.reset();
+}
+
+PowerLimiter::Statistics MatrixDisplay::powerStatistics() const
+{
+    return power.statistics();
+}
+
+void MatrixDisplay::resetPowerStatistics()
+{
+    power.reset();
+}
+
+void MatrixDisplay::setIntensityResponse(double gamma, double brightness)
+{
+    intensity.setResponse(gamma, brightness);
+    // L'image présentée change : publiée de nouveau comme un changement de contenu
+    invalidateFrame();
+}
+
+void MatrixDisplay::setBitPlaneSimulation(int bits, int refreshHz)
+{
+    intensity.setBitPlanes(bits, refreshHz);
+    invalidateFrame();
+}
+
+IntensityLut::Statistics MatrixDisplay::intensityStatistics() const
+{
+    return intensity.statistics();
+}
+
+double MatrixDisplay::wakeupsPerMinute() const
+{
+    return lastWakeupRate;
+}
+
+bool MatrixDisplay::isSuspended() const
+{
+    return suspended;
+}
+
+void MatrixDisplay::setPowerSavingEnabled(bool enabled)
+{
+    if (powerSavingEnabled == enabled)
+        return;
+
+    powerSavingEnabled = enabled;
+    updateSuspendState();
+}
+
+bool MatrixDisplay::shouldSuspend() const
+{
+    if (!powerSavingEnabled)
+        return false;
+
+    if (!isVisible())
+        return true;
+
+    const QWidget *top = window();
+    if (top && top->isMinimized())
+        return true;
+
+    if (watchedWindow) {
+        if (!watchedWindow->isExposed())
+            return true;
+        const QWindow::Visibility visibility = watchedWindow->visibility();
+        if (visibility == QWindow::Hidden || visibility == QWindow::Minimized)
+            return true;
+    }
+
+    const Qt::ApplicationState appState = QGuiApplication::applicationState();
+    return appState == Qt::ApplicationSuspended || appState == Qt::ApplicationHidden;
+}
+
+void MatrixDisplay::updateSuspendState()
+{
+    const bool suspend = shouldSuspend();
+    if (suspend == suspended)
+        return;
+
+    suspended = suspend;
+    if (suspended) {
+        compositor->suspend();
+        effectsTimer->stop();
+    } else {
+        // Reprise : chaque zone rattrape le défilement correspondant au temps passé en veille
+        compositor->resume();
+        invalidateFrame();
+    }
+    emit suspendedChanged(suspended);
+}
+
+void MatrixDisplay::watchWindowHandle()
+{
+    QWidget *top = window();
+    QWindow *handle = top ? top->windowHandle() : nullptr;
+    if (handle == watchedWindow)
+        return;
+
+    if (watchedWindow) {
+        watchedWindow->removeEventFilter(this);
+        disconnect(watchedWindow, nullptr, this, nullptr);
+    }
+
+    watchedWindow = handle;
+    if (watchedWindow) {
+        watchedWindow->installEventFilter(this);
+        connect(watchedWindow, &QWindow::visibilityChanged, this, &MatrixDisplay::updateSuspendState);
+    }
+}
+
+void MatrixDisplay::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    watchWindowHandle();
+    updateSuspendState();
+}
+
+void MatrixDisplay::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    updateSuspendState();
+}
+
+bool MatrixDisplay::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == watchedWindow && event->type() == QEvent::Expose) {
+        updateSuspendState();
+    }
+    return QWidget::eventFilter(watched, event);
 }
 
 bool MatrixDisplay::requiresScrolling() const
 {
-    if (currentText.isEmpty())
+    return compositor->primaryZone()->requiresScrolling();
+}
+
+void MatrixDisplay::invalidateFrame()
+{
+    latency.markLayout();
+    rasterDirty = true;
+    requestRepaint();
+}
+
+void MatrixDisplay::requestRepaint()
+{
+    if (renderThread) {
+        scheduleSnapshot();
+    } else {
+        update();
+    }
+    emit frameChanged();
+}
+
+bool MatrixDisplay::isRenderThreadEnabled() const
+{
+    return renderThread != nullptr;
+}
+
+void MatrixDisplay::setRenderThreadEnabled(bool enabled)
+{
+    if (isRenderThreadEnabled() == enabled)
+        return;
+
+    if (enabled) {
+        renderThread = new RenderThread(this);
+        connect(renderThread, &RenderThread::frameReady, this, [this]() {
+            recordFrameTime(renderThread->lastRenderTime());
+            update();
+        });
+    } else {
+        delete renderThread;
+        renderThread = nullptr;
+    }
+    requestRepaint();
+}
+
+LedRenderer::Quality MatrixDisplay::renderQuality() const
+{
+    return adaptiveQuality.quality();
+}
+
+double MatrixDisplay::frameTimeBudget() const
+{
+    return adaptiveQuality.budget();
+}
+
+double MatrixDisplay::lastFrameTime() const
+{
+    return lastFrameMs;
+}
+
+void MatrixDisplay::setFrameTimeBudget(double budgetMs)
+{
+    const LedRenderer::Quality previous = adaptiveQuality.quality();
+    adaptiveQuality.setBudget(budgetMs);
+    if (adaptiveQuality.quality() != previous) {
+        emit renderQualityChanged(adaptiveQuality.quality());
+        requestRepaint();
+    }
+}
+
+LedRenderer::Style MatrixDisplay::ledStyle() const
+{
+    return currentLedStyle;
+}
+
+void MatrixDisplay::setLedStyle(LedRenderer::Style style)
+{
+    if (currentLedStyle == style)
+        return;
+
+    currentLedStyle = style;
+    requestRepaint();
+}
+
+void MatrixDisplay::recordFrameTime(qint64 frameNs)
+{
+    if (frameNs <= 0)
+        return;
+
+    lastFrameMs = frameNs / 1e6;
+    if (!adaptiveQuality.addSample(frameNs))
+        return;
+
+    emit renderQualityChanged(adaptiveQuality.quality());
+    requestRepaint();
+}
+
+void MatrixDisplay::scheduleSnapshot()
+{
+    if (snapshotPending)
+        return;
+
+    snapshotPending = true;
+    QMetaObject::invokeMethod(this, &MatrixDisplay::submitSnapshot, Qt::QueuedConnection);
+}
+
+void MatrixDisplay::submitSnapshot()
+{
+    snapshotPending = false;
+    if (!renderThread)
+        return;
+
+    // En veille, paintEvent() ne dessine que le fond : rien à préparer
+    if (suspended) {
+        effectsTimer->stop();
+        update();
+        return;
+    }
+
+    const LedFrame &frame = updateDisplayFrame();
+    snapshot.sequence = frameSequence;
+    snapshot.frame = frame;
+    snapshot.palette = compositor->palette();
+    snapshot.background = backgroundColor;
+    snapshot.size = renderSize();
+    snapshot.devicePixelRatio = devicePixelRatioF();
+    snapshot.cellSize = cellSizeFor(snapshot.size);
+    snapshot.matrixRect = matrixRectFor(snapshot.cellSize, snapshot.size);
+    snapshot.drawMatrix = compositor->hasContent() || effects.isAnimating();
+    snapshot.quality = adaptiveQuality.quality();
+    snapshot.style = currentLedStyle;
+    renderThread->submit(snapshot);
+}
+
+void MatrixDisplay::onZonesChanged(bool contentChanged)
+{
+    if (contentChanged)
+        transitionPending = true;
+    invalidateFrame();
+}
+
+void MatrixDisplay::postText(const QString &text)
+{
+    mailbox.text.post(text);
+    wakeMailbox();
+}
+
+void MatrixDisplay::postColor(const QColor &color)
+{
+    mailbox.color.post(color.rgb());
+    wakeMailbox();
+}
+
+void MatrixDisplay::postDisplayMode(DisplayMode mode)
+{
+    mailbox.displayMode.post(mode);
+    wakeMailbox();
+}
+
+void MatrixDisplay::postScrollMode(ScrollMode mode)
+{
+    mailbox.scrollMode.post(mode);
+    wakeMailbox();
+}
+
+void MatrixDisplay::postScrollEnabled(bool enabled)
+{
+    mailbox.scrollEnabled.post(enabled);
+    wakeMailbox();
+}
+
+void MatrixDisplay::postScrollSpeed(int speed)
+{
+    mailbox.scrollSpeed.post(speed);
+    wakeMailbox();
+}
+
+void MatrixDisplay::wakeMailbox()
+{
+    // Horodatage du premier dépôt depuis le dernier relevé, pour la mesure de latence
+    qint64 noPost = 0;
+    mailbox.firstPostNs.compare_exchange_strong(noPost, LatencyTracker::nowNs(), std::memory_order_relaxed);
+    // Un seul événement en attente quel que soit le nombre de dépôts
+    if (!mailbox.wakePending.exchange(true, std::memory_order_seq_cst)) {
+        QMetaObject::invokeMethod(this, &MatrixDisplay::drainMailbox, Qt::QueuedConnection);
+    }
+}
+
+void MatrixDisplay::drainMailbox()
+{
+    const qint64 nowMs = clock->elapsedMs();
+    const qint64 waitMs = lastMailboxDrainMs + kMailboxFrameIntervalMs - nowMs;
+    if (lastMailboxDrainMs >= 0 && waitMs > 0) {
+        if (!mailboxTimer->isActive())
+            mailboxTimer->start(static_cast<int>(waitMs));
+        return;
+    }
+    lastMailboxDrainMs = nowMs;
+
+    // Réarmement avant le relevé : un dépôt concurrent programmera le relevé suivant.
+    // L'ordre séquentiellement cohérent interdit qu'un dépôt échappe à la fois au relevé
+    // et au réarmement (le réveil serait perdu)
+    mailbox.wakePending.store(false, std::memory_order_seq_cst);
+    const qint64 postNs = mailbox.firstPostNs.exchange(0, std::memory_order_relaxed);
+    if (postNs > 0)
+        latency.markInput(LatencyTracker::PostedChange, postNs);
+
+    MatrixZone *zone = compositor->primaryZone();
+    int mode = 0;
+    if (mailbox.displayMode.take(&mode))
+        zone->setDisplayMode(static_cast<DisplayMode>(mode));
+    QString text;
+    if (mailbox.text.take(&text))
+        zone->setText(text);
+    if (mailbox.scrollMode.take(&mode))
+        zone->setScrollMode(static_cast<ScrollMode>(mode));
+    bool enabled = false;
+    if (mailbox.scrollEnabled.take(&enabled))
+        zone->setScrollEnabled(enabled);
+    int speed = 0;
+    if (mailbox.scrollSpeed.take(&speed))
+        zone->setScrollInterval(speed);
+    QRgb color = 0;
+    if (mailbox.color.take(&color))
+        zone->setColor(QColor(color));
+}
+
+void MatrixDisplay::onEffectsTick()
+{
+    if (wakeupMonitoring) {
+        ++wakeupCount;
+    }
+    requestRepaint();
+}
+
+void MatrixDisplay::setTransitionEffect(LedEffects::Transition transition, int durationMs)
+{
+    effects.setTransition(transition, durationMs);
+}
+
+void MatrixDisplay::setAfterglow(int decayMs)
+{
+    effects.setAfterglow(decayMs);
+    requestRepaint();
+}
+
+const LedFrame &MatrixDisplay::updateDisplayFrame()
+{
+    MATRIX_TRACE_SCOPE("MatrixDisplay::updateDisplayFrame");
+    const qint64 nowMs = clock->elapsedMs();
+    const bool frameChanged = rasterDirty || effects.isAnimating() || intensity.isAnimating() || power.isRecovering();
+    if (rasterDirty) {
+        effects.setTarget(compositor->frame(), transitionPending, nowMs);
+        rasterDirty = false;
+        transitionPending = false;
+    }
+    // Première image calculée après un changement : elle le montre
+    latency.markRasterized(++frameSequence);
+    if (frameChanged)
+        interimStale = true;
+
+    const LedFrame &content = effects.process(nowMs);
+    // Le flux TCP montre le contenu ; la limite de courant ne concerne que la matrice physique
+    if (frameStreamer && (frameChanged || frameStreamer->statistics().framesEncoded == 0))
+        frameStreamer->publish(content, compositor->palette());
+    // Réponse du panneau avant la limite : le courant suit le rapport cyclique réellement affiché
+    const LedFrame &frame = power.apply(intensity.apply(content, nowMs), compositor->palette(), nowMs);
+    if (framePublisher && (frameChanged || framePublisher->publishedFrames() == 0))
+        framePublisher->publish(frame, compositor->palette());
+
+    // Les effets en cours, le scintillement simulé et la remontée de la luminosité demandent des images supplémentaires
+    if (effects.isAnimating() || intensity.isAnimating() || power.isRecovering()) {
+        if (!effectsTimer->isActive())
+            effectsTimer->start();
+    } else {
+        effectsTimer->stop();
+    }
+    return frame;
+}
+
+void MatrixDisplay::setClock(const FrameClock *clock)
+{
+    if (this->clock == clock)
+        return;
+
+    this->clock = clock;
+    lastMailboxDrainMs = -1;
+    compositor->setClock(clock);
+    invalidateFrame();
+}
+
+void MatrixDisplay::tick()
+{
+    compositor->tick();
+}
+
+const LedFrame &MatrixDisplay::displayFrame()
+{
+    return updateDisplayFrame();
+}
+
+void MatrixDisplay::renderMatrix(QPainter &painter)
+{
+    paintMatrix(painter);
+    latency.markPresented(frameSequence);
+}
+
+bool MatrixDisplay::setSharedFrameKey(const QString &key, QString *errorMessage)
+{
+    delete framePublisher;
+    framePublisher = nullptr;
+    if (key.isEmpty())
+        return true;
+
+    auto *publisher = new SharedFramePublisher(this);
+    if (!publisher->open(key, SharedFramePublisher::DefaultMaxLeds, errorMessage)) {
+        delete publisher;
         return false;
-    const float cellSize = calculateCellSize();
-    const int numChars = currentText.length();
-    const float totalTextWidthInCols = numChars * CHAR_COLS;
-        + (numChars > 1 ? (numChars - 1) : 0.0f);
-    const float totalTextWidthInPixels = totalTextWidthInCols * cellSize;
-    const float matrixWidth = MatrixCols * cellSize;
+    }
+    framePublisher = publisher;
+    // Première publication à la prochaine présentation, même si le contenu n'a pas changé
+    requestRepaint();
+    return true;
+}
+
+bool MatrixDisplay::startFrameStream(quint16 port, QString *errorMessage)
+{
+    delete frameStreamer;
+    frameStreamer = nullptr;
 
-    return totalTextWidthInPixels > matrixWidth;
+    auto *server = new FrameStreamServer(this);
+    if (!server->listen(port, errorMessage)) {
+        delete server;
+        return false;
+    }
+    frameStreamer = server;
+    // Image clé disponible dès la prochaine présentation pour les premiers visualiseurs
+    requestRepaint();
+    return true;
 }
 
 void MatrixDisplay::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event);
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing, true);
+    MATRIX_TRACE_SCOPE("MatrixDisplay::paintEvent");
+    {
+        QPainter painter(this);
+        if (renderThread && !suspended) {
+            presentRenderedFrame(painter);
+            latency.markPresented(renderThread->latestSequence());
+        } else {
+            paintMatrix(painter);
+            latency.markPresented(frameSequence);
+        }
+    }
+    emit framePainted();
+}
+
+void MatrixDisplay::presentRenderedFrame(QPainter &painter)
+{
+    const QSize latestSize = renderThread->latestSize();
+    if (latestSize == size()) {
+        renderThread->drawLatest(painter);
+        return;
+    }
+
+    // Image d'une autre taille (redimensionnement en cours ou juste terminé) : sa matrice mise à l'échelle
+    painter.fillRect(rect(), backgroundColor);
+    if (latestSize.isValid()) {
+        const QRectF source = matrixRectFor(cellSizeFor(latestSize), latestSize);
+        renderThread->drawLatest(painter, matrixRect(calculateCellSize()), source);
+    }
+    if (!resizing)
+        scheduleSnapshot();
+}
+
+void MatrixDisplay::paintMatrix(QPainter &painter)
+{
     painter.fillRect(rect(), backgroundColor);
-    if (currentText.isEmpty()) {
+    // Aucun rendu de la matrice tant qu'elle n'est pas visible
+    if (suspended) {
+        effectsTimer->stop();
         return;
     }
-    const float cellSize = calculateCellSize();
-    const float pixelDiameter = cellSize * 0.8f;
-    const float pixelOffset = (cellSize - pixelDiameter) / 2.0f;
-    float matrixWidth = MatrixCols * cellSize;
-    float matrixHeight = MatrixRows * cellSize;
-    float xBase = (width() - matrixWidth) / 2.0f;
-    float yOffset = (height() - matrixHeight) / 2.0f;
-    painter.setClipRect(QRectF(xBase, yOffset, matrixWidth, matrixHeight));
-    int numChars = currentText.length();
-    float totalTextWidthInCols = numChars * CHAR_COLS;
-        + (numChars > 1 ? (numChars - 1) : 0);
-    float totalTextWidthInPixels = totalTextWidthInCols * cellSize;
-    bool isScrolling = (currentMode == Text) && scrollEnabled;
-    float xOffset = xBase + (matrixWidth - totalTextWidthInPixels) / 2.0f;
-    if (isScrolling) {
-        if (scrollMode == bounceMode) {
-            if (totalTextWidthInPixels >= matrixWidth) {
-                // Ajout de 2 pxiels de marge pour voir bien entièrement le premier caractères
-                xOffset = xBase - scrollOffset + 2.0f * cellSize;
-            } else {
-                float bounceRange = matrixWidth - totalTextWidthInPixels;
-                float centeredBase = xBase + bounceRange / 2.0f;
-                xOffset = centeredBase + (scrollOffset - bounceRange / 2.0f);
-            }
-        } else {
-            xOffset = xBase + matrixWidth - scrollOffset;
-        }
+
+    const LedFrame &frame = updateDisplayFrame();
+    if (!compositor->hasContent() && !effects.isAnimating()) {
+        return;
     }
-   
-    
-    
-    painter.setPen(Qt::NoPen);
-
-    painter.setBrush(Qt::black);
-    for (int row = 0; row < MatrixRows; ++row) {
-        for (int col = 0; col < MatrixCols; ++col) {
-            float x = xBase + col * cellSize + pixelOffset;
-            float y = yOffset + row * cellSize + pixelOffset;
-            painter.drawEllipse(QRectF(x, y, pixelDiameter, pixelDiameter));
-        }
+    if (resizing) {
+        paintInterimFrame(painter, frame);
+        return;
     }
 
-    for (int i = 0; i < numChars; ++i) {
-        char c = currentText[i].toLatin1();
-        if (!matrix_font.count(c)) {
-            continue;
-        }
-        const auto &charMap = matrix_font.at(c);
-        float charStartX = i * (CHAR_COLS) * cellSize;
-        
-        for (int row = 0 ; row < CHAR_ROWS ; ++row) {
-            for (int col = 0; col < CHAR_COLS; ++col) {
-                if (col < charMap[row].length() && charMap[row][col] == '1') {
-                    float x = xOffset + charStartX + col * cellSize + pixelOffset;
-                    float y = yOffset + (row + (MatrixRows - CHAR_ROWS) / 2.0f) * cellSize + pixelOffset;
-                    painter.setBrush(pixelColor);
-                    if (x + pixelDiameter < xBase || x > xBase + matrixWidth)
-                        continue;
-                    painter.drawEllipse(QRectF(x, y, pixelDiameter, pixelDiameter));
-                }
-            }
-        }
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+    const float cellSize = calculateCellSize();
+    renderer.paint(painter, frame, compositor->palette(), matrixRect(cellSize), cellSize,
+                   adaptiveQuality.quality(), currentLedStyle);
+    recordFrameTime(paintTimer.nsecsElapsed());
+}
+
+void MatrixDisplay::paintInterimFrame(QPainter &painter, const LedFrame &frame)
+{
+    MATRIX_TRACE_SCOPE("MatrixDisplay::paintInterimFrame");
+    const float sourceCellSize = cellSizeFor(interimSize);
+    const QSizeF sourceSize = matrixRectFor(sourceCellSize, interimSize).size();
+
+    // Nouveau dessin seulement si l'image a changé : sinon une simple copie mise à l'échelle
+    if (interimStale || interimImage.isNull()) {
+        const qreal dpr = devicePixelRatioF();
+        const QSize pixelSize = (sourceSize * dpr).toSize();
+        if (interimImage.size() != pixelSize)
+            interimImage = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+        interimImage.setDevicePixelRatio(dpr);
+        interimImage.fill(backgroundColor);
+        QPainter imagePainter(&interimImage);
+        renderer.paint(imagePainter, frame, compositor->palette(), QRectF(QPointF(0, 0), sourceSize), sourceCellSize,
+                       adaptiveQuality.quality(), currentLedStyle);
+        interimStale = false;
     }
-}
\ No newline at end of file
+    painter.drawImage(matrixRect(calculateCellSize()), interimImage);
+}
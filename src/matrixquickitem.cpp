@@ -0,0 +1,380 @@
+/**
+ * @file matrixquickitem.cpp
+ * @author G. Maxime
+ * @brief Implémentation de la variante Qt Quick de la matrice : graphe de scène conservé.
+ */
+
+// Inclusion de mes headers
+#include "headers/matrixquickitem.h"
+#include "headers/matrixfont.h"
+#include "headers/ledrenderer.h"
+#include "headers/trace.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QQuickWindow>
+#include <QQmlEngine>
+#include <QSGNode>
+#include <QSGImageNode>
+#include <QSGRectangleNode>
+#include <QSGTexture>
+#include <QPainter>
+#include <QImage>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief Constantes de la grille, identiques à celles de MatrixDisplay.
+ */
+static constexpr float kMaxHeightUsage = 0.95f;
+static constexpr float kMinCellSize = 2.0f;
+static constexpr float kMaxCellSize = 36.0f;
+static constexpr int kDefaultMatrixCols = 100;
+static constexpr int kDefaultMatrixRows = CHAR_ROWS + 4;
+static constexpr float kDefaultCellSize = 12.0f;
+
+namespace {
+
+/**
+ * @class MatrixQuickNode
+ * @brief Racine de l'arbre conservé : fond, grille des LED éteintes, puis un nœud par LED allumée.
+ * Possède les textures partagées par ses nœuds et les nœuds de LED détachés, prêts à resservir.
+ */
+class MatrixQuickNode : public QSGNode
+{
+public:
+    ~MatrixQuickNode() override
+    {
+        for (QSGImageNode *led : freeLeds)
+            delete led;
+        delete atlasTexture;
+        delete gridTexture;
+    }
+
+    /**
+     * @brief Détache tous les nœuds de LED (nouvelle géométrie ou nouvelle palette).
+     */
+    void detachLeds(int ledCount)
+    {
+        for (QSGImageNode *&led : leds) {
+            if (!led)
+                continue;
+            removeChildNode(led);
+            freeLeds.push_back(led);
+            led = nullptr;
+        }
+        leds.assign(static_cast<size_t>(ledCount), nullptr);
+        keys.assign(static_cast<size_t>(ledCount), 0);
+    }
+
+    QSGRectangleNode *backgroundNode = nullptr;
+    QSGImageNode *gridNode = nullptr;
+    QSGTexture *atlasTexture = nullptr;
+    QSGTexture *gridTexture = nullptr;
+
+    /**
+     * @brief Nœud de chaque LED (nullptr si éteinte) et son état : 0 éteinte, sinon 1 + groupe (encre, niveau).
+     */
+    std::vector<QSGImageNode *> leds;
+    std::vector<int> keys;
+
+    /**
+     * @brief Nœuds détachés, réutilisés avant d'en créer de nouveaux.
+     */
+    std::vector<QSGImageNode *> freeLeds;
+
+    /**
+     * @brief Géométrie et couleurs pour lesquelles les textures ont été dessinées.
+     */
+    float cellSize = 0.0f;
+    qreal devicePixelRatio = 0.0;
+    int cols = 0;
+    int rows = 0;
+    int paletteDepth = 0;
+    std::vector<QRgb> colors;
+};
+
+/**
+ * @brief Indique si la palette diffère des couleurs de l'atlas.
+ */
+bool paletteChanged(const LedPalette &palette, const MatrixQuickNode &node)
+{
+    if (palette.depth() != node.paletteDepth || static_cast<size_t>(palette.size()) != node.colors.size())
+        return true;
+    for (int index = 0; index < palette.size(); ++index) {
+        if (palette.color(index) != node.colors[static_cast<size_t>(index)])
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Atlas des LED allumées : une cellule par niveau (colonnes) et par encre (lignes),
+ * dessinée par LedRenderer pour un rendu identique au widget.
+ */
+QImage buildAtlas(const LedPalette &palette, float cellSize, qreal devicePixelRatio)
+{
+    const int buckets = LedRenderer::IntensityBuckets;
+    const int inks = std::max(1, palette.size());
+    LedFrame cells(buckets, inks);
+    cells.setInkDepth(palette.depth());
+    for (int ink = 0; ink < inks; ++ink) {
+        for (int bucket = 0; bucket < buckets; ++bucket) {
+            // Niveau représentatif du groupe, comme les brushes de LedRenderer
+            cells.set(bucket, ink, static_cast<quint8>((bucket + 1) * 256 / buckets - 1));
+            cells.setInkAt(ink * buckets + bucket, static_cast<quint8>(ink));
+        }
+    }
+
+    const QSizeF logicalSize(buckets * cellSize, inks * cellSize);
+    QImage image((logicalSize * devicePixelRatio).toSize(), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    LedRenderer renderer;
+    renderer.paint(painter, cells, palette, QRectF(QPointF(0, 0), logicalSize), cellSize);
+    return image;
+}
+
+/**
+ * @brief Grille des LED éteintes, dessinée une fois par taille de cellule.
+ */
+QImage buildGrid(int cols, int rows, const LedPalette &palette, float cellSize, qreal devicePixelRatio)
+{
+    const QSizeF logicalSize(cols * cellSize, rows * cellSize);
+    QImage image((logicalSize * devicePixelRatio).toSize(), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    LedRenderer renderer;
+    renderer.paint(painter, LedFrame(cols, rows), palette, QRectF(QPointF(0, 0), logicalSize), cellSize);
+    return image;
+}
+
+} // namespace
+
+MatrixQuickItem::MatrixQuickItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+    setImplicitSize(kDefaultMatrixCols * kDefaultCellSize, kDefaultMatrixRows * kDefaultCellSize);
+
+    // Même moteur que MatrixDisplay : chaque changement demande une image au graphe de scène
+    compositor = new ZoneCompositor(kDefaultMatrixCols, kDefaultMatrixRows, this);
+    connect(compositor, &ZoneCompositor::changed, this, &QQuickItem::update);
+}
+
+void MatrixQuickItem::registerQmlType()
+{
+    qmlRegisterType<MatrixQuickItem>("MatrixDisplay", 1, 0, "LedMatrix");
+}
+
+QString MatrixQuickItem::text() const
+{
+    return compositor->primaryZone()->text();
+}
+
+void MatrixQuickItem::setText(const QString &text)
+{
+    if (text == this->text())
+        return;
+    compositor->primaryZone()->setText(text);
+    emit textChanged();
+}
+
+QColor MatrixQuickItem::color() const
+{
+    return compositor->primaryZone()->color();
+}
+
+void MatrixQuickItem::setColor(const QColor &color)
+{
+    if (color == this->color())
+        return;
+    compositor->primaryZone()->setColor(color);
+    emit colorChanged();
+}
+
+void MatrixQuickItem::setBackgroundColor(const QColor &color)
+{
+    if (color == background)
+        return;
+    background = color;
+    update();
+    emit backgroundColorChanged();
+}
+
+bool MatrixQuickItem::clockMode() const
+{
+    return compositor->primaryZone()->displayMode() == MatrixZone::Clock;
+}
+
+void MatrixQuickItem::setClockMode(bool enabled)
+{
+    if (enabled == clockMode())
+        return;
+    compositor->primaryZone()->setDisplayMode(enabled ? MatrixZone::Clock : MatrixZone::Text);
+    emit clockModeChanged();
+}
+
+void MatrixQuickItem::setScrollEnabled(bool enabled)
+{
+    if (enabled == scrolling)
+        return;
+    scrolling = enabled;
+    compositor->primaryZone()->setScrollEnabled(enabled);
+    emit scrollEnabledChanged();
+}
+
+void MatrixQuickItem::setScrollInterval(int interval)
+{
+    if (interval == scrollSpeed || interval <= 0)
+        return;
+    scrollSpeed = interval;
+    compositor->primaryZone()->setScrollInterval(interval);
+    emit scrollIntervalChanged();
+}
+
+void MatrixQuickItem::setMatrixSize(int cols, int rows)
+{
+    compositor->setMatrixSize(cols, rows);
+    geometryDirty = true;
+    update();
+}
+
+MatrixZone *MatrixQuickItem::zone(int index) const
+{
+    return compositor->zone(index);
+}
+
+void MatrixQuickItem::setClock(const FrameClock *clock)
+{
+    compositor->setClock(clock);
+}
+
+void MatrixQuickItem::tick()
+{
+    compositor->tick();
+}
+
+void MatrixQuickItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        geometryDirty = true;
+        update();
+    }
+}
+
+float MatrixQuickItem::cellSize(qreal devicePixelRatio) const
+{
+    if (width() <= 0 || height() <= 0)
+        return kMinCellSize;
+
+    const float sizeByHeight = static_cast<float>(height()) * kMaxHeightUsage / compositor->rows();
+    const float sizeByWidth = static_cast<float>(width()) / compositor->cols();
+    const float chosen = std::clamp(std::min(sizeByHeight, sizeByWidth), kMinCellSize, kMaxCellSize);
+    // Cellule entière en pixels physiques : chaque nœud copie sa cellule de l'atlas sans mise à l'échelle
+    const float ratio = devicePixelRatio > 0.0 ? static_cast<float>(devicePixelRatio) : 1.0f;
+    return std::ceil(chosen * ratio) / ratio;
+}
+
+QSGNode *MatrixQuickItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+    MATRIX_TRACE_SCOPE("MatrixQuickItem::updatePaintNode");
+    QQuickWindow *quickWindow = window();
+    auto *node = static_cast<MatrixQuickNode *>(oldNode);
+    if (!node) {
+        node = new MatrixQuickNode;
+        node->backgroundNode = quickWindow->createRectangleNode();
+        node->appendChildNode(node->backgroundNode);
+        node->gridNode = quickWindow->createImageNode();
+        node->gridNode->setOwnsTexture(false);
+        node->appendChildNode(node->gridNode);
+    }
+    ++stats.frames;
+
+    const QRectF bounds = boundingRect();
+    if (node->backgroundNode->rect() != bounds)
+        node->backgroundNode->setRect(bounds);
+    if (node->backgroundNode->color() != background)
+        node->backgroundNode->setColor(background);
+
+    const LedFrame &frame = compositor->frame();
+    const LedPalette &palette = compositor->palette();
+    const qreal devicePixelRatio = quickWindow->effectiveDevicePixelRatio();
+    const float cell = cellSize(devicePixelRatio);
+    const float cellPixels = cell * static_cast<float>(devicePixelRatio);
+    // Origine de la matrice posée sur un pixel physique entier
+    const QPointF origin(std::floor((width() - frame.cols() * cell) / 2.0 * devicePixelRatio) / devicePixelRatio,
+                         std::floor((height() - frame.rows() * cell) / 2.0 * devicePixelRatio) / devicePixelRatio);
+
+    // Nouvelle géométrie ou nouvelles couleurs : textures redessinées, nœuds de LED repris de zéro
+    const bool geometryChanged = geometryDirty || cell != node->cellSize || devicePixelRatio != node->devicePixelRatio
+                                 || frame.cols() != node->cols || frame.rows() != node->rows;
+    if (geometryChanged || paletteChanged(palette, *node)) {
+        MATRIX_TRACE_SCOPE("MatrixQuickItem::buildTextures");
+        node->detachLeds(frame.ledCount());
+        delete node->atlasTexture;
+        delete node->gridTexture;
+        node->atlasTexture = quickWindow->createTextureFromImage(buildAtlas(palette, cell, devicePixelRatio));
+        node->gridTexture = quickWindow->createTextureFromImage(
+            buildGrid(frame.cols(), frame.rows(), palette, cell, devicePixelRatio));
+        node->gridNode->setTexture(node->gridTexture);
+        node->gridNode->setRect(QRectF(origin, QSizeF(frame.cols() * cell, frame.rows() * cell)));
+        node->cellSize = cell;
+        node->devicePixelRatio = devicePixelRatio;
+        node->cols = frame.cols();
+        node->rows = frame.rows();
+        node->paletteDepth = palette.depth();
+        node->colors.resize(static_cast<size_t>(palette.size()));
+        for (int index = 0; index < palette.size(); ++index)
+            node->colors[static_cast<size_t>(index)] = palette.color(index);
+        geometryDirty = false;
+        ++stats.atlasBuilds;
+    }
+
+    // Seules les LED dont l'état a changé touchent au graphe de scène
+    const int buckets = LedRenderer::IntensityBuckets;
+    const int atlasInks = std::max(1, palette.size());
+    const quint8 *levels = frame.data();
+    for (int index = 0; index < frame.ledCount(); ++index) {
+        const quint8 level = levels[index];
+        const int ink = level ? std::min<int>(frame.inkAt(index), atlasInks - 1) : 0;
+        const int key = level ? 1 + ink * buckets + level * buckets / 256 : 0;
+        int &previous = node->keys[static_cast<size_t>(index)];
+        if (key == previous)
+            continue;
+        previous = key;
+        ++stats.changedLeds;
+
+        QSGImageNode *&led = node->leds[static_cast<size_t>(index)];
+        if (!key) {
+            node->removeChildNode(led);
+            node->freeLeds.push_back(led);
+            led = nullptr;
+            continue;
+        }
+        if (!led) {
+            if (!node->freeLeds.empty()) {
+                led = node->freeLeds.back();
+                node->freeLeds.pop_back();
+            } else {
+                led = quickWindow->createImageNode();
+                led->setOwnsTexture(false);
+            }
+            led->setTexture(node->atlasTexture);
+            const int col = index % frame.cols();
+            const int row = index / frame.cols();
+            led->setRect(QRectF(origin.x() + col * cell, origin.y() + row * cell, cell, cell));
+            node->appendChildNode(led);
+        }
+        const int bucket = (key - 1) % buckets;
+        led->setSourceRect(QRectF(bucket * cellPixels, ink * cellPixels, cellPixels, cellPixels));
+    }
+    stats.litNodes = static_cast<int>(node->childCount()) - 2;
+    return node;
+}
@@ -0,0 +1,1022 @@
+/**
+ * @file matrixzone.cpp
+ * @author G. Maxime
+ * @brief Implémentation d'une zone de la matrice : contenu, défilement et horloge.
+ */
+
+// Inclusion de mes headers
+#include "headers/matrixzone.h"
+#include "headers/matrixfont.h"
+#include "headers/trace.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QDebug>
+#include <QThread>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Constantes de configuration des zones.
+ */
+static constexpr int defaultScrollIntervalMs = 50;
+static constexpr int kCompactSeparatorCols = 5;
+static constexpr int kClockWakeupSlackMs = 2;
+static constexpr int kClockPhaseToleranceMs = 50;
+static constexpr int kRainbowSteps = 12;
+static constexpr int kTickerMinColumns = 256;
+static constexpr int kTickerMaxColumns = 1 << 16;
+static constexpr QRgb kTickerZoneColor = 0;
+
+MatrixZone::MatrixZone(const QRect &area, LedPalette *palette, const FrameClock *clock, QObject *parent)
+    : QObject(parent),
+      zoneArea(area),
+      palette(palette),
+      clock(clock)
+{
+    timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &MatrixZone::onTimerWakeup);
+
+    // Timer de l'horloge : précis et périodique une fois calé sur les frontières de seconde
+    clockTimer = new QTimer(this);
+    clockTimer->setTimerType(Qt::PreciseTimer);
+    connect(clockTimer, &QTimer::timeout, this, &MatrixZone::onTimerWakeup);
+
+    clockColumns.fill(0, std::max(0, zoneArea.width()));
+    nextClockColumns.fill(0, std::max(0, zoneArea.width()));
+    zoneFrame.resize(zoneArea.width(), zoneArea.height());
+}
+
+MatrixZone::~MatrixZone()
+{
+    // Le thread de conversion écrit dans la zone : il doit être terminé avant sa destruction
+    if (imageThread) {
+        imageThread->wait();
+        delete imageThread;
+    }
+    // Arrêt explicite : les threads du flux écrivent dans des membres de la zone via ses signaux
+    delete videoFeed;
+}
+
+void MatrixZone::setClock(const FrameClock *clock)
+{
+    if (this->clock == clock)
+        return;
+
+    this->clock = clock;
+    if (scrollStartMs >= 0) {
+        scrollStartMs = clock->elapsedMs();
+        scrollSteps = 0;
+    }
+    if (imageStartMs >= 0)
+        imageStartMs = clock->elapsedMs();
+    tick();
+}
+
+void MatrixZone::tick()
+{
+    onTimeout();
+}
+
+QRect MatrixZone::area() const
+{
+    return zoneArea;
+}
+
+QString MatrixZone::text() const
+{
+    return QString::fromLatin1(textGlyphs);
+}
+
+QColor MatrixZone::color() const
+{
+    return pixelColor;
+}
+
+MatrixZone::DisplayMode MatrixZone::displayMode() const
+{
+    return currentMode;
+}
+
+bool MatrixZone::isDirty() const
+{
+    return dirty;
+}
+
+bool MatrixZone::hasContent() const
+{
+    if (currentMode == Ticker)
+        return tickerTail > tickerPosition;
+    if (currentMode == Image)
+        return !image.isEmpty();
+    if (currentMode == Video)
+        return !videoCodes.isEmpty();
+    return currentMode == Clock || !textGlyphs.isEmpty();
+}
+
+bool MatrixZone::requiresScrolling() const
+{
+    return !textGlyphs.isEmpty() && textWidthInCols() > zoneArea.width();
+}
+
+void MatrixZone::setArea(const QRect &area)
+{
+    if (zoneArea == area)
+        return;
+
+    const bool widthChanged = zoneArea.width() != area.width();
+    const bool sizeChanged = zoneArea.size() != area.size();
+    zoneArea = area;
+    zoneFrame.resize(zoneArea.width(), zoneArea.height());
+    if (widthChanged) {
+        clockColumns.fill(0, std::max(0, zoneArea.width()));
+        nextClockColumns.fill(0, std::max(0, zoneArea.width()));
+        restartScroll();
+    }
+    // Les images sont converties aux dimensions de la zone : nouvelle conversion
+    if (sizeChanged && currentMode == Image)
+        startImageConversion();
+    if (sizeChanged && videoFeed)
+        videoFeed->setTargetSize(zoneArea.size());
+    dirty = true;
+    emit areaChanged();
+}
+
+void MatrixZone::parseMarkup(const QString &markup, QByteArray *glyphs, QVector<InkRun> *runs)
+{
+    // Les tampons du texte précédent sont réutilisés
+    glyphs->resize(0);
+    glyphs->reserve(markup.length());
+    runs->clear();
+
+    for (int i = 0; i < markup.length(); ++i) {
+        if (markup[i] == QLatin1Char('{')) {
+            const int end = markup.indexOf(QLatin1Char('}'), i + 1);
+            if (end > i) {
+                const QString tag = markup.mid(i + 1, end - i - 1).trimmed().toLower();
+                InkRun run;
+                run.start = glyphs->size();
+                if (tag == QStringLiteral("rainbow")) {
+                    run.ink.kind = TextInk::Rainbow;
+                } else if (!tag.isEmpty() && tag != QStringLiteral("/")) {
+                    const QColor color(tag);
+                    if (color.isValid()) {
+                        run.ink.kind = TextInk::Fixed;
+                        run.ink.rgb = color.rgb();
+                    }
+                }
+                // Balise inconnue : ignorée, on revient à la couleur de la zone.
+                // Les caractères déjà lus gardent la couleur de la zone (plage implicite).
+                if (runs->isEmpty() && run.start > 0)
+                    runs->append(InkRun());
+                if (!runs->isEmpty() && runs->last().start == run.start)
+                    runs->last() = run;
+                else
+                    runs->append(run);
+                i = end;
+                continue;
+            }
+        }
+        glyphs->append(markup[i].toUpper().toLatin1());
+    }
+}
+
+void MatrixZone::setText(const QString &text)
+{
+    MATRIX_TRACE_SCOPE("MatrixZone::setText");
+    parseMarkup(text, &textGlyphs, &inkRuns);
+    scrollOffset = 0;
+    scrollDirection = 1;
+    if (currentMode == Text) {
+        restartScrollIfNeeded();
+    } else if (currentMode == Ticker) {
+        // Remplacement : la bande repart vide avec le nouveau texte
+        clearTicker();
+        appendTickerGlyphs(textGlyphs, inkRuns);
+    }
+    markDirty(true);
+}
+
+void MatrixZone::appendText(const QString &text)
+{
+    MATRIX_TRACE_SCOPE("MatrixZone::appendText");
+    if (currentMode != Ticker)
+        setDisplayMode(Ticker);
+
+    parseMarkup(text, &appendGlyphs, &appendRuns);
+    // Le texte ajouté entre hors de la zone, par le bord droit : l'image courante ne change pas
+    appendTickerGlyphs(appendGlyphs, appendRuns);
+}
+
+void MatrixZone::appendTickerGlyphs(const QByteArray &glyphs, const QVector<InkRun> &runs)
+{
+    if (glyphs.isEmpty())
+        return;
+
+    // Le nouveau texte ne doit pas apparaître au milieu de la zone : la fin de bande
+    // est repoussée au bord droit (bande épuisée : elle repart entièrement de ce bord)
+    const qint64 rightEdge = tickerPosition + std::max(0, zoneArea.width());
+    if (tickerTail <= tickerPosition) {
+        tickerHead = rightEdge;
+        tickerTail = rightEdge;
+    }
+    const qint64 padding = std::max<qint64>(0, rightEdge - tickerTail);
+
+    int glyphCount = glyphs.size();
+    const qint64 wanted = (tickerTail - tickerHead) + padding + static_cast<qint64>(glyphCount) * CHAR_COLS;
+    if (!reserveTickerColumns(wanted)) {
+        // Producteur plus rapide que le défilement : la bande est plafonnée, la fin du texte est perdue
+        reserveTickerColumns(kTickerMaxColumns);
+        const qint64 room = kTickerMaxColumns - (tickerTail - tickerHead) - padding;
+        glyphCount = static_cast<int>(std::max<qint64>(0, room / CHAR_COLS));
+        if (!tickerOverflowReported) {
+            tickerOverflowReported = true;
+            qWarning().noquote() << QStringLiteral("MatrixZone: ticker backlog over %1 columns, appended text truncated")
+                                        .arg(kTickerMaxColumns);
+        }
+    }
+    if (glyphCount == 0)
+        return;
+
+    for (qint64 i = 0; i < padding; ++i)
+        pushTickerColumn(0, kTickerZoneColor);
+
+    // Couleurs résolues à l'ajout ; seule la couleur de la zone reste symbolique
+    // pour suivre setColor(). L'arc-en-ciel s'étale sur le texte ajouté.
+    QRgb rainbowColors[kRainbowSteps];
+    bool rainbowResolved = false;
+    const qint64 chunkCols = static_cast<qint64>(glyphCount) * CHAR_COLS;
+
+    const GlyphTable &table = glyphTable();
+    const char *chars = glyphs.constData();
+    int run = runs.isEmpty() ? -1 : 0;
+    for (int i = 0; i < glyphCount; ++i) {
+        while (run >= 0 && run + 1 < runs.size() && runs[run + 1].start <= i)
+            ++run;
+
+        const TextInk textInk = run >= 0 ? runs[run].ink : TextInk();
+        if (textInk.kind == TextInk::Rainbow && !rainbowResolved) {
+            for (int step = 0; step < kRainbowSteps; ++step) {
+                rainbowColors[step] = QColor::fromHsv(step * 360 / kRainbowSteps, 255, 255).rgb();
+            }
+            rainbowResolved = true;
+        }
+
+        const auto glyphIndex = static_cast<unsigned char>(chars[i]);
+        const bool defined = table.defined[glyphIndex];
+        for (int col = 0; col < CHAR_COLS; ++col) {
+            QRgb rgb = kTickerZoneColor;
+            if (textInk.kind == TextInk::Fixed)
+                rgb = textInk.rgb;
+            else if (textInk.kind == TextInk::Rainbow)
+                rgb = rainbowColors[(static_cast<qint64>(i) * CHAR_COLS + col) * kRainbowSteps / chunkCols];
+            pushTickerColumn(defined ? table.columns[glyphIndex][col] : 0, rgb);
+        }
+    }
+
+    // Bande au repos : le défilement repart, daté de cet ajout
+    if (scrollStartMs < 0) {
+        scrollStartMs = clock->elapsedMs();
+        scrollSteps = 0;
+        if (!suspended)
+            timer->start(scrollIntervalMs);
+    }
+}
+
+bool MatrixZone::reserveTickerColumns(qint64 columns)
+{
+    if (columns > kTickerMaxColumns)
+        return false;
+
+    const int capacity = tickerMasks.size();
+    if (columns <= capacity)
+        return true;
+
+    int newCapacity = std::max(capacity, kTickerMinColumns);
+    while (newCapacity < columns)
+        newCapacity *= 2;
+
+    // Les colonnes conservées sont replacées à leur indice dans le nouveau tampon
+    QVector<quint8> masks;
+    QVector<QRgb> colors;
+    masks.fill(0, newCapacity);
+    colors.fill(kTickerZoneColor, newCapacity);
+    for (qint64 column = tickerHead; column < tickerTail; ++column) {
+        masks[column & (newCapacity - 1)] = tickerMasks.at(column & (capacity - 1));
+        colors[column & (newCapacity - 1)] = tickerColors.at(column & (capacity - 1));
+    }
+    tickerMasks.swap(masks);
+    tickerColors.swap(colors);
+    return true;
+}
+
+void MatrixZone::pushTickerColumn(quint8 mask, QRgb rgb)
+{
+    const int slot = static_cast<int>(tickerTail & (tickerMasks.size() - 1));
+    tickerMasks[slot] = mask;
+    tickerColors[slot] = rgb;
+    ++tickerTail;
+}
+
+void MatrixZone::clearTicker()
+{
+    QVector<quint8>().swap(tickerMasks);
+    QVector<QRgb>().swap(tickerColors);
+    tickerHead = 0;
+    tickerTail = 0;
+    tickerPosition = 0;
+    scrollStartMs = -1;
+    scrollSteps = 0;
+}
+
+void MatrixZone::loadImage(const QString &path)
+{
+    imagePath = path;
+    imageFrames.clear();
+    imageDelaysMs.clear();
+    if (currentMode != Image) {
+        image = LedImage();
+        setDisplayMode(Image);
+    }
+    startImageConversion();
+}
+
+void MatrixZone::setImage(const QImage &source)
+{
+    setAnimation({source}, {0});
+}
+
+void MatrixZone::setAnimation(const QVector<QImage> &frames, const QVector<int> &delaysMs)
+{
+    imagePath.clear();
+    imageFrames = frames;
+    imageDelaysMs = delaysMs;
+    if (currentMode != Image) {
+        image = LedImage();
+        setDisplayMode(Image);
+    }
+    startImageConversion();
+}
+
+void MatrixZone::setImageConversion(LedImage::Conversion conversion)
+{
+    if (imageConversion == conversion)
+        return;
+
+    imageConversion = conversion;
+    if (currentMode == Image)
+        startImageConversion();
+    if (videoFeed)
+        videoFeed->setConversion(conversion);
+}
+
+bool MatrixZone::isImageLoading() const
+{
+    return imageThread != nullptr;
+}
+
+void MatrixZone::startImageConversion()
+{
+    if (imagePath.isEmpty() && imageFrames.isEmpty())
+        return;
+
+    // Une seule conversion à la fois : la plus récente est relancée à la fin de celle en cours
+    if (imageThread) {
+        imageConversionStale = true;
+        return;
+    }
+    imageConversionStale = false;
+    convertedImage = LedImage();
+    conversionError.clear();
+
+    // Le thread ne lit que ses copies de la source ; il n'écrit que convertedImage et conversionError
+    const QString path = imagePath;
+    const QVector<QImage> frames = imageFrames;
+    const QVector<int> delaysMs = imageDelaysMs;
+    const QSize size = zoneArea.size();
+    const LedImage::Conversion conversion = imageConversion;
+    imageThread = QThread::create([this, path, frames, delaysMs, size, conversion]() {
+        QVector<QImage> sourceFrames = frames;
+        QVector<int> sourceDelaysMs = delaysMs;
+        if (!path.isEmpty() && !LedImage::readFrames(path, &sourceFrames, &sourceDelaysMs, &conversionError))
+            return;
+        convertedImage = LedImage::convert(sourceFrames, sourceDelaysMs, size, conversion);
+    });
+    imageThread->setObjectName(QStringLiteral("MatrixImage"));
+    connect(imageThread, &QThread::finished, this, &MatrixZone::onImageConverted);
+    imageThread->start(QThread::LowPriority);
+}
+
+void MatrixZone::onImageConverted()
+{
+    imageThread->wait();
+    delete imageThread;
+    imageThread = nullptr;
+
+    if (imageConversionStale) {
+        startImageConversion();
+        return;
+    }
+
+    if (!conversionError.isEmpty()) {
+        qWarning().noquote() << QStringLiteral("MatrixZone: %1").arg(conversionError);
+        conversionError.clear();
+    }
+    std::swap(image, convertedImage);
+    convertedImage = LedImage();
+    if (currentMode == Image) {
+        startImagePlayback();
+        markDirty(true);
+    }
+}
+
+bool MatrixZone::openVideo(const QString &path, const QSize &frameSize, QString *errorMessage)
+{
+    auto *feed = new VideoFeed(frameSize, this);
+    feed->setTargetSize(zoneArea.size());
+    feed->setConversion(imageConversion);
+    connect(feed, &VideoFeed::frameAvailable, this, &MatrixZone::onVideoFrame);
+    connect(feed, &VideoFeed::finished, this, &MatrixZone::onVideoFinished);
+    if (!feed->start(path, errorMessage)) {
+        delete feed;
+        return false;
+    }
+
+    // Le flux précédent est arrêté avant le changement de mode, qui ne doit pas arrêter le nouveau
+    setDisplayMode(Video);
+    delete videoFeed;
+    videoFeed = feed;
+    videoCodes.clear();
+    videoCodesSize = QSize();
+    markDirty(true);
+    return true;
+}
+
+VideoFeed::Statistics MatrixZone::videoStatistics() const
+{
+    return videoFeed ? videoFeed->statistics() : VideoFeed::Statistics();
+}
+
+void MatrixZone::onVideoFrame()
+{
+    // Signal d'un flux déjà remplacé ou arrêté : rien à reprendre
+    if (!videoFeed || sender() != videoFeed)
+        return;
+    // En veille, les images converties se remplacent sans être reprises ; resume() reprend la dernière
+    if (suspended)
+        return;
+    if (videoFeed->takeFrame(&videoCodes, &videoCodesSize))
+        markDirty(false);
+}
+
+void MatrixZone::onVideoFinished(const QString &errorMessage)
+{
+    if (!videoFeed || sender() != videoFeed)
+        return;
+    emit videoFinished(errorMessage, videoFeed->statistics());
+}
+
+void MatrixZone::startImagePlayback()
+{
+    imageStartMs = clock->elapsedMs();
+    imageFrameIndex = 0;
+    // Période fixe, la plus courte des images : le timer n'est jamais reprogrammé pendant la lecture
+    timer->stop();
+    if (image.frameCount() > 1 && !suspended)
+        timer->start(image.shortestFrameMs());
+}
+
+void MatrixZone::setColor(const QColor &color)
+{
+    if (pixelColor == color)
+        return;
+
+    pixelColor = color;
+    markDirty(false);
+}
+
+void MatrixZone::setDisplayMode(DisplayMode mode)
+{
+    if (currentMode == mode)
+        return;
+
+    currentMode = mode;
+    timer->stop();
+    clockTimer->stop();
+    clearTicker();
+    if (currentMode != Video && videoFeed) {
+        delete videoFeed;
+        videoFeed = nullptr;
+        videoCodes.clear();
+        videoCodesSize = QSize();
+    }
+
+    if (currentMode == Clock) {
+        scrollEnabled = false;
+        scrollOffset = 0;
+        clockColumns.fill(0);
+        onTimeout();
+    } else if (currentMode == Ticker) {
+        // La bande est vide : le défilement démarre au premier appendText()
+    } else if (currentMode == Image) {
+        // Zone redimensionnée hors du mode Image : les images sont reconverties
+        if (!image.isEmpty() && image.size() != zoneArea.size())
+            startImageConversion();
+        startImagePlayback();
+    } else {
+        restartScrollIfNeeded();
+    }
+    markDirty(true);
+}
+
+void MatrixZone::setScrollMode(ScrollMode mode)
+{
+    if (scrollMode == mode)
+        return;
+
+    scrollMode = mode;
+    scrollOffset = 0;
+    scrollDirection = 1;
+    restartScrollIfNeeded();
+    markDirty(false);
+}
+
+void MatrixZone::setScrollEnabled(bool enabled)
+{
+    bool allowScroll = enabled && currentMode == Text;
+
+    if (scrollEnabled == allowScroll)
+        return;
+
+    scrollEnabled = allowScroll;
+    scrollOffset = 0;
+    scrollDirection = 1;
+
+    if (currentMode == Text) {
+        timer->stop();
+        if (scrollEnabled) {
+            restartScrollIfNeeded();
+        }
+    }
+    markDirty(false);
+}
+
+void MatrixZone::setScrollInterval(int speed)
+{
+    if (speed <= 0) {
+        return;
+    }
+
+    scrollIntervalMs = static_cast<int>(2.0f / speed * defaultScrollIntervalMs);
+    // Nouvelle vitesse : le défilement en cours repart de sa position courante ; une bande
+    // au repos reste au repos, son prochain ajout la relance
+    if (scrollStartMs >= 0) {
+        scrollStartMs = clock->elapsedMs();
+        scrollSteps = 0;
+    }
+    if (timer->isActive()) {
+        timer->start(scrollIntervalMs);
+    }
+}
+
+void MatrixZone::setClockShowSeconds(bool enabled)
+{
+    if (clockShowSeconds == enabled)
+        return;
+
+    clockShowSeconds = enabled;
+    if (currentMode == Clock) {
+        onTimeout();
+    }
+}
+
+void MatrixZone::setClockFormat(ClockFormat format)
+{
+    if (clockFormat == format)
+        return;
+
+    clockFormat = format;
+    if (currentMode == Clock) {
+        onTimeout();
+    }
+}
+
+void MatrixZone::restartScroll()
+{
+    if (currentMode == Text) {
+        restartScrollIfNeeded();
+    }
+    onTimeout();
+    markDirty(false);
+}
+
+void MatrixZone::restartScrollIfNeeded()
+{
+    // Le bandeau ne repart jamais du début : il continue depuis sa position
+    if (currentMode == Ticker)
+        return;
+
+    timer->stop();
+    scrollOffset = 0;
+    scrollDirection = 1;
+
+    if (currentMode != Text || !scrollEnabled)
+        return;
+
+    if (textGlyphs.isEmpty())
+        return;
+
+    // Le défilement est daté : en veille, il sera recalé sur ce départ à la reprise
+    scrollStartMs = clock->elapsedMs();
+    scrollSteps = 0;
+    if (suspended)
+        return;
+
+    timer->start(scrollIntervalMs);
+}
+
+void MatrixZone::suspend()
+{
+    if (suspended)
+        return;
+
+    suspended = true;
+    timer->stop();
+    clockTimer->stop();
+}
+
+void MatrixZone::resume()
+{
+    if (!suspended)
+        return;
+
+    suspended = false;
+    // Reprise : onTimeout() rattrape le défilement correspondant au temps passé en veille
+    if ((currentMode == Text && scrollEnabled && !textGlyphs.isEmpty())
+        || (currentMode == Ticker && scrollStartMs >= 0)
+        || (currentMode == Image && image.frameCount() > 1)) {
+        timer->start(scrollIntervalMs);
+    }
+    if (currentMode == Video && videoFeed && videoFeed->takeFrame(&videoCodes, &videoCodesSize))
+        markDirty(false);
+    onTimeout();
+}
+
+void MatrixZone::onTimerWakeup()
+{
+    emit timerWokeUp();
+    onTimeout();
+}
+
+void MatrixZone::onTimeout()
+{
+    MATRIX_TRACE_SCOPE("MatrixZone::onTimeout");
+    if (suspended)
+        return;
+
+    if (currentMode == Clock) {
+        const QTime now = clock->currentTime();
+        if (updateClockColumns(now)) {
+            markDirty(false);
+        }
+        scheduleClockTick(now);
+
+    } else if (currentMode == Image) {
+        advanceImage();
+
+    } else if (((currentMode == Text && scrollEnabled) || currentMode == Ticker) && scrollStartMs >= 0) {
+        // Position calculée depuis le départ du défilement, pas au nombre de réveils :
+        // un réveil retardé (thread GUI occupé) rattrape les colonnes manquées
+        const qint64 dueSteps = (clock->elapsedMs() - scrollStartMs) / std::max(1, scrollIntervalMs);
+        if (dueSteps > scrollSteps) {
+            const qint64 steps = dueSteps - scrollSteps;
+            scrollSteps = dueSteps;
+            if (currentMode == Ticker)
+                advanceTicker(steps);
+            else
+                advanceScroll(steps);
+            markDirty(false);
+        }
+    }
+}
+
+void MatrixZone::advanceScroll(qint64 steps)
+{
+    if (steps <= 0)
+        return;
+
+    const int textCols = textWidthInCols();
+    const int zoneCols = zoneArea.width();
+
+    if (scrollMode == bounceMode) {
+        const int bounceRange = std::abs(textCols - zoneCols);
+        if (bounceRange <= 0) {
+            scrollOffset = 0;
+            scrollDirection = 1;
+            return;
+        }
+
+        // Un aller-retour complet dure 2 * bounceRange pas : la position est calculée
+        // directement sur ce cycle, en temps constant quelle que soit la longueur du texte
+        const qint64 cycleSteps = 2 * static_cast<qint64>(bounceRange);
+        const int offset = std::min(scrollOffset, bounceRange);
+        qint64 phase = scrollDirection > 0 ? offset : cycleSteps - offset;
+        phase = (phase + steps) % cycleSteps;
+        if (phase < bounceRange) {
+            scrollOffset = static_cast<int>(phase);
+            scrollDirection = 1;
+        } else {
+            scrollOffset = static_cast<int>(cycleSteps - phase);
+            scrollDirection = -1;
+        }
+    } else {
+        const qint64 wrapWidth = textCols + zoneCols;
+        if (wrapWidth > 0) {
+            scrollOffset = static_cast<int>((scrollOffset + steps) % wrapWidth);
+        }
+    }
+}
+
+void MatrixZone::advanceTicker(qint64 steps)
+{
+    // Les colonnes sorties par la gauche sont libérées ; une fois la bande entièrement
+    // sortie, le défilement s'arrête jusqu'au prochain ajout (aucun réveil inutile)
+    tickerPosition = std::min(tickerPosition + steps, tickerTail);
+    tickerHead = std::max(tickerHead, tickerPosition);
+    if (tickerPosition >= tickerTail) {
+        timer->stop();
+        scrollStartMs = -1;
+    }
+}
+
+void MatrixZone::advanceImage()
+{
+    if (imageStartMs < 0 || image.frameCount() <= 1)
+        return;
+
+    // Image choisie d'après le temps écoulé : un réveil retardé ne décale pas l'animation
+    const int index = image.frameAt(clock->elapsedMs() - imageStartMs);
+    if (index != imageFrameIndex) {
+        imageFrameIndex = index;
+        markDirty(false);
+    }
+}
+
+bool MatrixZone::updateClockColumns(const QTime &now)
+{
+    int hour = now.hour();
+    bool blankLeadingDigit = false;
+    if (clockFormat == Format12h) {
+        hour %= 12;
+        if (hour == 0)
+            hour = 12;
+        blankLeadingDigit = hour < 10;
+    }
+
+    // Le séparateur clignote : il est éteint sur les secondes paires
+    const char separator = (now.second() % 2 == 0) ? ' ' : ':';
+    // Avec les secondes, le séparateur est réduit à ses colonnes centrales pour tenir sur la grille
+    const int separatorCols = clockShowSeconds ? kCompactSeparatorCols : CHAR_COLS;
+
+    char glyphs[8];
+    int widths[8];
+    int count = 0;
+    auto push = [&](char c, int width) {
+        glyphs[count] = c;
+        widths[count] = width;
+        ++count;
+    };
+
+    push(blankLeadingDigit ? ' ' : static_cast<char>('0' + hour / 10), CHAR_COLS);
+    push(static_cast<char>('0' + hour % 10), CHAR_COLS);
+    push(separator, separatorCols);
+    push(static_cast<char>('0' + now.minute() / 10), CHAR_COLS);
+    push(static_cast<char>('0' + now.minute() % 10), CHAR_COLS);
+    if (clockShowSeconds) {
+        push(separator, separatorCols);
+        push(static_cast<char>('0' + now.second() / 10), CHAR_COLS);
+        push(static_cast<char>('0' + now.second() % 10), CHAR_COLS);
+    }
+
+    int totalCols = 0;
+    for (int i = 0; i < count; ++i)
+        totalCols += widths[i];
+
+    const int zoneCols = nextClockColumns.size();
+    nextClockColumns.fill(0);
+    int col = (zoneCols - totalCols) / 2;
+    for (int i = 0; i < count; ++i) {
+        const GlyphColumns *glyph = glyphColumns(glyphs[i]);
+        const int firstCol = (CHAR_COLS - widths[i]) / 2;
+        if (glyph) {
+            for (int k = 0; k < widths[i]; ++k) {
+                const int target = col + k;
+                if (target >= 0 && target < zoneCols)
+                    nextClockColumns[target] = (*glyph)[firstCol + k];
+            }
+        }
+        col += widths[i];
+    }
+
+    if (nextClockColumns == clockColumns)
+        return false;
+
+    std::swap(clockColumns, nextClockColumns);
+    return true;
+}
+
+void MatrixZone::scheduleClockTick(const QTime &now)
+{
+    // Réveil juste après chaque frontière de seconde. Une fois calé, le timer précis
+    // se répète sans dérive : il n'est pas reprogrammé (ni alloué) à chaque seconde.
+    if (now.msec() < kClockPhaseToleranceMs) {
+        if (!clockTimer->isActive() || clockTimer->interval() != 1000)
+            clockTimer->start(1000);
+        return;
+    }
+    clockTimer->start(1000 - now.msec() + kClockWakeupSlackMs);
+}
+
+int MatrixZone::textWidthInCols() const
+{
+    return textGlyphs.size() * CHAR_COLS;
+}
+
+int MatrixZone::inkRunAt(int index) const
+{
+    // Dernière plage commençant au plus tard à index
+    const auto it = std::upper_bound(inkRuns.cbegin(), inkRuns.cend(), index,
+                                     [](int value, const InkRun &run) { return value < run.start; });
+    return std::max(0, static_cast<int>(it - inkRuns.cbegin()) - 1);
+}
+
+void MatrixZone::invalidate()
+{
+    dirty = true;
+}
+
+void MatrixZone::markDirty(bool contentChanged)
+{
+    dirty = true;
+    emit changed(contentChanged);
+}
+
+const LedFrame &MatrixZone::frame()
+{
+    if (dirty) {
+        rasterize();
+        dirty = false;
+    }
+    return zoneFrame;
+}
+
+void MatrixZone::rasterize()
+{
+    MATRIX_TRACE_SCOPE("MatrixZone::rasterize");
+    if (zoneFrame.inkDepth() != palette->depth())
+        zoneFrame.setInkDepth(palette->depth());
+    zoneFrame.clear();
+    const int zoneCols = zoneFrame.cols();
+    const int glyphRow = (zoneFrame.rows() - CHAR_ROWS) / 2;
+    const quint8 zoneInk = palette->entryFor(pixelColor.rgb());
+
+    if (currentMode == Clock) {
+        for (int col = 0; col < zoneCols && col < clockColumns.size(); ++col) {
+            zoneFrame.drawColumnMask(col, glyphRow, clockColumns[col], LedFrame::FullLevel, zoneInk);
+        }
+        return;
+    }
+
+    if (currentMode == Ticker) {
+        rasterizeTicker(zoneInk);
+        return;
+    }
+
+    if (currentMode == Image) {
+        // Conversion en cours pour de nouvelles dimensions : la zone reste éteinte
+        if (!image.isEmpty())
+            rasterizeCodes(image.frame(std::min(imageFrameIndex, image.frameCount() - 1)), image.size(), zoneInk);
+        return;
+    }
+
+    if (currentMode == Video) {
+        rasterizeCodes(videoCodes, videoCodesSize, zoneInk);
+        return;
+    }
+
+    if (textGlyphs.isEmpty())
+        return;
+
+    // Position de la première colonne du texte, en colonnes de LED
+    const int textCols = textWidthInCols();
+    int origin = static_cast<int>(std::lround((zoneCols - textCols) / 2.0f));
+    if (scrollEnabled) {
+        if (scrollMode == bounceMode) {
+            if (textCols >= zoneCols) {
+                // Ajout de 2 colonnes de marge pour voir entièrement le premier caractère
+                origin = 2 - scrollOffset;
+            } else {
+                origin = scrollOffset;
+            }
+        } else {
+            origin = zoneCols - scrollOffset;
+        }
+    }
+
+    // Plage des caractères visibles, calculée directement depuis l'origine :
+    // le coût d'une image ne dépend pas de la longueur du message
+    const int numChars = textGlyphs.size();
+    const int firstChar = origin < 0 ? std::min(numChars, -origin / CHAR_COLS) : 0;
+    const int endChar = zoneCols > origin
+                            ? std::min(numChars, (zoneCols - origin + CHAR_COLS - 1) / CHAR_COLS)
+                            : 0;
+    if (firstChar >= endChar)
+        return;
+
+    // Encres de l'arc-en-ciel : une teinte par tranche du texte, résolues une seule fois
+    quint8 rainbowInks[kRainbowSteps];
+    bool rainbowResolved = false;
+
+    const GlyphTable &table = glyphTable();
+    const char *glyphs = textGlyphs.constData();
+    int run = inkRuns.isEmpty() ? -1 : inkRunAt(firstChar);
+    for (int i = firstChar; i < endChar; ++i) {
+        while (run >= 0 && run + 1 < inkRuns.size() && inkRuns[run + 1].start <= i)
+            ++run;
+
+        const auto glyphIndex = static_cast<unsigned char>(glyphs[i]);
+        if (!table.defined[glyphIndex])
+            continue;
+        const GlyphColumns &glyph = table.columns[glyphIndex];
+
+        const TextInk textInk = run >= 0 ? inkRuns[run].ink : TextInk();
+        quint8 ink = zoneInk;
+        if (textInk.kind == TextInk::Fixed) {
+            ink = palette->entryFor(textInk.rgb);
+        } else if (textInk.kind == TextInk::Rainbow && !rainbowResolved) {
+            for (int step = 0; step < kRainbowSteps; ++step) {
+                rainbowInks[step] = palette->entryFor(QColor::fromHsv(step * 360 / kRainbowSteps, 255, 255).rgb());
+            }
+            rainbowResolved = true;
+        }
+
+        const int charStart = origin + i * CHAR_COLS;
+        for (int col = 0; col < CHAR_COLS; ++col) {
+            if (textInk.kind == TextInk::Rainbow) {
+                // Le dégradé suit le texte : la teinte dépend de la colonne dans le message
+                ink = rainbowInks[(static_cast<qint64>(i) * CHAR_COLS + col) * kRainbowSteps / textCols];
+            }
+            zoneFrame.drawColumnMask(charStart + col, glyphRow, glyph[col], LedFrame::FullLevel, ink);
+        }
+    }
+}
+
+void MatrixZone::rasterizeTicker(quint8 zoneInk)
+{
+    const int glyphRow = (zoneFrame.rows() - CHAR_ROWS) / 2;
+    const qint64 first = std::max(tickerHead, tickerPosition);
+    const qint64 end = std::min(tickerTail, tickerPosition + zoneFrame.cols());
+    const qint64 ringMask = tickerMasks.size() - 1;
+    const quint8 *masks = tickerMasks.constData();
+    const QRgb *colors = tickerColors.constData();
+
+    // Les colonnes voisines partagent presque toujours la même couleur : une seule recherche par changement
+    QRgb lastRgb = kTickerZoneColor;
+    quint8 ink = zoneInk;
+    for (qint64 column = first; column < end; ++column) {
+        const qint64 slot = column & ringMask;
+        if (masks[slot] == 0)
+            continue;
+        if (colors[slot] != lastRgb) {
+            lastRgb = colors[slot];
+            ink = lastRgb == kTickerZoneColor ? zoneInk : palette->entryFor(lastRgb);
+        }
+        zoneFrame.drawColumnMask(static_cast<int>(column - tickerPosition), glyphRow, masks[slot],
+                                 LedFrame::FullLevel, ink);
+    }
+}
+
+void MatrixZone::rasterizeCodes(const QByteArray &codes, const QSize &size, quint8 zoneInk)
+{
+    if (size != QSize(zoneFrame.cols(), zoneFrame.rows()) || codes.size() != size.width() * size.height())
+        return;
+
+    const char *leds = codes.constData();
+    quint8 *levels = zoneFrame.data();
+
+    // Encres résolues au premier usage de chaque code : au plus neuf recherches dans la palette
+    quint8 inks[LedImage::CodeCount];
+    bool resolved[LedImage::CodeCount] = {};
+    for (int index = 0; index < codes.size(); ++index) {
+        const auto code = static_cast<quint8>(leds[index]);
+        if (code == 0)
+            continue;
+        if (!resolved[code]) {
+            inks[code] = code == LedImage::ZoneColorCode ? zoneInk : palette->entryFor(LedImage::codeColor(code));
+            resolved[code] = true;
+        }
+        levels[index] = LedFrame::FullLevel;
+        zoneFrame.setInkAt(index, inks[code]);
+    }
+}
@@ -0,0 +1,208 @@
+/**
+ * @file powerlimiter.cpp
+ * @author G. Maxime
+ * @brief Implémentation de l'estimation du courant des LED et de la limitation de luminosité.
+ */
+
+// Inclusion de mes headers
+#include "headers/powerlimiter.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QtAlgorithms>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr quint64 kLowBits = 0x7F7F7F7F7F7F7F7FULL;
+constexpr quint64 kHighBits = 0x8080808080808080ULL;
+constexpr quint64 kEvenBytes = 0x00FF00FF00FF00FFULL;
+
+/**
+ * @brief Masque des LED allumées d'un mot de 8 intensités : bit de poids fort de chaque octet non nul.
+ */
+inline quint64 litMask(quint64 word)
+{
+    return (((word & kLowBits) + kLowBits) | word) & kHighBits;
+}
+
+/**
+ * @brief Somme des 8 intensités d'un mot (au plus 2040).
+ */
+inline quint32 levelSum(quint64 word)
+{
+    const quint64 pairs = (word & kEvenBytes) + ((word >> 8) & kEvenBytes);
+    return static_cast<quint32>((pairs * 0x0001000100010001ULL) >> 48);
+}
+
+/**
+ * @brief Atténuation : out = level * factor / 256.
+ * @param factor Facteur de luminosité, de 0 à 256.
+ */
+void scaleLevels(quint8 *levels, int count, int factor)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i scale = _mm_set1_epi16(static_cast<short>(factor));
+    for (; i + 16 <= count; i += 16) {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(levels + i));
+        const __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(value, zero), scale), 8);
+        const __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(value, zero), scale), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(levels + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; ++i)
+        levels[i] = static_cast<quint8>((levels[i] * factor) >> 8);
+}
+
+} // namespace
+
+void PowerLimiter::setEnabled(bool enabled)
+{
+    if (this->enabled == enabled)
+        return;
+
+    this->enabled = enabled;
+    brightness = 256;
+    recovering = false;
+    lastApplyMs = -1;
+}
+
+void PowerLimiter::setBudget(double ledCurrentMa, double limitMa)
+{
+    this->ledCurrentMa = std::max(0.0, ledCurrentMa);
+    this->limitMa = std::max(0.0, limitMa);
+}
+
+void PowerLimiter::updateWeights(const LedPalette &palette)
+{
+    const int count = std::min(palette.size(), static_cast<int>(inkWeights.size()));
+    bool changed = count != weightedColorCount;
+    for (int index = 0; index < count && !changed; ++index)
+        changed = palette.color(index) != weightedColors[static_cast<size_t>(index)];
+    if (!changed)
+        return;
+
+    inkWeights.fill(0);
+    for (int index = 0; index < count; ++index) {
+        const QRgb color = palette.color(index);
+        weightedColors[static_cast<size_t>(index)] = color;
+        inkWeights[static_cast<size_t>(index)] = static_cast<quint16>(qRed(color) + qGreen(color) + qBlue(color));
+    }
+    weightedColorCount = count;
+}
+
+quint64 PowerLimiter::weightedLevels(const LedFrame &frame, const std::array<quint16, 256> &inkWeights, int *litLeds)
+{
+    const quint8 *levels = frame.data();
+    const int count = frame.ledCount();
+    const bool hasInks = frame.inkDepth() != 0;
+    quint64 weighted = 0;
+    quint64 uniformLevels = 0;
+    int lit = 0;
+
+    int index = 0;
+    for (; index + 8 <= count; index += 8) {
+        quint64 word;
+        std::memcpy(&word, levels + index, sizeof(word));
+        // Mots éteints sautés : le cas courant d'un texte sur fond noir
+        if (word == 0)
+            continue;
+        quint64 mask = litMask(word);
+        lit += qPopulationCount(mask);
+        if (!hasInks) {
+            uniformLevels += levelSum(word);
+            continue;
+        }
+        while (mask) {
+            const int led = index + static_cast<int>(qCountTrailingZeroBits(mask) >> 3);
+            weighted += static_cast<quint64>(levels[led]) * inkWeights[frame.inkAt(led)];
+            mask &= mask - 1;
+        }
+    }
+    for (; index < count; ++index) {
+        if (levels[index] == 0)
+            continue;
+        ++lit;
+        if (hasInks)
+            weighted += static_cast<quint64>(levels[index]) * inkWeights[frame.inkAt(index)];
+        else
+            uniformLevels += levels[index];
+    }
+
+    if (litLeds)
+        *litLeds = lit;
+    // Sans plan d'encre, toutes les LED ont la couleur de l'indice 0
+    return weighted + uniformLevels * inkWeights[0];
+}
+
+const LedFrame &PowerLimiter::apply(const LedFrame &frame, const LedPalette &palette, qint64 nowMs)
+{
+    if (!enabled || ledCurrentMa <= 0.0)
+        return frame;
+
+    updateWeights(palette);
+    int lit = 0;
+    const quint64 weighted = weightedLevels(frame, inkWeights, &lit);
+    const double requested = static_cast<double>(weighted) * ledCurrentMa / (255.0 * 765.0);
+
+    // Réduction immédiate, remontée progressive : la limite n'est jamais dépassée
+    int needed = 256;
+    if (limitMa > 0.0 && requested > limitMa)
+        needed = static_cast<int>(std::floor(limitMa / requested * 256.0));
+    const qint64 elapsedMs = lastApplyMs < 0 ? ReleaseMs : std::max<qint64>(0, nowMs - lastApplyMs);
+    const int released = brightness + static_cast<int>(std::min<qint64>(256, elapsedMs * 256 / ReleaseMs));
+    brightness = std::clamp(std::min(needed, released), 0, 256);
+    recovering = brightness < std::min(needed, 256);
+    lastApplyMs = nowMs;
+
+    stats.frames += 1;
+    stats.litLeds = lit;
+    stats.requestedMa = requested;
+    stats.brightness = brightness / 256.0;
+    stats.deliveredMa = requested * brightness / 256.0;
+    stats.peakRequestedMa = std::max(stats.peakRequestedMa, requested);
+    stats.peakDeliveredMa = std::max(stats.peakDeliveredMa, stats.deliveredMa);
+    requestedTotalMa += requested;
+    if (brightness >= 256)
+        return frame;
+
+    ++stats.limitedFrames;
+    limitedFrame = frame;
+    scaleLevels(limitedFrame.data(), limitedFrame.ledCount(), brightness);
+    return limitedFrame;
+}
+
+PowerLimiter::Statistics PowerLimiter::statistics() const
+{
+    Statistics result = stats;
+    result.averageRequestedMa = stats.frames > 0 ? requestedTotalMa / static_cast<double>(stats.frames) : 0.0;
+    return result;
+}
+
+void PowerLimiter::reset()
+{
+    stats = Statistics();
+    stats.brightness = brightness / 256.0;
+    requestedTotalMa = 0.0;
+}
+
+QString PowerLimiter::summary(const Statistics &statistics)
+{
+    QString line = QStringLiteral("%1 frames, requested avg %2 mA, peak %3 mA, delivered peak %4 mA")
+                       .arg(statistics.frames)
+                       .arg(statistics.averageRequestedMa, 0, 'f', 0)
+                       .arg(statistics.peakRequestedMa, 0, 'f', 0)
+                       .arg(statistics.peakDeliveredMa, 0, 'f', 0);
+    if (statistics.limitedFrames > 0)
+        line += QStringLiteral(", %1 frames dimmed").arg(statistics.limitedFrames);
+    return line;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file renderthread.cpp
+ * @author G. Maxime
+ * @brief Implémentation du thread de rendu de la matrice.
+ */
+
+// Inclusion de mes headers
+#include "headers/renderthread.h"
+#include "headers/trace.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QThread>
+#include <QPainter>
+#include <QMutexLocker>
+#include <QMetaObject>
+#include <QElapsedTimer>
+
+// Inclusion des headers standard nécessaires
+#include <utility>
+
+RenderThread::RenderThread(QObject *parent)
+    : QObject(parent)
+{
+    thread = QThread::create([this]() { run(); });
+    thread->setObjectName(QStringLiteral("MatrixRender"));
+    thread->start();
+}
+
+RenderThread::~RenderThread()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        wakeCondition.wakeOne();
+    }
+    thread->wait();
+    delete thread;
+}
+
+void RenderThread::submit(const RenderSnapshot &snapshot)
+{
+    QMutexLocker locker(&mutex);
+    pending = snapshot;
+    hasPending = true;
+    wakeCondition.wakeOne();
+}
+
+bool RenderThread::drawLatest(QPainter &painter)
+{
+    // Le verrou empêche seulement l'échange pendant la copie : le thread de rendu
+    // ne dessine jamais dans l'image avant
+    QMutexLocker locker(&mutex);
+    if (frontIndex < 0)
+        return false;
+    painter.drawImage(QPointF(0, 0), images[frontIndex]);
+    return true;
+}
+
+bool RenderThread::drawLatest(QPainter &painter, const QRectF &target, const QRectF &source)
+{
+    QMutexLocker locker(&mutex);
+    if (frontIndex < 0)
+        return false;
+    const QImage &image = images[frontIndex];
+    const qreal dpr = image.devicePixelRatio();
+    painter.drawImage(target, image, QRectF(source.topLeft() * dpr, source.size() * dpr));
+    return true;
+}
+
+QSize RenderThread::latestSize()
+{
+    QMutexLocker locker(&mutex);
+    if (frontIndex < 0)
+        return QSize();
+    const QImage &image = images[frontIndex];
+    return (QSizeF(image.size()) / image.devicePixelRatio()).toSize();
+}
+
+quint64 RenderThread::latestSequence()
+{
+    QMutexLocker locker(&mutex);
+    return frontSequence;
+}
+
+qint64 RenderThread::lastRenderTime() const
+{
+    return lastRenderNs.load(std::memory_order_relaxed);
+}
+
+void RenderThread::deliverFrame()
+{
+    readyPending.store(false, std::memory_order_release);
+    emit frameReady();
+}
+
+void RenderThread::run()
+{
+    RenderSnapshot snapshot;
+    for (;;) {
+        int backIndex = 0;
+        {
+            QMutexLocker locker(&mutex);
+            while (!hasPending && !stopping) {
+                wakeCondition.wait(&mutex);
+            }
+            if (stopping)
+                return;
+            std::swap(snapshot, pending);
+            hasPending = false;
+            backIndex = frontIndex == 0 ? 1 : 0;
+        }
+
+        QElapsedTimer renderTimer;
+        renderTimer.start();
+        renderSnapshot(snapshot, &images[backIndex]);
+        lastRenderNs.store(snapshot.drawMatrix ? renderTimer.nsecsElapsed() : 0, std::memory_order_relaxed);
+
+        {
+            QMutexLocker locker(&mutex);
+            frontIndex = backIndex;
+            frontSequence = snapshot.sequence;
+        }
+        // Un seul événement en attente, quel que soit le retard du thread GUI
+        if (!readyPending.exchange(true, std::memory_order_acq_rel)) {
+            QMetaObject::invokeMethod(this, &RenderThread::deliverFrame, Qt::QueuedConnection);
+        }
+    }
+}
+
+void RenderThread::renderSnapshot(const RenderSnapshot &snapshot, QImage *image)
+{
+    MATRIX_TRACE_SCOPE("RenderThread::renderSnapshot");
+    const QSize pixelSize = (QSizeF(snapshot.size) * snapshot.devicePixelRatio).toSize();
+    if (image->size() != pixelSize) {
+        *image = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+    }
+    image->setDevicePixelRatio(snapshot.devicePixelRatio);
+
+    QPainter painter(image);
+    painter.fillRect(QRectF(QPointF(0, 0), QSizeF(snapshot.size)), snapshot.background);
+    if (snapshot.drawMatrix) {
+        renderer.paint(painter, snapshot.frame, snapshot.palette, snapshot.matrixRect, snapshot.cellSize,
+                       snapshot.quality, snapshot.style);
+    }
+}
@@ -0,0 +1,262 @@
+/**
+ * @file sharedframe.cpp
+ * @author G. Maxime
+ * @brief Implémentation de la publication du plan des LED en mémoire partagée.
+ */
+
+// Inclusion de mes headers
+#include "headers/sharedframe.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QDebug>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Signature du segment (« MXLF ») et version du format.
+ */
+constexpr quint32 kMagic = 0x464C584D;
+constexpr quint32 kVersion = 1;
+
+/**
+ * @brief Nombre maximal de couleurs de palette (indices 8 bits).
+ */
+constexpr int kPaletteEntries = 256;
+
+static_assert(std::atomic<quint64>::is_always_lock_free,
+              "the generation counter must be lock-free to be shared between processes");
+
+/**
+ * @brief En-tête du segment, suivi des intensités puis du plan d'encre.
+ * Les champs placés après generation ne sont cohérents que si generation est
+ * pair et identique avant et après leur lecture.
+ */
+struct SharedFrameHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 capacityLeds;
+    quint32 reserved;
+    std::atomic<quint64> generation;
+    quint64 frameNumber;
+    qint64 publishNs;
+    quint64 hash;
+    qint32 cols;
+    qint32 rows;
+    qint32 inkBits;
+    qint32 paletteSize;
+    quint32 palette[kPaletteEntries];
+};
+
+/**
+ * @brief Taille du segment pour un nombre maximal de LED (intensités et encres 8 bits).
+ */
+int segmentBytes(int maxLeds)
+{
+    return static_cast<int>(sizeof(SharedFrameHeader)) + 2 * maxLeds;
+}
+
+/**
+ * @brief Taille du plan d'encre pour des dimensions et une profondeur données.
+ */
+int inkBytesFor(int leds, int inkBits)
+{
+    return inkBits == 8 ? leds : (inkBits == 4 ? (leds + 1) / 2 : 0);
+}
+
+} // namespace
+
+SharedFramePublisher::SharedFramePublisher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SharedFramePublisher::~SharedFramePublisher()
+{
+    if (memory.isAttached())
+        memory.detach();
+}
+
+bool SharedFramePublisher::open(const QString &key, int maxLeds, QString *errorMessage)
+{
+    if (memory.isAttached())
+        memory.detach();
+
+    memory.setKey(key);
+    const int bytes = segmentBytes(maxLeds);
+    if (!memory.create(bytes)) {
+        // Segment laissé par un processus arrêté : on s'y attache pour le libérer, puis on le recrée
+        if (memory.error() == QSharedMemory::AlreadyExists && memory.attach()) {
+            memory.detach();
+            memory.create(bytes);
+        }
+        if (!memory.isAttached()) {
+            *errorMessage = QStringLiteral("Cannot create shared frame %1: %2").arg(key, memory.errorString());
+            return false;
+        }
+    }
+
+    std::memset(memory.data(), 0, static_cast<size_t>(bytes));
+    auto *header = new (memory.data()) SharedFrameHeader;
+    header->magic = kMagic;
+    header->version = kVersion;
+    header->capacityLeds = static_cast<quint32>(maxLeds);
+    header->generation.store(0, std::memory_order_release);
+    capacityLeds = maxLeds;
+    frameCount = 0;
+    oversizeReported = false;
+    return true;
+}
+
+QString SharedFramePublisher::key() const
+{
+    return memory.isAttached() ? memory.key() : QString();
+}
+
+quint64 SharedFramePublisher::publishedFrames() const
+{
+    return frameCount;
+}
+
+void SharedFramePublisher::publish(const LedFrame &frame, const LedPalette &palette)
+{
+    if (!memory.isAttached())
+        return;
+    if (frame.ledCount() > capacityLeds) {
+        if (!oversizeReported) {
+            qWarning().noquote() << QStringLiteral("SharedFrame: %1x%2 LEDs exceed the %3 LEDs of %4, frames are not published")
+                                        .arg(frame.cols()).arg(frame.rows()).arg(capacityLeds).arg(memory.key());
+            oversizeReported = true;
+        }
+        return;
+    }
+
+    auto *header = static_cast<SharedFrameHeader *>(memory.data());
+    auto *levels = static_cast<quint8 *>(memory.data()) + sizeof(SharedFrameHeader);
+    quint8 *inks = levels + capacityLeds;
+
+    // Génération impaire pendant l'écriture : les lecteurs qui la voient recommencent
+    const quint64 generation = header->generation.load(std::memory_order_relaxed);
+    header->generation.store(generation + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    header->frameNumber = ++frameCount;
+    header->publishNs = SharedFrameReader::clockNs();
+    header->hash = frame.hash();
+    header->cols = frame.cols();
+    header->rows = frame.rows();
+    header->inkBits = frame.inkDepth();
+    const int paletteSize = std::min(palette.size(), kPaletteEntries);
+    header->paletteSize = paletteSize;
+    for (int index = 0; index < paletteSize; ++index) {
+        header->palette[index] = palette.color(index);
+    }
+    std::memcpy(levels, frame.data(), static_cast<size_t>(frame.ledCount()));
+    std::memcpy(inks, frame.inkData(), static_cast<size_t>(frame.inkBytes()));
+
+    header->generation.store(generation + 2, std::memory_order_release);
+}
+
+qint64 SharedFrameReader::clockNs()
+{
+    // steady_clock : CLOCK_MONOTONIC sous Linux, commune à tous les processus
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool SharedFrameReader::attach(const QString &key, QString *errorMessage)
+{
+    if (memory.isAttached())
+        memory.detach();
+
+    memory.setKey(key);
+    if (!memory.attach(QSharedMemory::ReadOnly)) {
+        *errorMessage = QStringLiteral("Cannot attach to shared frame %1: %2").arg(key, memory.errorString());
+        return false;
+    }
+    const auto *header = static_cast<const SharedFrameHeader *>(memory.constData());
+    if (memory.size() < static_cast<qsizetype>(sizeof(SharedFrameHeader)) || header->magic != kMagic
+        || header->version != kVersion
+        || memory.size() < static_cast<qsizetype>(segmentBytes(static_cast<int>(header->capacityLeds)))) {
+        *errorMessage = QStringLiteral("Shared frame %1 has an unknown format").arg(key);
+        memory.detach();
+        return false;
+    }
+    lastGeneration = 0;
+    retryCount = 0;
+    return true;
+}
+
+bool SharedFrameReader::hasNewFrame() const
+{
+    if (!memory.isAttached())
+        return false;
+    const auto *header = static_cast<const SharedFrameHeader *>(memory.constData());
+    const quint64 generation = header->generation.load(std::memory_order_acquire);
+    return generation != lastGeneration && (generation & 1) == 0;
+}
+
+bool SharedFrameReader::read(LedFrame *frame, QVector<QRgb> *palette, SharedFrameInfo *info)
+{
+    if (!memory.isAttached())
+        return false;
+
+    const auto *header = static_cast<const SharedFrameHeader *>(memory.constData());
+    const auto *levels = static_cast<const quint8 *>(memory.constData()) + sizeof(SharedFrameHeader);
+    const int capacity = static_cast<int>(header->capacityLeds);
+    const quint8 *inks = levels + capacity;
+
+    for (int attempt = 0; attempt < MaxAttempts; ++attempt) {
+        const quint64 before = header->generation.load(std::memory_order_acquire);
+        if (before == lastGeneration)
+            return false;
+        if (before & 1) {
+            // Écriture en cours : elle dure quelques microsecondes
+            ++retryCount;
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Champs relus sans confiance : une écriture concurrente peut les rendre incohérents
+        const int cols = header->cols;
+        const int rows = header->rows;
+        const int inkBits = header->inkBits;
+        const int paletteSize = header->paletteSize;
+        const bool sane = cols >= 0 && rows >= 0 && static_cast<qint64>(cols) * rows <= capacity
+                          && (inkBits == 0 || inkBits == 4 || inkBits == 8)
+                          && paletteSize >= 0 && paletteSize <= kPaletteEntries;
+        if (sane) {
+            if (frame->cols() != cols || frame->rows() != rows)
+                frame->resize(cols, rows);
+            if (frame->inkDepth() != inkBits)
+                frame->setInkDepth(inkBits);
+            std::memcpy(frame->data(), levels, static_cast<size_t>(cols) * rows);
+            std::memcpy(frame->inkData(), inks, static_cast<size_t>(inkBytesFor(cols * rows, inkBits)));
+            if (palette->size() != paletteSize)
+                palette->resize(paletteSize);
+            for (int index = 0; index < paletteSize; ++index) {
+                (*palette)[index] = header->palette[index];
+            }
+            info->frameNumber = header->frameNumber;
+            info->publishNs = header->publishNs;
+            info->hash = header->hash;
+        }
+
+        // Génération inchangée : rien n'a été écrit pendant la copie
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const quint64 after = header->generation.load(std::memory_order_relaxed);
+        if (sane && after == before) {
+            lastGeneration = before;
+            return true;
+        }
+        ++retryCount;
+    }
+    return false;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file spritecache.cpp
+ * @author G. Maxime
+ * @brief Implémentation du cache d'images dérivées partagé par le processus.
+ */
+
+// Inclusion de mes headers
+#include "headers/spritecache.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QMutexLocker>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+
+/**
+ * @brief Plafond par défaut du cache : 32 Mio.
+ */
+static constexpr qint64 kDefaultByteCap = 32 * 1024 * 1024;
+
+size_t qHash(const SpriteKey &key, size_t seed)
+{
+    return qHashMulti(seed, static_cast<int>(key.kind), key.font, key.cellSize64, key.devicePixelRatio1000,
+                      key.color, key.variant, key.grid.width(), key.grid.height(),
+                      key.phase64.x(), key.phase64.y());
+}
+
+SpriteCache::SpriteCache()
+{
+    stats.byteCap = kDefaultByteCap;
+}
+
+SpriteCache &SpriteCache::instance()
+{
+    static SpriteCache cache;
+    return cache;
+}
+
+QSharedPointer<const QImage> SpriteCache::obtain(const SpriteKey &key, const std::function<QImage()> &build)
+{
+    {
+        QMutexLocker locker(&mutex);
+        const auto it = entries.find(key);
+        if (it != entries.end()) {
+            ++stats.hits;
+            lru.splice(lru.begin(), lru, it->lruPosition);
+            return it->image;
+        }
+        ++stats.misses;
+    }
+
+    // Calcul hors verrou : un autre thread de rendu n'attend pas la construction de l'image
+    const QSharedPointer<const QImage> image(new QImage(build()));
+    const qint64 bytes = image->sizeInBytes();
+
+    QMutexLocker locker(&mutex);
+    // Image calculée entre-temps par un autre thread : la première insérée est partagée
+    const auto it = entries.find(key);
+    if (it != entries.end()) {
+        lru.splice(lru.begin(), lru, it->lruPosition);
+        return it->image;
+    }
+    // Plus grande que le plafond : rendue sans être conservée
+    if (bytes > stats.byteCap)
+        return image;
+
+    lru.push_front(key);
+    Entry entry;
+    entry.image = image;
+    entry.bytes = bytes;
+    entry.lruPosition = lru.begin();
+    entries.insert(key, entry);
+    stats.bytes += bytes;
+    stats.peakBytes = std::max(stats.peakBytes, stats.bytes);
+    evictToCap();
+    return image;
+}
+
+void SpriteCache::evictToCap()
+{
+    while (stats.bytes > stats.byteCap && !lru.empty()) {
+        const auto it = entries.find(lru.back());
+        stats.bytes -= it->bytes;
+        ++stats.evictions;
+        entries.erase(it);
+        lru.pop_back();
+    }
+}
+
+void SpriteCache::setByteCap(qint64 bytes)
+{
+    QMutexLocker locker(&mutex);
+    stats.byteCap = std::max<qint64>(0, bytes);
+    evictToCap();
+}
+
+qint64 SpriteCache::byteCap() const
+{
+    QMutexLocker locker(&mutex);
+    return stats.byteCap;
+}
+
+SpriteCache::Statistics SpriteCache::statistics() const
+{
+    QMutexLocker locker(&mutex);
+    Statistics snapshot = stats;
+    snapshot.entries = entries.size();
+    return snapshot;
+}
+
+void SpriteCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    entries.clear();
+    lru.clear();
+    stats.bytes = 0;
+}
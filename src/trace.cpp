@@ -0,0 +1,263 @@
+/**
+ * @file trace.cpp
+ * @author G. Maxime
+ * @brief Implémentation des traces chronologiques et de l'export Chrome trace.
+ */
+
+// Inclusion de mes headers
+#include "headers/trace.h"
+
+#ifdef MATRIX_TRACING
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QFile>
+#include <QTextStream>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Nombre d'événements conservés par thread (puissance de deux) : les plus anciens sont écrasés.
+ */
+constexpr quint64 kEventsPerThread = 1 << 16;
+
+/**
+ * @brief Phase terminée, enregistrée par Trace::Scope.
+ */
+struct TraceEvent {
+    const char *name = nullptr;
+    qint64 startNs = 0;
+    qint64 durationNs = 0;
+};
+
+/**
+ * @brief Tampon circulaire d'un thread : un seul écrivain (son thread), lu à l'export.
+ * recording est levé pendant l'écriture d'un événement : stop() attend qu'il retombe
+ * avant de rendre la main, ce qui laisse start() et l'export seuls sur les tampons.
+ */
+struct ThreadBuffer {
+    std::vector<TraceEvent> events;
+    std::atomic<quint64> written{0};
+    std::atomic<bool> recording{false};
+    int threadId = 0;
+    QString threadName;
+};
+
+/**
+ * @brief Tampons de tous les threads ayant enregistré un événement.
+ * Ils survivent à leur thread : l'export reste possible après l'arrêt du thread de rendu.
+ */
+struct TraceRegistry {
+    QMutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::atomic<qint64> originNs{0};
+};
+
+TraceRegistry &registry()
+{
+    static TraceRegistry instance;
+    return instance;
+}
+
+/**
+ * @brief Tampon du thread courant (nullptr avant son premier événement).
+ */
+thread_local ThreadBuffer *localBuffer = nullptr;
+
+/**
+ * @brief Crée et enregistre le tampon du thread courant (seule allocation, au premier événement).
+ */
+ThreadBuffer *registerThread()
+{
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->events.resize(kEventsPerThread);
+
+    QThread *thread = QThread::currentThread();
+    const QCoreApplication *application = QCoreApplication::instance();
+    if (application && thread == application->thread())
+        buffer->threadName = QStringLiteral("GUI");
+    else if (thread && !thread->objectName().isEmpty())
+        buffer->threadName = thread->objectName();
+
+    TraceRegistry &traces = registry();
+    QMutexLocker locker(&traces.mutex);
+    buffer->threadId = static_cast<int>(traces.buffers.size()) + 1;
+    if (buffer->threadName.isEmpty())
+        buffer->threadName = QStringLiteral("Thread %1").arg(buffer->threadId);
+    localBuffer = buffer.get();
+    traces.buffers.push_back(std::move(buffer));
+    return localBuffer;
+}
+
+/**
+ * @brief Chaîne JSON entre guillemets : guillemets, barres obliques inverses et caractères de contrôle échappés.
+ */
+QString jsonString(const QString &value)
+{
+    QString escaped = QStringLiteral("\"");
+    for (const QChar character : value) {
+        switch (character.unicode()) {
+        case '"':
+            escaped += QStringLiteral("\\\"");
+            break;
+        case '\\':
+            escaped += QStringLiteral("\\\\");
+            break;
+        case '\n':
+            escaped += QStringLiteral("\\n");
+            break;
+        case '\t':
+            escaped += QStringLiteral("\\t");
+            break;
+        default:
+            if (character.unicode() < 0x20)
+                escaped += QStringLiteral("\\u%1").arg(static_cast<int>(character.unicode()), 4, 16, QLatin1Char('0'));
+            else
+                escaped += character;
+        }
+    }
+    escaped += QLatin1Char('"');
+    return escaped;
+}
+
+} // namespace
+
+std::atomic<bool> Trace::enabled{false};
+
+bool Trace::isAvailable()
+{
+    return true;
+}
+
+qint64 Trace::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::record(const char *name, qint64 startNs, qint64 endNs)
+{
+    ThreadBuffer *buffer = localBuffer ? localBuffer : registerThread();
+    // Ordre séquentiellement cohérent avec stop() : soit stop() voit l'écriture en cours et
+    // l'attend, soit l'écrivain voit l'arrêt et abandonne l'événement
+    buffer->recording.store(true, std::memory_order_seq_cst);
+    if (!enabled.load(std::memory_order_seq_cst)) {
+        buffer->recording.store(false, std::memory_order_release);
+        return;
+    }
+    const quint64 index = buffer->written.load(std::memory_order_relaxed);
+    TraceEvent &event = buffer->events[index & (kEventsPerThread - 1)];
+    event.name = name;
+    event.startNs = startNs;
+    event.durationNs = endNs - startNs;
+    buffer->written.store(index + 1, std::memory_order_release);
+    buffer->recording.store(false, std::memory_order_release);
+}
+
+void Trace::start()
+{
+    // Aucun écrivain actif pendant la remise à zéro : un événement en cours ne peut pas l'écraser
+    stop();
+
+    TraceRegistry &traces = registry();
+    {
+        QMutexLocker locker(&traces.mutex);
+        for (const auto &buffer : traces.buffers) {
+            buffer->written.store(0, std::memory_order_relaxed);
+        }
+    }
+    traces.originNs.store(nowNs(), std::memory_order_relaxed);
+    enabled.store(true, std::memory_order_seq_cst);
+}
+
+void Trace::stop()
+{
+    enabled.store(false, std::memory_order_seq_cst);
+
+    // Attente des événements en cours d'écriture : au retour, les tampons ne bougent plus
+    TraceRegistry &traces = registry();
+    QMutexLocker locker(&traces.mutex);
+    for (const auto &buffer : traces.buffers) {
+        while (buffer->recording.load(std::memory_order_seq_cst))
+            QThread::yieldCurrentThread();
+    }
+}
+
+bool Trace::writeChromeTrace(const QString &path, QString *errorMessage)
+{
+    stop();
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        *errorMessage = QStringLiteral("Cannot write trace file %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    TraceRegistry &traces = registry();
+    const qint64 originNs = traces.originNs.load(std::memory_order_relaxed);
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Matrix_Display\"}}";
+
+    QMutexLocker locker(&traces.mutex);
+    quint64 dropped = 0;
+    for (const auto &buffer : traces.buffers) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+            << ",\"args\":{\"name\":" << jsonString(buffer->threadName) << "}}";
+
+        // Tampon plein : seuls les kEventsPerThread derniers événements restent
+        const quint64 written = buffer->written.load(std::memory_order_acquire);
+        const quint64 count = std::min(written, kEventsPerThread);
+        dropped += written - count;
+        for (quint64 index = written - count; index < written; ++index) {
+            const TraceEvent &event = buffer->events[index & (kEventsPerThread - 1)];
+            if (event.startNs < originNs)
+                continue;
+            // Horodatages en microsecondes (format « complete event » X)
+            out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"matrix\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << buffer->threadId << ",\"ts\":" << QString::number((event.startNs - originNs) / 1000.0, 'f', 3)
+                << ",\"dur\":" << QString::number(event.durationNs / 1000.0, 'f', 3) << "}";
+        }
+    }
+    out << "\n],\"otherData\":{\"droppedEvents\":" << dropped << "}}\n";
+    out.flush();
+
+    if (file.error() != QFileDevice::NoError) {
+        *errorMessage = QStringLiteral("Cannot write trace file %1: %2").arg(path, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+#else
+
+bool Trace::isAvailable()
+{
+    return false;
+}
+
+void Trace::start()
+{
+}
+
+void Trace::stop()
+{
+}
+
+bool Trace::writeChromeTrace(const QString &path, QString *errorMessage)
+{
+    *errorMessage = QStringLiteral("Cannot write %1: tracing is not compiled in, "
+                                   "reconfigure with -DMATRIX_TRACING=ON").arg(path);
+    return false;
+}
+
+#endif // MATRIX_TRACING
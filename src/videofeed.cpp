@@ -0,0 +1,432 @@
+/**
+ * @file videofeed.cpp
+ * @author G. Maxime
+ * @brief Implémentation du flux vidéo brut réduit aux LED d'une zone.
+ */
+
+// Inclusion de mes headers
+#include "headers/videofeed.h"
+#include "headers/trace.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QThread>
+#include <QMutexLocker>
+#include <QFile>
+#include <QDebug>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Durée maximale d'une attente de données : délai de prise en compte d'un arrêt.
+ */
+constexpr int kPollTimeoutMs = 100;
+
+/**
+ * @brief Période du relevé des compteurs dans le journal.
+ */
+constexpr qint64 kStatisticsLogMs = 10000;
+
+/**
+ * @brief Horloge monotone, en nanosecondes.
+ */
+qint64 monotonicNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+VideoFeed::VideoFeed(const QSize &frameSize, QObject *parent)
+    : QObject(parent),
+      sourceSize(frameSize),
+      frameBytes(frameSize.width() * frameSize.height() * 3)
+{
+    // Tous les tampons sont alloués ici : les threads ne font ensuite qu'échanger des indices
+    rawFrames.resize(kRawBuffers);
+    freeFrames.reserve(kRawBuffers);
+    for (int index = 0; index < kRawBuffers; ++index) {
+        rawFrames[index].resize(frameBytes);
+        freeFrames.push_back(index);
+    }
+    rowSums.resize(static_cast<size_t>(frameSize.width()) * 3);
+}
+
+VideoFeed::~VideoFeed()
+{
+    {
+        QMutexLocker locker(&queueMutex);
+        stopping = true;
+        queueChanged.wakeAll();
+    }
+
+    if (readerThread) {
+#ifdef Q_OS_UNIX
+        // Une FIFO sans écrivain bloque open() : une ouverture en écriture la débloque
+        while (!readerThread->wait(kPollTimeoutMs)) {
+            if (!opened && sourcePath != QStringLiteral("-")) {
+                const int fd = ::open(QFile::encodeName(sourcePath).constData(), O_WRONLY | O_NONBLOCK);
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        }
+#else
+        readerThread->wait();
+#endif
+        delete readerThread;
+    }
+    if (converterThread) {
+        converterThread->wait();
+        delete converterThread;
+    }
+}
+
+bool VideoFeed::start(const QString &path, QString *errorMessage)
+{
+#ifdef Q_OS_UNIX
+    if (readerThread) {
+        *errorMessage = QStringLiteral("Video feed %1 is already started").arg(sourcePath);
+        return false;
+    }
+    if (sourceSize.isEmpty()) {
+        *errorMessage = QStringLiteral("Invalid video frame size %1x%2")
+                            .arg(sourceSize.width()).arg(sourceSize.height());
+        return false;
+    }
+    if (path != QStringLiteral("-") && !QFile::exists(path)) {
+        *errorMessage = QStringLiteral("Cannot open video feed %1: no such file").arg(path);
+        return false;
+    }
+
+    sourcePath = path;
+    startedMs = monotonicNs() / 1000000;
+
+    // L'ouverture se fait dans le thread de lecture : une FIFO attend son écrivain sans bloquer le GUI
+    readerThread = QThread::create([this, path]() { readLoop(path); });
+    readerThread->setObjectName(QStringLiteral("MatrixVideoRead"));
+    converterThread = QThread::create([this]() { convertLoop(); });
+    converterThread->setObjectName(QStringLiteral("MatrixVideoConvert"));
+    converterThread->start();
+    readerThread->start();
+    return true;
+#else
+    Q_UNUSED(path);
+    *errorMessage = QStringLiteral("Video feeds are not supported on this platform");
+    return false;
+#endif
+}
+
+QSize VideoFeed::frameSize() const
+{
+    return sourceSize;
+}
+
+void VideoFeed::setTargetSize(const QSize &size)
+{
+    QMutexLocker locker(&queueMutex);
+    targetSize = size;
+}
+
+void VideoFeed::setConversion(LedImage::Conversion conversion)
+{
+    QMutexLocker locker(&queueMutex);
+    targetConversion = conversion;
+}
+
+bool VideoFeed::takeFrame(QByteArray *codes, QSize *size)
+{
+    // Réarmé avant la reprise : une image publiée pendant l'échange redéclenche le signal
+    notifyPending = false;
+
+    QMutexLocker locker(&latestMutex);
+    if (!latestPending)
+        return false;
+    std::swap(*codes, latestCodes);
+    *size = latestSize;
+    latestPending = false;
+    ++framesDisplayed;
+    return true;
+}
+
+VideoFeed::Statistics VideoFeed::statistics() const
+{
+    Statistics stats;
+    stats.framesRead = framesRead;
+    stats.framesConverted = framesConverted;
+    stats.framesDisplayed = framesDisplayed;
+    stats.queueDrops = queueDrops;
+    stats.staleDrops = staleDrops;
+    if (stats.framesConverted > 0)
+        stats.averageConvertMs = convertNsTotal / 1e6 / stats.framesConverted;
+    const qint64 started = startedMs;
+    if (started >= 0)
+        stats.elapsedMs = monotonicNs() / 1000000 - started;
+    return stats;
+}
+
+QString VideoFeed::statisticsSummary() const
+{
+    return summary(statistics());
+}
+
+QString VideoFeed::summary(const Statistics &stats)
+{
+    const double seconds = std::max<qint64>(1, stats.elapsedMs) / 1000.0;
+    return QStringLiteral("%1 read (%2 fps), %3 converted (avg %4 ms), %5 displayed, "
+                          "%6 dropped in queue, %7 replaced before display")
+        .arg(stats.framesRead)
+        .arg(stats.framesRead / seconds, 0, 'f', 1)
+        .arg(stats.framesConverted)
+        .arg(stats.averageConvertMs, 0, 'f', 2)
+        .arg(stats.framesDisplayed)
+        .arg(stats.queueDrops)
+        .arg(stats.staleDrops);
+}
+
+#ifdef Q_OS_UNIX
+
+void VideoFeed::readLoop(const QString &path)
+{
+    QString error;
+    int fd = STDIN_FILENO;
+    if (path != QStringLiteral("-")) {
+        do {
+            fd = ::open(QFile::encodeName(path).constData(), O_RDONLY);
+        } while (fd < 0 && errno == EINTR && !stopping);
+        if (fd < 0 && !stopping)
+            error = QStringLiteral("Cannot open video feed %1: %2").arg(path, QString::fromLocal8Bit(std::strerror(errno)));
+    }
+    opened = true;
+
+    while (fd >= 0 && !stopping) {
+        int buffer = -1;
+        {
+            QMutexLocker locker(&queueMutex);
+            // Toujours un tampon libre : la file n'en retient jamais plus que kQueueCapacity
+            buffer = freeFrames.back();
+            freeFrames.pop_back();
+        }
+
+        const bool complete = readFrame(fd, rawFrames[buffer].data(), &error);
+
+        QMutexLocker locker(&queueMutex);
+        if (!complete) {
+            freeFrames.push_back(buffer);
+            break;
+        }
+        ++framesRead;
+        if (queueCount == kQueueCapacity) {
+            // Conversion en retard : l'image la plus ancienne laisse sa place
+            freeFrames.push_back(queue[queueHead]);
+            queueHead = (queueHead + 1) % kQueueCapacity;
+            --queueCount;
+            ++queueDrops;
+        }
+        queue[(queueHead + queueCount) % kQueueCapacity] = buffer;
+        ++queueCount;
+        queueChanged.wakeOne();
+    }
+
+    if (fd > STDIN_FILENO)
+        ::close(fd);
+
+    QMutexLocker locker(&queueMutex);
+    readerDone = true;
+    readerError = error;
+    queueChanged.wakeAll();
+}
+
+bool VideoFeed::readFrame(int fd, quint8 *buffer, QString *errorMessage)
+{
+    int filled = 0;
+    while (filled < frameBytes) {
+        if (stopping)
+            return false;
+
+        // Attente par tranches : l'arrêt est pris en compte même si la source se tait
+        pollfd descriptor = {fd, POLLIN, 0};
+        const int ready = ::poll(&descriptor, 1, kPollTimeoutMs);
+        if (ready < 0) {
+            if (errno == EINTR)
+                continue;
+            *errorMessage = QStringLiteral("Cannot read video feed: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+            return false;
+        }
+        if (ready == 0)
+            continue;
+
+        const ssize_t count = ::read(fd, buffer + filled, static_cast<size_t>(frameBytes - filled));
+        if (count < 0) {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+            *errorMessage = QStringLiteral("Cannot read video feed: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+            return false;
+        }
+        if (count == 0) {
+            // Fin de flux : une image incomplète est ignorée
+            if (filled > 0) {
+                qWarning().noquote() << QStringLiteral("VideoFeed: stream ended inside a frame (%1 of %2 bytes)")
+                                            .arg(filled).arg(frameBytes);
+            }
+            return false;
+        }
+        filled += static_cast<int>(count);
+    }
+    return true;
+}
+
+#else
+
+void VideoFeed::readLoop(const QString &path)
+{
+    Q_UNUSED(path);
+}
+
+bool VideoFeed::readFrame(int fd, quint8 *buffer, QString *errorMessage)
+{
+    Q_UNUSED(fd);
+    Q_UNUSED(buffer);
+    Q_UNUSED(errorMessage);
+    return false;
+}
+
+#endif // Q_OS_UNIX
+
+void VideoFeed::convertLoop()
+{
+    qint64 nextLogMs = startedMs + kStatisticsLogMs;
+    QString error;
+    for (;;) {
+        int buffer = -1;
+        QSize size;
+        LedImage::Conversion conversion = LedImage::OrderedDither;
+        {
+            QMutexLocker locker(&queueMutex);
+            while (!stopping && queueCount == 0 && !readerDone) {
+                queueChanged.wait(&queueMutex);
+            }
+            if (stopping)
+                return;
+            if (queueCount == 0) {
+                // Lecture terminée et file vidée
+                error = readerError;
+                break;
+            }
+            buffer = queue[queueHead];
+            queueHead = (queueHead + 1) % kQueueCapacity;
+            --queueCount;
+            size = targetSize;
+            conversion = targetConversion;
+        }
+
+        const qint64 startNs = monotonicNs();
+        convertFrame(rawFrames[buffer].data(), size, conversion, &workCodes);
+        convertNsTotal += monotonicNs() - startNs;
+        ++framesConverted;
+
+        {
+            QMutexLocker locker(&queueMutex);
+            freeFrames.push_back(buffer);
+        }
+        {
+            QMutexLocker locker(&latestMutex);
+            if (latestPending)
+                ++staleDrops;
+            std::swap(latestCodes, workCodes);
+            latestSize = size;
+            latestPending = true;
+        }
+        // Un seul signal en attente : un GUI chargé n'accumule pas d'événements
+        if (!notifyPending.exchange(true))
+            emit frameAvailable();
+
+        const qint64 nowMs = monotonicNs() / 1000000;
+        if (nowMs >= nextLogMs) {
+            nextLogMs = nowMs + kStatisticsLogMs;
+            qInfo().noquote() << QStringLiteral("VideoFeed: ") + statisticsSummary();
+        }
+    }
+    emit finished(error);
+}
+
+void VideoFeed::updateSpans(const QSize &size)
+{
+    spanSize = size;
+    spanRect = LedImage::fitRect(sourceSize, size);
+
+    // Bloc de pixels de chaque LED : partition entière de la source, au moins un pixel par LED
+    const int width = sourceSize.width();
+    const int height = sourceSize.height();
+    const int cols = spanRect.width();
+    const int rows = spanRect.height();
+    colStarts.resize(cols);
+    colEnds.resize(cols);
+    for (int col = 0; col < cols; ++col) {
+        colStarts[col] = std::min(width - 1, col * width / cols);
+        colEnds[col] = std::min(width, std::max(colStarts[col] + 1, (col + 1) * width / cols));
+    }
+    rowStarts.resize(rows);
+    rowEnds.resize(rows);
+    for (int row = 0; row < rows; ++row) {
+        rowStarts[row] = std::min(height - 1, row * height / rows);
+        rowEnds[row] = std::min(height, std::max(rowStarts[row] + 1, (row + 1) * height / rows));
+    }
+}
+
+void VideoFeed::convertFrame(const quint8 *rgb, const QSize &size, LedImage::Conversion conversion, QByteArray *codes)
+{
+    MATRIX_TRACE_SCOPE("VideoFeed::convertFrame");
+
+    const int ledCount = size.width() * size.height();
+    if (codes->size() != ledCount)
+        codes->resize(ledCount);
+    if (ledCount <= 0)
+        return;
+    codes->fill('\0');
+    if (size != spanSize)
+        updateSpans(size);
+
+    const int lineBytes = sourceSize.width() * 3;
+    quint32 *sums = rowSums.data();
+    char *out = codes->data();
+    for (int row = 0; row < spanRect.height(); ++row) {
+        // Cumul des lignes de la bande : boucle contiguë sur des entiers, vectorisée par le compilateur
+        std::fill(sums, sums + lineBytes, 0u);
+        for (int y = rowStarts[row]; y < rowEnds[row]; ++y) {
+            const quint8 *line = rgb + static_cast<size_t>(y) * lineBytes;
+            for (int i = 0; i < lineBytes; ++i) {
+                sums[i] += line[i];
+            }
+        }
+
+        const int ledRow = spanRect.y() + row;
+        const int bandRows = rowEnds[row] - rowStarts[row];
+        for (int col = 0; col < spanRect.width(); ++col) {
+            quint32 red = 0;
+            quint32 green = 0;
+            quint32 blue = 0;
+            for (int x = colStarts[col]; x < colEnds[col]; ++x) {
+                red += sums[x * 3];
+                green += sums[x * 3 + 1];
+                blue += sums[x * 3 + 2];
+            }
+            const float scale = 1.0f / static_cast<float>(bandRows * (colEnds[col] - colStarts[col]));
+            const int ledCol = spanRect.x() + col;
+            out[ledRow * size.width() + ledCol] = static_cast<char>(
+                LedImage::quantize(red * scale, green * scale, blue * scale, ledCol, ledRow, conversion));
+        }
+    }
+}
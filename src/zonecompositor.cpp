@@ -0,0 +1,228 @@
+/**
+ * @file zonecompositor.cpp
+ * @author G. Maxime
+ * @brief Implémentation du compositeur de zones de la matrice.
+ */
+
+// Inclusion de mes headers
+#include "headers/zonecompositor.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QDebug>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+
+/**
+ * @brief Nombre maximal de zones.
+ */
+static constexpr int kMaxZones = 127;
+
+ZoneCompositor::ZoneCompositor(int cols, int rows, QObject *parent)
+    : QObject(parent),
+      matrixCols(std::max(1, cols)),
+      matrixRows(std::max(1, rows))
+{
+    composite.setInkDepth(ledPalette.depth());
+    composite.resize(matrixCols, matrixRows);
+    createZone(QRect(0, 0, matrixCols, matrixRows));
+}
+
+int ZoneCompositor::cols() const
+{
+    return matrixCols;
+}
+
+int ZoneCompositor::rows() const
+{
+    return matrixRows;
+}
+
+void ZoneCompositor::setMatrixSize(int cols, int rows)
+{
+    cols = std::max(1, cols);
+    rows = std::max(1, rows);
+    if (cols == matrixCols && rows == matrixRows)
+        return;
+
+    const bool primaryCoversMatrix = zones[0]->area() == QRect(0, 0, matrixCols, matrixRows);
+    matrixCols = cols;
+    matrixRows = rows;
+    composite.resize(matrixCols, matrixRows);
+    layoutDirty = true;
+    if (primaryCoversMatrix) {
+        zones[0]->setArea(QRect(0, 0, matrixCols, matrixRows));
+    }
+    emit changed(false);
+}
+
+int ZoneCompositor::addZone(const QRect &area)
+{
+    if (zones.size() >= kMaxZones)
+        return -1;
+
+    createZone(area);
+    layoutDirty = true;
+    emit changed(true);
+    return zones.size() - 1;
+}
+
+void ZoneCompositor::removeZone(int index)
+{
+    if (index <= 0 || index >= zones.size())
+        return;
+
+    delete zones.takeAt(index);
+    layoutDirty = true;
+    emit changed(true);
+}
+
+int ZoneCompositor::zoneCount() const
+{
+    return zones.size();
+}
+
+MatrixZone *ZoneCompositor::zone(int index) const
+{
+    if (index < 0 || index >= zones.size())
+        return nullptr;
+    return zones[index];
+}
+
+MatrixZone *ZoneCompositor::primaryZone() const
+{
+    return zones[0];
+}
+
+bool ZoneCompositor::hasContent() const
+{
+    return std::any_of(zones.cbegin(), zones.cend(), [](const MatrixZone *zone) { return zone->hasContent(); });
+}
+
+MatrixZone *ZoneCompositor::createZone(const QRect &area)
+{
+    MatrixZone *zone = new MatrixZone(area, &ledPalette, clock, this);
+    connect(zone, &MatrixZone::changed, this, &ZoneCompositor::changed);
+    connect(zone, &MatrixZone::areaChanged, this, &ZoneCompositor::onZoneAreaChanged);
+    connect(zone, &MatrixZone::timerWokeUp, this, &ZoneCompositor::timerWokeUp);
+    connect(zone, &MatrixZone::videoFinished, this, &ZoneCompositor::videoFinished);
+    if (suspended)
+        zone->suspend();
+    zones.append(zone);
+    return zone;
+}
+
+void ZoneCompositor::onZoneAreaChanged()
+{
+    layoutDirty = true;
+    emit changed(false);
+}
+
+const LedPalette &ZoneCompositor::palette() const
+{
+    return ledPalette;
+}
+
+void ZoneCompositor::setPaletteDepth(int bits)
+{
+    if (bits == ledPalette.depth())
+        return;
+
+    ledPalette.setDepth(bits);
+    composite.setInkDepth(ledPalette.depth());
+    for (MatrixZone *zone : zones) {
+        zone->invalidate();
+    }
+    layoutDirty = true;
+    emit changed(false);
+}
+
+void ZoneCompositor::compositeArea(const QRect &area)
+{
+    composite.clearRect(area.x(), area.y(), area.width(), area.height());
+    // Les zones sont recopiées de la plus basse à la plus haute : la dernière recouvre les autres
+    for (MatrixZone *zone : zones) {
+        const QRect zoneArea = zone->area();
+        const QRect overlap = zoneArea & area;
+        if (overlap.isEmpty())
+            continue;
+        composite.copyRect(zone->frame(),
+                           overlap.x() - zoneArea.x(), overlap.y() - zoneArea.y(),
+                           overlap.x(), overlap.y(), overlap.width(), overlap.height());
+    }
+}
+
+void ZoneCompositor::compose()
+{
+    const QRect matrixRect(0, 0, matrixCols, matrixRows);
+    if (layoutDirty) {
+        compositeArea(matrixRect);
+        layoutDirty = false;
+        return;
+    }
+
+    // Seules les zones modifiées sont recomposées ; une zone statique ne coûte rien.
+    // Les zones modifiées sont relevées avant toute recomposition, qui rastérise les zones recouvertes.
+    dirtyAreas.clear();
+    for (MatrixZone *zone : zones) {
+        if (zone->isDirty()) {
+            dirtyAreas.append(zone->area() & matrixRect);
+        }
+    }
+    for (const QRect &area : dirtyAreas) {
+        compositeArea(area);
+    }
+}
+
+const LedFrame &ZoneCompositor::frame()
+{
+    compose();
+
+    // Palette saturée : elle est reconstruite avec les seules couleurs encore affichées
+    if (ledPalette.hasOverflowed()) {
+        ledPalette.clear();
+        for (MatrixZone *zone : zones) {
+            zone->invalidate();
+        }
+        layoutDirty = true;
+        compose();
+        if (ledPalette.hasOverflowed() && !saturationReported) {
+            saturationReported = true;
+            qWarning().noquote() << QStringLiteral("ZoneCompositor: more than %1 colors on screen, "
+                                                   "use 8-bit palette indices for exact colors")
+                                        .arg(ledPalette.capacity());
+        }
+    }
+    return composite;
+}
+
+void ZoneCompositor::suspend()
+{
+    suspended = true;
+    for (MatrixZone *zone : zones) {
+        zone->suspend();
+    }
+}
+
+void ZoneCompositor::resume()
+{
+    suspended = false;
+    for (MatrixZone *zone : zones) {
+        zone->resume();
+    }
+}
+
+void ZoneCompositor::setClock(const FrameClock *clock)
+{
+    this->clock = clock;
+    for (MatrixZone *zone : zones) {
+        zone->setClock(clock);
+    }
+}
+
+void ZoneCompositor::tick()
+{
+    for (MatrixZone *zone : zones) {
+        zone->tick();
+    }
+}
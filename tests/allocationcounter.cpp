@@ -0,0 +1,176 @@
+/**
+ * @file allocationcounter.cpp
+ * @author G. Maxime
+ * @brief Implémentation du compteur d'allocations de tst_allocations.
+ */
+
+// Inclusion de mes headers
+#include "tests/allocationcounter.h"
+
+#if defined(__GLIBC__)
+
+// Inclusion des headers standard nécessaires
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Points d'entrée de l'allocateur de la glibc, appelés par les fonctions remplacées
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void *__libc_valloc(size_t size);
+void *__libc_pvalloc(size_t size);
+}
+
+namespace {
+
+/**
+ * @brief Allocations du thread courant (TLS statique : sa lecture n'alloue rien).
+ */
+thread_local quint64 allocations = 0;
+
+/**
+ * @brief Allocation alignée des operator new alignés (taille nulle ramenée à un octet).
+ */
+void *alignedNew(size_t size, std::align_val_t alignment) noexcept
+{
+    ++allocations;
+    return __libc_memalign(static_cast<size_t>(alignment), size == 0 ? 1 : size);
+}
+
+} // namespace
+
+// operator new passe par malloc : Qt (QArrayData) et la bibliothèque standard sont comptés ici
+extern "C" void *malloc(size_t size)
+{
+    ++allocations;
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    ++allocations;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *pointer, size_t size)
+{
+    ++allocations;
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size)
+{
+    ++allocations;
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void **pointer, size_t alignment, size_t size)
+{
+    ++allocations;
+    void *result = __libc_memalign(alignment, size);
+    if (!result)
+        return ENOMEM;
+    *pointer = result;
+    return 0;
+}
+
+extern "C" void *memalign(size_t alignment, size_t size)
+{
+    ++allocations;
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" void *valloc(size_t size)
+{
+    ++allocations;
+    return __libc_valloc(size);
+}
+
+extern "C" void *pvalloc(size_t size)
+{
+    ++allocations;
+    return __libc_pvalloc(size);
+}
+
+// Les operator new alignés de la bibliothèque standard ne passent pas forcément par les
+// fonctions ci-dessus : ils sont remplacés, et libérés par free comme toute allocation de la glibc
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    void *result = alignedNew(size, alignment);
+    if (!result)
+        throw std::bad_alloc();
+    return result;
+}
+
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return alignedNew(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return alignedNew(size, alignment);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    free(pointer);
+}
+
+bool AllocationCounter::isAvailable()
+{
+    return true;
+}
+
+quint64 AllocationCounter::threadAllocations()
+{
+    return allocations;
+}
+
+#else
+
+bool AllocationCounter::isAvailable()
+{
+    return false;
+}
+
+quint64 AllocationCounter::threadAllocations()
+{
+    return 0;
+}
+
+#endif
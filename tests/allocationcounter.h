@@ -0,0 +1,29 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+// Inclusion des headers Qt nécessaires
+#include <QtGlobal>
+
+/**
+ * @file allocationcounter.h
+ * @author G. Maxime
+ * @brief Compteur global des allocations sur le tas, lié seulement à tst_allocations.
+ * Avec la glibc, malloc, calloc, realloc, les allocations alignées (aligned_alloc,
+ * posix_memalign, memalign, valloc, pvalloc) et les operator new alignés sont remplacés
+ * et comptés par thread. Sur les autres plateformes, rien n'est remplacé et le test est sauté.
+ */
+namespace AllocationCounter {
+
+/**
+ * @brief Indique si les fonctions d'allocation sont remplacées sur cette plateforme.
+ */
+bool isAvailable();
+
+/**
+ * @brief Nombre d'allocations faites par le thread appelant depuis son démarrage.
+ */
+quint64 threadAllocations();
+
+} // namespace AllocationCounter
+
+#endif // ALLOCATIONCOUNTER_H
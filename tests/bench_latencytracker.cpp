@@ -0,0 +1,147 @@
+/**
+ * @file bench_latencytracker.cpp
+ * @author G. Maxime
+ * @brief Mesure de latence : sur une matrice affichée, enchaîne des changements de texte,
+ * de mode et de taille toutes les millisecondes et des dépôts d'un thread producteur, avec
+ * puis sans thread de rendu ; affiche les p50/p99/max du délai jusqu'au premier paintEvent
+ * qui montre chaque changement, par origine et par étape, et vérifie le p99 (50 ms).
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/latencytracker.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QThread>
+#include <QTimer>
+
+// Inclusion des headers standard nécessaires
+#include <atomic>
+#include <memory>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Rafale de changements de texte, de mode, de taille et de dépôts d'un autre thread
+ * sur une matrice affichée : délai entre chaque changement et le premier paintEvent qui le montre.
+ */
+int runLatencyStress(const TestSupport::Options &options)
+{
+    // Au-delà, un changement attend plusieurs images : la matrice ne suit plus les commandes
+    const double p99BudgetUs = 50000.0 * options.budgetScale;
+    const int changeIntervalMs = 1;
+
+    int failures = 0;
+    out() << "bench_latencytracker: one change every " << changeIntervalMs << " ms for " << options.durationMs
+          << " ms per pass\n";
+    for (const bool useRenderThread : {false, true}) {
+        MatrixDisplay display;
+        display.setPowerSavingEnabled(false);
+        display.setRenderThreadEnabled(useRenderThread);
+        display.resize(1200, 144);
+        display.setText(QStringLiteral("LATENCY"));
+        display.show();
+
+        // Première image affichée avant la mesure : l'exposition initiale n'est pas un changement
+        bool painted = false;
+        QMetaObject::Connection firstPaint = QObject::connect(&display, &MatrixDisplay::framePainted,
+                                                              &display, [&painted]() { painted = true; });
+        QElapsedTimer deadline;
+        deadline.start();
+        while (!painted && deadline.elapsed() < 2000)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QObject::disconnect(firstPaint);
+        display.setLatencyMonitoringEnabled(true);
+
+        // Producteur d'un autre thread (boîte des producteurs, comme un message réseau)
+        std::atomic<bool> stop{false};
+        std::unique_ptr<QThread> producer(QThread::create([&]() {
+            quint64 index = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                display.postText(QStringLiteral("POSTED %1").arg(++index));
+                QThread::msleep(3);
+            }
+        }));
+        producer->start();
+
+        quint64 changes = 0;
+        QTimer changeTimer;
+        changeTimer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&changeTimer, &QTimer::timeout, &display, [&]() {
+            switch (changes++ % 8) {
+            case 0:
+            case 2:
+            case 4:
+                display.setText(QStringLiteral("{#ff8000}UPDATE{} %1 {rainbow}TEXT").arg(changes));
+                break;
+            case 1:
+                display.resize(changes % 16 < 8 ? 1100 : 1200, 144);
+                break;
+            case 3:
+                display.setDisplayMode(MatrixDisplay::Clock);
+                break;
+            case 5:
+                display.setDisplayMode(MatrixDisplay::Text);
+                break;
+            default:
+                display.setText(QStringLiteral("SHORT %1").arg(changes));
+                break;
+            }
+        });
+        changeTimer.start(changeIntervalMs);
+
+        QEventLoop loop;
+        QTimer::singleShot(options.durationMs, &loop, &QEventLoop::quit);
+        loop.exec();
+        changeTimer.stop();
+        stop.store(true, std::memory_order_relaxed);
+        producer->wait();
+
+        // Derniers changements affichés avant le relevé
+        deadline.restart();
+        while (deadline.elapsed() < 200)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+        const LatencyTracker::Report report = display.latencyReport();
+        const auto describe = [](const LatencyTracker::Distribution &distribution) {
+            return QStringLiteral("%1 samples, p50 %2 us, p99 %3 us, max %4 us")
+                .arg(distribution.count).arg(distribution.p50Us).arg(distribution.p99Us).arg(distribution.maxUs);
+        };
+        bool sourcesOk = true;
+        out() << "  " << (useRenderThread ? "render thread" : "GUI paint") << ": " << changes << " direct changes\n";
+        for (int source = 0; source < LatencyTracker::SourceCount; ++source) {
+            const LatencyTracker::Distribution &distribution = report.sources[source];
+            const bool sourceOk = distribution.count > 0;
+            sourcesOk = sourcesOk && sourceOk;
+            out() << "    " << LatencyTracker::sourceName(static_cast<LatencyTracker::Source>(source)).leftJustified(8)
+                  << describe(distribution) << (sourceOk ? "" : "  FAIL (no sample)") << "\n";
+        }
+        const bool p99Ok = report.total.p99Us <= p99BudgetUs;
+        out() << "    total   " << describe(report.total) << " (p99 budget " << qRound64(p99BudgetUs) << " us)"
+              << (p99Ok ? "" : "  FAIL") << "\n"
+              << "    stages  layout p50 " << report.layout.p50Us << " us / p99 " << report.layout.p99Us
+              << " us, raster p50 " << report.raster.p50Us << " us / p99 " << report.raster.p99Us
+              << " us, present p50 " << report.present.p50Us << " us / p99 " << report.present.p99Us << " us\n"
+              << "    untracked changes: " << report.dropped << "\n";
+        if (!sourcesOk || !p99Ok)
+            ++failures;
+    }
+
+    out() << (failures == 0 ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return failures == 0 ? 0 : 1;
+}
+
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runLatencyStress);
+}
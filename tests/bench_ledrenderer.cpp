@@ -0,0 +1,94 @@
+/**
+ * @file bench_ledrenderer.cpp
+ * @author G. Maxime
+ * @brief Mesure de performance des styles de LED : temps de dessin d'un défilement dans
+ * chaque style ; le halo (glow) doit coûter moins de trois fois le point simple.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/frameclock.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <QVector>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Compare le coût de dessin des styles de LED : le halo doit rester dans un facteur du point simple.
+ */
+int runRenderStyles(const TestSupport::Options &options)
+{
+    // Coût maximal du style glow, relatif au style dot
+    const double maxGlowFactor = 3.0 * options.budgetScale;
+    const int warmupFrames = 60;
+
+    struct StyleResult {
+        LedRenderer::Style style;
+        double averageMs = 0.0;
+        double maxMs = 0.0;
+    };
+    QVector<StyleResult> results = {{LedRenderer::DotStyle}, {LedRenderer::GlowStyle}};
+
+    out() << "bench_ledrenderer: " << options.frames << " frames per style\n";
+    for (StyleResult &result : results) {
+        ManualFrameClock clock;
+        MatrixDisplay display;
+        display.setPowerSavingEnabled(false);
+        display.setClock(&clock);
+        display.resize(1200, 144);
+        display.setLedStyle(result.style);
+        display.setText(QStringLiteral("{red}GLOW {#ff8000}BENCHMARK {rainbow}0123456789 {}MATRIX DISPLAY"));
+        display.setScrollInterval(5);
+        display.setScrollEnabled(true);
+
+        QImage image(display.size(), QImage::Format_RGB32);
+        QPainter painter(&image);
+
+        double totalMs = 0.0;
+        for (int frame = 0; frame < warmupFrames + options.frames; ++frame) {
+            clock.advance(16);
+            display.tick();
+            display.displayFrame();
+
+            QElapsedTimer renderTimer;
+            renderTimer.start();
+            display.renderMatrix(painter);
+            const double renderMs = renderTimer.nsecsElapsed() / 1e6;
+            // Les premières images calculent brushes et halos : hors mesure
+            if (frame < warmupFrames)
+                continue;
+            totalMs += renderMs;
+            result.maxMs = std::max(result.maxMs, renderMs);
+        }
+        result.averageMs = totalMs / options.frames;
+        out() << "  " << LedRenderer::styleName(result.style).leftJustified(6)
+              << "avg " << QString::number(result.averageMs, 'f', 3)
+              << " ms, max " << QString::number(result.maxMs, 'f', 3) << " ms\n";
+    }
+
+    const double factor = results[0].averageMs > 0.0 ? results[1].averageMs / results[0].averageMs : 0.0;
+    const bool ok = factor <= maxGlowFactor;
+    out() << "  glow / dot: x" << QString::number(factor, 'f', 2)
+          << " (limit x" << QString::number(maxGlowFactor, 'f', 1) << ")" << (ok ? "" : "  OVER LIMIT") << "\n";
+    out() << (ok ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return ok ? 0 : 1;
+}
+
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runRenderStyles);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file testsupport.cpp
+ * @author G. Maxime
+ * @brief Implémentation des outils communs aux tests et mesures de performance.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixzone.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QFileInfo>
+#include <QThread>
+#include <QDebug>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+
+bool TestSupport::Options::parse(const QStringList &arguments, QString *errorMessage)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("LED matrix display test: %1")
+                                         .arg(QFileInfo(arguments.value(0)).baseName()));
+    parser.addHelpOption();
+
+    const QCommandLineOption threadsOption(QStringLiteral("threads"),
+        QStringLiteral("Number of producer threads or displays."), QStringLiteral("count"));
+    const QCommandLineOption durationOption(QStringLiteral("duration-ms"),
+        QStringLiteral("Duration of the test in milliseconds."), QStringLiteral("ms"));
+    const QCommandLineOption framesOption(QStringLiteral("frames"),
+        QStringLiteral("Number of measured or published frames."), QStringLiteral("count"));
+    const QCommandLineOption clientsOption(QStringLiteral("clients"),
+        QStringLiteral("Number of connected viewers."), QStringLiteral("count"));
+    const QCommandLineOption budgetScaleOption(QStringLiteral("budget-scale"),
+        QStringLiteral("Relax the time budgets (slow or debug builds)."), QStringLiteral("factor"));
+    const QCommandLineOption timingOption(QStringLiteral("timing"),
+        QStringLiteral("Also check the time budgets."));
+    const QCommandLineOption recordOption(QStringLiteral("record"),
+        QStringLiteral("Write the reference file instead of checking against it."), QStringLiteral("file"));
+    parser.addOptions({threadsOption, durationOption, framesOption, clientsOption, budgetScaleOption,
+                       timingOption, recordOption});
+
+    if (!parser.parse(arguments)) {
+        *errorMessage = parser.errorText();
+        return false;
+    }
+    if (parser.isSet(QStringLiteral("help"))) {
+        parser.showHelp();
+    }
+
+    if (parser.isSet(threadsOption)) {
+        bool ok = false;
+        threads = parser.value(threadsOption).toInt(&ok);
+        if (!ok || threads < 1 || threads > 64) {
+            *errorMessage = QStringLiteral("Invalid thread count (expected 1 to 64): %1").arg(parser.value(threadsOption));
+            return false;
+        }
+    }
+    if (parser.isSet(durationOption)) {
+        bool ok = false;
+        durationMs = parser.value(durationOption).toInt(&ok);
+        if (!ok || durationMs <= 0) {
+            *errorMessage = QStringLiteral("Invalid duration: %1").arg(parser.value(durationOption));
+            return false;
+        }
+    }
+    if (parser.isSet(framesOption)) {
+        bool ok = false;
+        frames = parser.value(framesOption).toInt(&ok);
+        if (!ok || frames <= 0) {
+            *errorMessage = QStringLiteral("Invalid frame count: %1").arg(parser.value(framesOption));
+            return false;
+        }
+    }
+    if (parser.isSet(clientsOption)) {
+        bool ok = false;
+        clients = parser.value(clientsOption).toInt(&ok);
+        if (!ok || clients < 1 || clients > 400) {
+            *errorMessage = QStringLiteral("Invalid viewer count (expected 1 to 400): %1").arg(parser.value(clientsOption));
+            return false;
+        }
+    }
+    if (parser.isSet(budgetScaleOption)) {
+        bool ok = false;
+        budgetScale = parser.value(budgetScaleOption).toDouble(&ok);
+        if (!ok || budgetScale <= 0.0) {
+            *errorMessage = QStringLiteral("Invalid budget scale: %1").arg(parser.value(budgetScaleOption));
+            return false;
+        }
+    }
+    timing = parser.isSet(timingOption);
+    recordPath = parser.value(recordOption);
+    return true;
+}
+
+int TestSupport::run(int argc, char *argv[], int (*test)(const Options &options))
+{
+    // Tests sans écran : plateforme offscreen, sauf si l'utilisateur en impose une
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication application(argc, argv);
+
+    Options options;
+    QString errorMessage;
+    if (!options.parse(application.arguments(), &errorMessage)) {
+        qCritical().noquote() << errorMessage;
+        return 1;
+    }
+    return test(options);
+}
+
+QTextStream &TestSupport::out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+QVector<QImage> TestSupport::syntheticAnimation(int frameCount)
+{
+    QVector<QImage> frames;
+    for (int frame = 0; frame < frameCount; ++frame) {
+        QImage image(960, 240, QImage::Format_RGB32);
+        const int centerX = 120 + frame * 720 / std::max(1, frameCount - 1);
+        for (int y = 0; y < image.height(); ++y) {
+            QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x) {
+                const int dx = x - centerX;
+                const int dy = y - 120;
+                line[x] = dx * dx + dy * dy < 90 * 90
+                              ? qRgb(255, 255, 255)
+                              : qRgb(x * 255 / image.width(), y * 255 / image.height(), (frame * 37) & 255);
+            }
+        }
+        frames.append(image);
+    }
+    return frames;
+}
+
+void TestSupport::waitForImageConversion(MatrixZone *zone)
+{
+    while (zone->isImageLoading()) {
+        QCoreApplication::processEvents();
+        QThread::msleep(1);
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+// Inclusion des headers Qt nécessaires
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QImage>
+#include <QVector>
+
+class MatrixZone;
+
+/**
+ * @file testsupport.h
+ * @author G. Maxime
+ * @brief Outils communs aux tests et mesures de performance lancés par ctest.
+ * Chaque exécutable exerce un sous-système sans interface de contrôle, affiche un
+ * rapport sur la sortie standard et renvoie un code non nul en cas d'échec
+ * (SkipExitCode quand le test n'a pas de sens sur la plateforme ou le build).
+ */
+namespace TestSupport {
+
+/**
+ * @brief Code de sortie d'un test sauté (propriété SKIP_RETURN_CODE de ctest).
+ */
+constexpr int SkipExitCode = 77;
+
+/**
+ * @struct Options
+ * @brief Paramètres d'un test, lus depuis la ligne de commande.
+ */
+struct Options
+{
+    /**
+     * @brief Nombre de threads producteurs ou de matrices (--threads).
+     */
+    int threads = 4;
+
+    /**
+     * @brief Durée du test en millisecondes (--duration-ms).
+     */
+    int durationMs = 2000;
+
+    /**
+     * @brief Nombre d'images mesurées après la mise en température (--frames).
+     */
+    int frames = 600;
+
+    /**
+     * @brief Nombre de visualiseurs connectés (--clients).
+     */
+    int clients = 100;
+
+    /**
+     * @brief Facteur appliqué aux budgets de temps (machine lente, build de débogage).
+     */
+    double budgetScale = 1.0;
+
+    /**
+     * @brief Vérifie aussi les budgets de temps (--timing, entrées « benchmark » de ctest).
+     */
+    bool timing = false;
+
+    /**
+     * @brief Fichier de référence à écrire au lieu de le vérifier (--record).
+     */
+    QString recordPath;
+
+    /**
+     * @brief Lit la ligne de commande.
+     * @param arguments Arguments de l'exécutable.
+     * @param errorMessage Message d'erreur renseigné en cas d'échec.
+     * @return Vrai si les paramètres sont valides.
+     */
+    bool parse(const QStringList &arguments, QString *errorMessage);
+};
+
+/**
+ * @brief Crée l'application (plateforme offscreen, sauf si QT_QPA_PLATFORM est imposée),
+ * lit les paramètres et lance le test.
+ * @param test Fonction de test : renvoie 0 si le test réussit.
+ * @return Code de retour du processus.
+ */
+int run(int argc, char *argv[], int (*test)(const Options &options));
+
+/**
+ * @brief Flux de sortie des rapports.
+ */
+QTextStream &out();
+
+/**
+ * @brief Animation synthétique en haute résolution : un disque blanc parcourt un dégradé coloré.
+ * Calculée en entiers, elle est identique sur toutes les machines.
+ */
+QVector<QImage> syntheticAnimation(int frameCount);
+
+/**
+ * @brief Attend la fin de la conversion d'image d'une zone (livrée par la boucle d'événements).
+ */
+void waitForImageConversion(MatrixZone *zone);
+
+} // namespace TestSupport
+
+#endif // TESTSUPPORT_H
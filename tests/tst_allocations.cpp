@@ -0,0 +1,302 @@
+/**
+ * @file tst_allocations.cpp
+ * @author G. Maxime
+ * @brief Test des allocations en régime établi : défilement, rebond, bandeau, animation
+ * d'image et horloge ne doivent rien allouer, ni en calculant le contenu des LED, ni dans
+ * paintEvent. Le dessin passe par les vrais chemins de Qt (update() d'une matrice affichée,
+ * puis QWidget::render) ; le coût propre de Qt, mesuré sur un widget qui ne fait qu'ouvrir
+ * un QPainter, est retranché.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "tests/allocationcounter.h"
+#include "headers/matrixdisplay.h"
+#include "headers/frameclock.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QImage>
+#include <QPainter>
+#include <QWidget>
+#include <QWindow>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <functional>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @class PaintProbe
+ * @brief Compte les allocations du thread GUI entre la réception d'un QPaintEvent et la fin du dessin.
+ */
+class PaintProbe : public QObject
+{
+public:
+    explicit PaintProbe(QWidget *widget)
+    {
+        widget->installEventFilter(this);
+    }
+
+    /**
+     * @brief Clôt la mesure du dessin en cours (fin de paintEvent).
+     */
+    void finish()
+    {
+        if (!painting)
+            return;
+        painting = false;
+        const quint64 count = AllocationCounter::threadAllocations() - paintStart;
+        allocations += count;
+        maxAllocations = std::max(maxAllocations, count);
+        ++paints;
+    }
+
+    /**
+     * @brief Remet les compteurs à zéro (fin de la mise en température, changement de chemin).
+     */
+    void reset()
+    {
+        allocations = 0;
+        maxAllocations = 0;
+        paints = 0;
+    }
+
+    quint64 allocations = 0;
+    quint64 maxAllocations = 0;
+    int paints = 0;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        Q_UNUSED(watched);
+        if (event->type() == QEvent::Paint) {
+            painting = true;
+            paintStart = AllocationCounter::threadAllocations();
+        }
+        return false;
+    }
+
+private:
+    bool painting = false;
+    quint64 paintStart = 0;
+};
+
+/**
+ * @class BaselineWidget
+ * @brief Widget de référence : son paintEvent ne fait qu'ouvrir un QPainter, ce que coûte Qt à chaque image.
+ */
+class BaselineWidget : public QWidget
+{
+public:
+    PaintProbe *probe = nullptr;
+
+protected:
+    void paintEvent(QPaintEvent *event) override
+    {
+        Q_UNUSED(event);
+        {
+            QPainter painter(this);
+        }
+        if (probe)
+            probe->finish();
+    }
+};
+
+/**
+ * @brief Affiche un widget de premier niveau et attend qu'il soit exposé.
+ */
+bool showExposed(QWidget &widget)
+{
+    widget.show();
+    QElapsedTimer timer;
+    timer.start();
+    while (!(widget.windowHandle() && widget.windowHandle()->isExposed()) && timer.elapsed() < 5000)
+        QCoreApplication::processEvents();
+    return widget.windowHandle() && widget.windowHandle()->isExposed();
+}
+
+/**
+ * @brief Allocations par dessin d'un chemin de Qt.
+ */
+struct PaintCost
+{
+    quint64 update = 0;
+    quint64 render = 0;
+};
+
+/**
+ * @brief Mesure le coût propre de Qt : allocations maximales d'un dessin du widget de référence.
+ */
+bool measureBaseline(const QSize &size, int frames, PaintCost *cost)
+{
+    BaselineWidget widget;
+    PaintProbe probe(&widget);
+    widget.probe = &probe;
+    widget.resize(size);
+    if (!showExposed(widget))
+        return false;
+
+    QImage image(size, QImage::Format_RGB32);
+    for (int pass = 0; pass < 2; ++pass) {
+        // Première passe : mise en température du backing store et des moteurs de dessin
+        probe.reset();
+        for (int frame = 0; frame < frames; ++frame) {
+            widget.update();
+            QCoreApplication::processEvents();
+        }
+        cost->update = probe.maxAllocations;
+
+        probe.reset();
+        for (int frame = 0; frame < frames; ++frame)
+            widget.render(&image);
+        cost->render = probe.maxAllocations;
+    }
+    return true;
+}
+
+/**
+ * @brief Test des allocations : mise en température, puis comptage image par image.
+ */
+int runAllocations(const TestSupport::Options &options)
+{
+    if (!AllocationCounter::isAvailable()) {
+        out() << "tst_allocations: allocation counting needs the glibc allocator, skipped\n";
+        out().flush();
+        return TestSupport::SkipExitCode;
+    }
+
+    struct AllocationScenario {
+        QString name;
+        int frameStepMs;
+        std::function<void(MatrixDisplay &, ManualFrameClock &)> setup;
+    };
+    const QVector<AllocationScenario> scenarios = {
+        {QStringLiteral("scroll"), 16, [](MatrixDisplay &display, ManualFrameClock &) {
+             display.setText(QStringLiteral("STEADY {#ff8000}STATE {rainbow}SCROLLING 0123456789"));
+             display.setScrollInterval(5);
+             display.setScrollEnabled(true);
+         }},
+        {QStringLiteral("bounce"), 16, [](MatrixDisplay &display, ManualFrameClock &) {
+             display.setText(QStringLiteral("BOUNCING TICKER TEXT 0123456789"));
+             display.setScrollMode(MatrixDisplay::bounceMode);
+             display.setScrollInterval(5);
+             display.setScrollEnabled(true);
+         }},
+        {QStringLiteral("ticker"), 16, [](MatrixDisplay &display, ManualFrameClock &) {
+             // Bande assez longue pour défiler sans nouvel ajout pendant toute la mesure
+             display.setScrollInterval(5);
+             for (int i = 0; i < 40; ++i)
+                 display.appendText(QStringLiteral("{#ff8000}LIVE{} FEED 0123456789   "));
+         }},
+        {QStringLiteral("image"), 16, [](MatrixDisplay &display, ManualFrameClock &) {
+             QVector<int> delaysMs;
+             delaysMs.fill(100, 6);
+             display.zone(0)->setImageConversion(LedImage::ColorDither);
+             display.zone(0)->setAnimation(TestSupport::syntheticAnimation(6), delaysMs);
+             TestSupport::waitForImageConversion(display.zone(0));
+         }},
+        {QStringLiteral("clock"), 250, [](MatrixDisplay &display, ManualFrameClock &clock) {
+             clock.setTime(QTime(10, 59, 0));
+             display.setClockShowSeconds(true);
+             display.setDisplayMode(MatrixDisplay::Clock);
+         }},
+    };
+    // La mise en température couvre un cycle complet : toutes les positions, encres et chiffres ont été vus
+    const int warmupFrames = 2000;
+    const QSize displaySize(1200, 144);
+
+    PaintCost qtCost;
+    if (!measureBaseline(displaySize, 200, &qtCost)) {
+        out() << "tst_allocations: the platform never exposed the window\nFAIL\n";
+        out().flush();
+        return 1;
+    }
+
+    int failures = 0;
+    out() << "tst_allocations: " << warmupFrames << " warm-up frames, " << options.frames << " measured frames\n"
+          << "  Qt cost per paint: update " << qtCost.update << ", render " << qtCost.render << " allocations\n";
+    for (const AllocationScenario &scenario : scenarios) {
+        ManualFrameClock clock;
+        MatrixDisplay display;
+        display.setPowerSavingEnabled(false);
+        display.setClock(&clock);
+        display.resize(displaySize);
+        scenario.setup(display, clock);
+
+        PaintProbe probe(&display);
+        QObject::connect(&display, &MatrixDisplay::framePainted, &probe, [&probe]() {
+            probe.finish();
+        });
+        if (!showExposed(display)) {
+            out() << "  " << scenario.name.leftJustified(8) << "window never exposed  FAIL\n";
+            ++failures;
+            continue;
+        }
+
+        QImage image(display.size(), QImage::Format_RGB32);
+        quint64 contentAllocations = 0;
+        quint64 updateAllocations = 0;
+        quint64 renderAllocations = 0;
+        int updatePaints = 0;
+        int renderPaints = 0;
+        for (int frame = 0; frame < warmupFrames + options.frames; ++frame) {
+            const bool measured = frame >= warmupFrames;
+            clock.advance(scenario.frameStepMs);
+
+            const quint64 beforeContent = AllocationCounter::threadAllocations();
+            display.tick();
+            display.displayFrame();
+            const quint64 afterContent = AllocationCounter::threadAllocations();
+
+            // Cycle réel d'une matrice affichée : update(), puis paintEvent livré par la boucle d'événements
+            probe.reset();
+            display.update();
+            QCoreApplication::processEvents();
+            const quint64 updateExtra = probe.allocations
+                                        - std::min(probe.allocations, probe.paints * qtCost.update);
+            const int updateCount = probe.paints;
+
+            // Rendu hors écran du même widget (captures, aperçus)
+            probe.reset();
+            display.render(&image);
+            const quint64 renderExtra = probe.allocations
+                                        - std::min(probe.allocations, probe.paints * qtCost.render);
+            const int renderCount = probe.paints;
+
+            if (measured) {
+                contentAllocations += afterContent - beforeContent;
+                updateAllocations += updateExtra;
+                renderAllocations += renderExtra;
+                updatePaints += updateCount;
+                renderPaints += renderCount;
+            }
+        }
+
+        // Chaque image mesurée doit avoir été dessinée par les deux chemins
+        const bool painted = updatePaints >= options.frames && renderPaints >= options.frames;
+        const bool ok = painted && contentAllocations == 0 && updateAllocations == 0 && renderAllocations == 0;
+        if (!ok)
+            ++failures;
+        out() << "  " << scenario.name.leftJustified(8) << "content: " << contentAllocations
+              << ", paintEvent after update(): " << updateAllocations << " (" << updatePaints << " paints)"
+              << ", render(): " << renderAllocations << " (" << renderPaints << " paints)"
+              << (ok ? "" : "  FAIL") << "\n";
+    }
+
+    out() << (failures == 0 ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return failures == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runAllocations);
+}
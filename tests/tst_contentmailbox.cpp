@@ -0,0 +1,131 @@
+/**
+ * @file tst_contentmailbox.cpp
+ * @author G. Maxime
+ * @brief Test de la boîte aux lettres des producteurs : plusieurs threads déposent du
+ * contenu en continu via les méthodes post*() de MatrixDisplay ; vérifie que chaque état
+ * appliqué est complet, que les états d'un même producteur ne reculent jamais et que le
+ * dernier dépôt est bien appliqué.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QThread>
+#include <QTimer>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Stress de la boîte des producteurs : dépôts concurrents, relevé par le thread GUI.
+ */
+int runMailboxStress(const TestSupport::Options &options)
+{
+    MatrixDisplay display;
+    // La matrice n'est jamais affichée : la veille ne doit pas l'arrêter
+    display.setPowerSavingEnabled(false);
+
+    const int threadCount = options.threads;
+    std::atomic<bool> stop{false};
+    std::vector<quint64> postCounts(threadCount, 0);
+    std::vector<qint64> lastSequence(threadCount, -1);
+    quint64 appliedStates = 0;
+    quint64 violations = 0;
+    QString lastText;
+
+    // Chaque état appliqué doit être complet et ne jamais reculer pour un même producteur
+    QObject::connect(display.zone(0), &MatrixZone::changed, &display, [&]() {
+        // Les pas de défilement émettent aussi changed() : seuls les nouveaux textes comptent
+        const QString text = display.zone(0)->text();
+        if (text == lastText || text.isEmpty() || text == QStringLiteral("FINAL"))
+            return;
+        lastText = text;
+        const QStringList parts = text.mid(1).split(QLatin1Char('-'));
+        bool okThread = false;
+        bool okSequence = false;
+        const int thread = parts.size() == 2 ? parts[0].toInt(&okThread) : -1;
+        const qint64 sequence = parts.size() == 2 ? parts[1].toLongLong(&okSequence) : -1;
+        if (!text.startsWith(QStringLiteral("T")) || !okThread || !okSequence || thread < 0 || thread >= threadCount) {
+            ++violations;
+            return;
+        }
+        if (sequence < lastSequence[thread])
+            ++violations;
+        lastSequence[thread] = sequence;
+        ++appliedStates;
+    });
+
+    std::vector<std::unique_ptr<QThread>> producers;
+    for (int index = 0; index < threadCount; ++index) {
+        producers.emplace_back(QThread::create([&, index]() {
+            quint64 sequence = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                display.postText(QStringLiteral("T%1-%2").arg(index).arg(sequence));
+                if (sequence % 7 == 0)
+                    display.postColor(QColor::fromHsv(static_cast<int>(sequence % 360), 255, 255));
+                if (sequence % 13 == 0)
+                    display.postScrollEnabled(sequence % 2 == 0);
+                if (sequence % 17 == 0)
+                    display.postScrollSpeed(static_cast<int>(sequence % 5) + 1);
+                ++sequence;
+            }
+            postCounts[index] = sequence;
+        }));
+    }
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    for (const auto &producer : producers)
+        producer->start();
+
+    QEventLoop loop;
+    QTimer::singleShot(options.durationMs, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    stop.store(true, std::memory_order_relaxed);
+    for (const auto &producer : producers)
+        producer->wait();
+    const qint64 durationMs = std::max<qint64>(1, elapsed.elapsed());
+
+    // Le dernier dépôt doit être appliqué au plus une image plus tard
+    display.postText(QStringLiteral("FINAL"));
+    QElapsedTimer deadline;
+    deadline.start();
+    while (display.zone(0)->text() != QStringLiteral("FINAL") && deadline.elapsed() < 1000) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+    }
+    const bool finalApplied = display.zone(0)->text() == QStringLiteral("FINAL");
+
+    quint64 totalPosts = 0;
+    for (quint64 count : postCounts)
+        totalPosts += count;
+
+    out() << "tst_contentmailbox: " << threadCount << " producer threads, " << durationMs << " ms\n"
+          << "  text posts:      " << totalPosts << " (" << (totalPosts * 1000 / durationMs) << "/s)\n"
+          << "  applied states:  " << appliedStates << " (" << (appliedStates * 1000 / durationMs) << "/s)\n"
+          << "  dropped states:  " << (totalPosts > appliedStates ? totalPosts - appliedStates : 0) << "\n"
+          << "  violations:      " << violations << "\n"
+          << "  final state:     " << (finalApplied ? "applied" : "MISSING") << "\n";
+    out().flush();
+
+    return (violations == 0 && finalApplied) ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runMailboxStress);
+}
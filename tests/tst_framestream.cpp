@@ -0,0 +1,314 @@
+/**
+ * @file tst_framestream.cpp
+ * @author G. Maxime
+ * @brief Test de la diffusion TCP : un défilement puis une horloge sont diffusés à
+ * --clients visualiseurs locaux ; affiche le débit et le temps CPU du serveur par
+ * visualiseur, vérifie que chaque visualiseur reconstruit exactement la dernière image,
+ * puis qu'un visualiseur bloqué ne fait pas croître le tampon du serveur au-delà de son plafond.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/frameclock.h"
+#include "headers/framestream.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHostAddress>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRandomGenerator>
+#include <QTcpSocket>
+#include <QThread>
+
+// Inclusion des headers standard nécessaires
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <ctime>
+#endif
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Temps CPU consommé par le thread appelant, en nanosecondes (-1 si indisponible).
+ */
+qint64 threadCpuNs()
+{
+#ifdef Q_OS_UNIX
+    timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0)
+        return static_cast<qint64>(now.tv_sec) * 1000000000 + now.tv_nsec;
+#endif
+    return -1;
+}
+
+/**
+ * @class StreamViewers
+ * @brief Visualiseurs d'un FrameStreamServer, dans un thread à part pour que leur
+ * décodage ne soit pas compté dans le temps CPU du serveur.
+ * Un visualiseur supplémentaire, bloqué, ne lit jamais ce qu'il reçoit.
+ */
+class StreamViewers
+{
+public:
+    StreamViewers(quint16 port, int count, bool withStalled)
+    {
+        thread.reset(QThread::create([this, port, count, withStalled]() {
+            std::vector<FrameStreamDecoder> decoders(static_cast<size_t>(count));
+            std::vector<std::unique_ptr<QTcpSocket>> sockets;
+            for (int index = 0; index < count; ++index) {
+                auto socket = std::make_unique<QTcpSocket>();
+                QTcpSocket *raw = socket.get();
+                FrameStreamDecoder *decoder = &decoders[static_cast<size_t>(index)];
+                QObject::connect(raw, &QTcpSocket::readyRead, raw, [this, raw, decoder]() {
+                    QString error;
+                    if (decoder->feed(raw->readAll(), &error) < 0)
+                        ++errors;
+                });
+                raw->connectToHost(QHostAddress(QHostAddress::LocalHost), port);
+                if (!raw->waitForConnected(2000))
+                    ++errors;
+                sockets.push_back(std::move(socket));
+            }
+            if (withStalled) {
+                // Aucun readyRead et un tampon de lecture d'un octet : les images s'accumulent côté serveur
+                auto stalled = std::make_unique<QTcpSocket>();
+                stalled->setReadBufferSize(1);
+                stalled->connectToHost(QHostAddress(QHostAddress::LocalHost), port);
+                if (!stalled->waitForConnected(2000))
+                    ++errors;
+                sockets.push_back(std::move(stalled));
+            }
+            ready.store(true, std::memory_order_release);
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+                int matching = 0;
+                {
+                    QMutexLocker locker(&expectedMutex);
+                    if (!expected.empty()) {
+                        for (const FrameStreamDecoder &decoder : decoders) {
+                            if (decoder.hasFrame() && decoder.packed() == expected)
+                                ++matching;
+                        }
+                    }
+                }
+                synced.store(matching, std::memory_order_release);
+                QThread::usleep(500);
+            }
+            for (const FrameStreamDecoder &decoder : decoders) {
+                keyframes += decoder.keyframes();
+                deltas += decoder.deltas();
+            }
+        }));
+        thread->start();
+    }
+
+    ~StreamViewers()
+    {
+        stop.store(true, std::memory_order_relaxed);
+        thread->wait();
+    }
+
+    /**
+     * @brief Attend que tous les visualiseurs soient connectés, en traitant les événements du serveur.
+     */
+    bool waitReady(int timeoutMs)
+    {
+        QElapsedTimer deadline;
+        deadline.start();
+        while (!ready.load(std::memory_order_acquire) && deadline.elapsed() < timeoutMs)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+        // Connexions acceptées et images clés envoyées par le thread du serveur
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+        return ready.load(std::memory_order_acquire) && errors.load() == 0;
+    }
+
+    /**
+     * @brief Attend que chaque visualiseur non bloqué ait reconstruit le plan attendu.
+     */
+    int waitSynced(const std::vector<quint8> &plane, int count, int timeoutMs)
+    {
+        {
+            QMutexLocker locker(&expectedMutex);
+            expected = plane;
+            synced.store(0, std::memory_order_relaxed);
+        }
+        QElapsedTimer deadline;
+        deadline.start();
+        while (synced.load(std::memory_order_acquire) < count && deadline.elapsed() < timeoutMs) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+            QThread::usleep(500);
+        }
+        return synced.load(std::memory_order_acquire);
+    }
+
+    std::atomic<quint64> errors{0};
+    quint64 keyframes = 0;
+    quint64 deltas = 0;
+
+private:
+    std::unique_ptr<QThread> thread;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> ready{false};
+    std::atomic<int> synced{0};
+    QMutex expectedMutex;
+    std::vector<quint8> expected;
+};
+
+/**
+ * @brief Diffusion TCP : débit et coût CPU par visualiseur pour un défilement et une
+ * horloge, reconstruction exacte chez chaque visualiseur, puis tampon borné pour un
+ * visualiseur bloqué.
+ */
+int runFrameStream(const TestSupport::Options &options)
+{
+    struct StreamScenario {
+        QString name;
+        int frameStepMs;
+        std::function<void(MatrixDisplay &, ManualFrameClock &)> setup;
+    };
+    const QVector<StreamScenario> scenarios = {
+        {QStringLiteral("scroll"), 16, [](MatrixDisplay &display, ManualFrameClock &) {
+             display.setText(QStringLiteral("REMOTE {#ff8000}VIEWERS {rainbow}STREAMING 0123456789"));
+             display.setScrollInterval(5);
+             display.setScrollEnabled(true);
+         }},
+        {QStringLiteral("clock"), 16, [](MatrixDisplay &display, ManualFrameClock &clock) {
+             clock.setTime(QTime(10, 59, 0));
+             display.setClockShowSeconds(true);
+             display.setDisplayMode(MatrixDisplay::Clock);
+         }},
+    };
+
+    int failures = 0;
+    out() << "tst_framestream: " << options.clients << " viewers, " << options.frames << " frames per scenario\n";
+    for (const StreamScenario &scenario : scenarios) {
+        ManualFrameClock clock;
+        MatrixDisplay display;
+        display.setPowerSavingEnabled(false);
+        display.setClock(&clock);
+        display.resize(1200, 144);
+        scenario.setup(display, clock);
+        QString error;
+        if (!display.startFrameStream(0, &error)) {
+            out() << "  " << scenario.name << ": " << error << "  FAIL\n";
+            ++failures;
+            continue;
+        }
+        FrameStreamServer *server = display.frameStream();
+        display.displayFrame();
+
+        StreamViewers viewers(server->port(), options.clients, false);
+        if (!viewers.waitReady(10000)) {
+            out() << "  " << scenario.name << ": viewers could not connect  FAIL\n";
+            ++failures;
+            continue;
+        }
+
+        // Seules la présentation (dont publish()) et la boucle d'événements (écritures des sockets) sont comptées
+        const bool cpuAvailable = threadCpuNs() >= 0;
+        const FrameStreamServer::Statistics before = server->statistics();
+        qint64 serverCpuNs = 0;
+        for (int frame = 0; frame < options.frames; ++frame) {
+            clock.advance(scenario.frameStepMs);
+            display.tick();
+            const qint64 cpuStart = threadCpuNs();
+            display.displayFrame();
+            QCoreApplication::processEvents();
+            serverCpuNs += threadCpuNs() - cpuStart;
+        }
+        const FrameStreamServer::Statistics after = server->statistics();
+
+        std::vector<quint8> expected;
+        FrameStreamServer::packFrame(display.displayFrame(), &expected);
+        const int synced = viewers.waitSynced(expected, options.clients, 5000);
+
+        const double seconds = options.frames * scenario.frameStepMs / 1000.0;
+        const quint64 bytes = after.bytesSent - before.bytesSent;
+        const quint64 encoded = after.framesEncoded - before.framesEncoded;
+        const double bytesPerClient = bytes / seconds / options.clients;
+        const double cpuUsPerClient = serverCpuNs / 1000.0 / seconds / options.clients;
+        const bool ok = synced == options.clients && viewers.errors.load() == 0;
+        if (!ok)
+            ++failures;
+        out() << "  " << scenario.name.leftJustified(8) << encoded << " changed frames, keyframe "
+              << after.keyframeBytes << " bytes, "
+              << (encoded > 0 ? (after.deltaBytes - before.deltaBytes) / encoded : 0) << " bytes/delta\n"
+              << "          " << qRound64(bytesPerClient) << " bytes/s per viewer, server CPU "
+              << (!cpuAvailable ? QStringLiteral("n/a") : QString::number(cpuUsPerClient, 'f', 1))
+              << " us/s per viewer (encode " << QString::number((after.publishNs - before.publishNs) / 1000.0 / seconds, 'f', 1)
+              << " us/s)\n"
+              << "          viewers in sync: " << synced << "/" << options.clients
+              << ", stream errors: " << viewers.errors.load() << (ok ? "" : "  FAIL") << "\n";
+    }
+
+    // Visualiseur bloqué : plein écran de bruit à chaque image, le tampon côté serveur doit rester borné
+    {
+        FrameStreamServer server;
+        const qint64 limit = 64 * 1024;
+        server.setMaxPendingBytes(limit);
+        QString error;
+        if (!server.listen(0, &error)) {
+            out() << "  stalled: " << error << "  FAIL\n";
+            out().flush();
+            return 1;
+        }
+        // Nombre d'images fixe : assez d'octets pour remplir les tampons du noyau sur la boucle locale
+        const int noiseFrames = 600;
+        LedFrame frame(256, 128);
+        frame.setInkDepth(8);
+        LedPalette palette(8);
+        QRandomGenerator random(45);
+        StreamViewers viewers(server.port(), 1, true);
+        bool ok = viewers.waitReady(10000);
+        for (int index = 0; ok && index < noiseFrames; ++index) {
+            quint8 *levels = frame.data();
+            quint8 *inks = frame.inkData();
+            for (int led = 0; led < frame.ledCount(); ++led) {
+                const quint32 value = random.generate();
+                levels[led] = static_cast<quint8>(value);
+                inks[led] = static_cast<quint8>(value >> 8);
+            }
+            server.publish(frame, palette);
+            QCoreApplication::processEvents();
+        }
+        std::vector<quint8> expected;
+        FrameStreamServer::packFrame(frame, &expected);
+        const int synced = ok ? viewers.waitSynced(expected, 1, 5000) : 0;
+        const FrameStreamServer::Statistics stats = server.statistics();
+
+        // Une image au plus peut être confiée au-delà du plafond (le test précède l'écriture)
+        const qint64 bound = limit + 2 * FrameStreamServer::packedBytes(frame.cols(), frame.rows(), frame.inkDepth());
+        const bool boundOk = stats.peakPendingBytes <= bound;
+        ok = ok && boundOk && stats.framesSkipped > 0 && synced == 1;
+        if (!ok)
+            ++failures;
+        out() << "  stalled viewer: " << noiseFrames << " noise frames of " << frame.cols() << "x" << frame.rows()
+              << ", limit " << limit << " bytes\n"
+              << "          peak pending " << stats.peakPendingBytes << " bytes (bound " << bound << ")"
+              << (boundOk ? "" : "  FAIL") << ", frames skipped " << stats.framesSkipped
+              << ", live viewer in sync: " << (synced == 1 ? "yes" : "NO") << (ok ? "" : "  FAIL") << "\n";
+    }
+
+    out() << (failures == 0 ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return failures == 0 ? 0 : 1;
+}
+
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runFrameStream);
+}
@@ -0,0 +1,350 @@
+/**
+ * @file tst_goldenframes.cpp
+ * @author G. Maxime
+ * @brief Test des images de référence : rejoue des séquences de défilement, de rebond,
+ * d'horloge, de zones, d'animation d'image et de transitions avec une horloge manuelle,
+ * et compare l'empreinte de chaque image au fichier de référence tests/golden/goldenframes.txt.
+ * Avec --record FICHIER, les empreintes sont enregistrées au lieu d'être vérifiées ; avec
+ * --timing, chaque image doit aussi être dessinée dans le budget de temps de sa séquence.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/frameclock.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QTextStream>
+#include <QTime>
+#include <QVector>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <functional>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief En-tête du fichier de référence.
+ */
+const char kGoldenFileHeader[] =
+    "# Golden frames of tst_goldenframes: one \"scenario frame fnv1a64(LedFrame)\" line per frame.\n"
+    "# Re-record on a known-good build with: cmake --build <build> --target record_golden_frames\n";
+
+/**
+ * @struct GoldenScenario
+ * @brief Séquence d'images rejouée par le test des images de référence.
+ */
+struct GoldenScenario
+{
+    /**
+     * @brief Nom de la séquence dans le fichier de référence.
+     */
+    QString name;
+
+    /**
+     * @brief Nombre d'images de la séquence.
+     */
+    int frames;
+
+    /**
+     * @brief Avance de l'horloge entre deux images, en millisecondes.
+     */
+    int frameStepMs;
+
+    /**
+     * @brief Budget de temps de rendu par image, en millisecondes.
+     */
+    double renderBudgetMs;
+
+    /**
+     * @brief Configuration de la matrice avant la première image.
+     */
+    std::function<void(MatrixDisplay &, ManualFrameClock &)> setup;
+
+    /**
+     * @brief Action éventuelle avant l'image d'indice donné (changement de texte, de taille…).
+     */
+    std::function<void(MatrixDisplay &, int)> step;
+};
+
+/**
+ * @brief Séquences de référence : défilement, rebond, horloge, zones, couleurs, images et transitions.
+ */
+QVector<GoldenScenario> goldenScenarios()
+{
+    const QString longText = QStringLiteral("GOLDEN FRAMES 0123456789 SCROLL");
+
+    return {
+        {QStringLiteral("scroll-default"), 600, 16, 25.0,
+         [longText](MatrixDisplay &display, ManualFrameClock &) {
+             display.setText(longText);
+             display.setScrollMode(MatrixDisplay::defaultMode);
+             display.setScrollInterval(5);
+             display.setScrollEnabled(true);
+         }, nullptr},
+        {QStringLiteral("scroll-bounce-long"), 600, 16, 25.0,
+         [longText](MatrixDisplay &display, ManualFrameClock &) {
+             display.setText(longText);
+             display.setScrollMode(MatrixDisplay::bounceMode);
+             display.setScrollInterval(4);
+             display.setScrollEnabled(true);
+         }, nullptr},
+        {QStringLiteral("scroll-bounce-short"), 300, 16, 25.0,
+         [](MatrixDisplay &display, ManualFrameClock &) {
+             display.setText(QStringLiteral("HI"));
+             display.setScrollMode(MatrixDisplay::bounceMode);
+             display.setScrollInterval(5);
+             display.setScrollEnabled(true);
+         }, nullptr},
+        {QStringLiteral("scroll-matrix-resize"), 400, 33, 25.0,
+         [longText](MatrixDisplay &display, ManualFrameClock &) {
+             display.setText(longText);
+             display.setScrollInterval(3);
+             display.setScrollEnabled(true);
+         },
+         [](MatrixDisplay &display, int frame) {
+             if (frame == 150)
+                 display.setMatrixSize(64, 12);
+             else if (frame == 300)
+                 display.setScrollInterval(1);
+         }},
+        {QStringLiteral("scroll-long-message"), 300, 16, 25.0,
+         [](MatrixDisplay &display, ManualFrameClock &clock) {
+             // Fil d'actualité de 100 000 caractères : même budget par image qu'un texte court
+             QString message;
+             message.reserve(100000);
+             while (message.size() < 100000)
+                 message += QStringLiteral("{red}NEWS{} 0123456789 ");
+             display.setText(message);
+             display.setScrollInterval(5);
+             display.setScrollEnabled(true);
+             // Milieu du message : seuls les glyphes visibles doivent être parcourus
+             clock.advance(20 * 50000);
+         }, nullptr},
+        {QStringLiteral("clock-24h-seconds"), 48, 250, 25.0,
+         [](MatrixDisplay &display, ManualFrameClock &clock) {
+             clock.setTime(QTime(23, 59, 55));
+             display.setClockShowSeconds(true);
+             display.setClockFormat(MatrixDisplay::Format24h);
+             display.setDisplayMode(MatrixDisplay::Clock);
+         }, nullptr},
+        {QStringLiteral("clock-12h"), 24, 250, 25.0,
+         [](MatrixDisplay &display, ManualFrameClock &clock) {
+             clock.setTime(QTime(12, 59, 58));
+             display.setClockFormat(MatrixDisplay::Format12h);
+             display.setDisplayMode(MatrixDisplay::Clock);
+         }, nullptr},
+        {QStringLiteral("zones-markup"), 400, 16, 30.0,
+         [](MatrixDisplay &display, ManualFrameClock &clock) {
+             clock.setTime(QTime(9, 41, 0));
+             display.setMatrixSize(160, 12);
+             display.zone(0)->setArea(QRect(0, 0, 60, 12));
+             display.setDisplayMode(MatrixDisplay::Clock);
+             MatrixZone *ticker = display.zone(display.addZone(QRect(60, 0, 100, 12)));
+             ticker->setText(QStringLiteral("{red}ALERT{} {#00ff00}GREEN {rainbow}RAINBOW"));
+             ticker->setScrollInterval(3);
+             ticker->setScrollEnabled(true);
+         }, nullptr},
+        {QStringLiteral("ticker-append"), 600, 16, 25.0,
+         [](MatrixDisplay &display, ManualFrameClock &) {
+             display.setScrollInterval(5);
+             display.appendText(QStringLiteral("{red}BREAKING{} FIRST HEADLINE   "));
+         },
+         [](MatrixDisplay &display, int frame) {
+             // Ajout en cours de défilement, puis après épuisement de la bande
+             if (frame == 60)
+                 display.appendText(QStringLiteral("SECOND {#00ffff}HEADLINE   "));
+             else if (frame == 450)
+                 display.appendText(QStringLiteral("{rainbow}AFTER IDLE   "));
+         }},
+        {QStringLiteral("image-animation"), 400, 16, 25.0,
+         [](MatrixDisplay &display, ManualFrameClock &) {
+             // Conversion faite une fois au chargement : la lecture ne fait qu'échanger des images
+             QVector<int> delaysMs;
+             delaysMs.fill(120, 8);
+             display.zone(0)->setImageConversion(LedImage::ColorDither);
+             display.zone(0)->setAnimation(TestSupport::syntheticAnimation(8), delaysMs);
+             TestSupport::waitForImageConversion(display.zone(0));
+         },
+         [](MatrixDisplay &display, int frame) {
+             // Nouvelle conversion, puis nouvelle taille : les images sont reconverties
+             if (frame == 150)
+                 display.setImageConversion(LedImage::OrderedDither);
+             else if (frame == 280)
+                 display.setMatrixSize(64, 16);
+             TestSupport::waitForImageConversion(display.zone(0));
+         }},
+        {QStringLiteral("crossfade-afterglow"), 150, 16, 25.0,
+         [](MatrixDisplay &display, ManualFrameClock &) {
+             display.setTransitionEffect(LedEffects::Crossfade, 400);
+             display.setAfterglow(150);
+             display.setText(QStringLiteral("FIRST"));
+         },
+         [](MatrixDisplay &display, int frame) {
+             if (frame == 30)
+                 display.setText(QStringLiteral("SECOND"));
+             else if (frame == 90)
+                 display.setText(QStringLiteral("{#ff8000}THIRD"));
+         }},
+    };
+}
+
+/**
+ * @brief Lit un fichier de référence : une ligne « séquence image empreinte » par image.
+ */
+bool readGoldenFile(const QString &path, QHash<QString, QVector<quint64>> *golden, QString *errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        *errorMessage = QStringLiteral("Cannot open %1").arg(path);
+        return false;
+    }
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        const QString line = in.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith(QStringLiteral("#")))
+            continue;
+        const QStringList fields = line.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+        bool okIndex = false;
+        bool okHash = false;
+        const int index = fields.size() == 3 ? fields[1].toInt(&okIndex) : -1;
+        const quint64 hash = fields.size() == 3 ? fields[2].toULongLong(&okHash, 16) : 0;
+        QVector<quint64> &hashes = (*golden)[fields.value(0)];
+        if (!okIndex || !okHash || index != hashes.size()) {
+            *errorMessage = QStringLiteral("%1:%2: malformed golden frame line").arg(path).arg(lineNumber);
+            return false;
+        }
+        hashes.append(hash);
+    }
+    return true;
+}
+
+/**
+ * @brief Rejoue les séquences de référence : empreinte de chaque image et budget de rendu.
+ */
+int runGoldenFrames(const TestSupport::Options &options)
+{
+    const QString referencePath = QStringLiteral(MATRIX_GOLDEN_FILE);
+    const bool recording = !options.recordPath.isEmpty();
+    QHash<QString, QVector<quint64>> golden;
+    if (!recording) {
+        QString errorMessage;
+        if (!readGoldenFile(referencePath, &golden, &errorMessage)) {
+            out() << "tst_goldenframes: " << errorMessage << "\n";
+            out().flush();
+            return 1;
+        }
+    }
+
+    QFile recordFile(options.recordPath);
+    QTextStream record(&recordFile);
+    if (recording) {
+        if (!recordFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            out() << "tst_goldenframes: cannot write " << options.recordPath << "\n";
+            out().flush();
+            return 1;
+        }
+        record << kGoldenFileHeader;
+    }
+
+    int failures = 0;
+    out() << "tst_goldenframes: " << (recording ? "recording " + options.recordPath : "checking " + referencePath) << "\n";
+    const QVector<GoldenScenario> scenarios = goldenScenarios();
+    for (const GoldenScenario &scenario : scenarios) {
+        ManualFrameClock clock;
+        MatrixDisplay display;
+        display.setPowerSavingEnabled(false);
+        display.setClock(&clock);
+        display.resize(1200, 144);
+        scenario.setup(display, clock);
+
+        QImage image(display.size(), QImage::Format_RGB32);
+        const QVector<quint64> expected = golden.value(scenario.name);
+        int mismatches = 0;
+        int firstMismatch = -1;
+        double totalRenderMs = 0.0;
+        double maxRenderMs = 0.0;
+
+        for (int frame = 0; frame < scenario.frames; ++frame) {
+            if (scenario.step)
+                scenario.step(display, frame);
+            display.tick();
+            const quint64 hash = display.displayFrame().hash();
+
+            QElapsedTimer renderTimer;
+            renderTimer.start();
+            display.render(&image);
+            const double renderMs = renderTimer.nsecsElapsed() / 1e6;
+            totalRenderMs += renderMs;
+            // La première image paie les allocations initiales : elle n'entre pas dans le budget
+            if (frame > 0)
+                maxRenderMs = std::max(maxRenderMs, renderMs);
+
+            if (recording)
+                record << scenario.name << ' ' << frame << ' ' << QString::number(hash, 16) << '\n';
+            else if (frame >= expected.size() || expected[frame] != hash) {
+                if (firstMismatch < 0)
+                    firstMismatch = frame;
+                ++mismatches;
+            }
+            clock.advance(scenario.frameStepMs);
+        }
+
+        // Une séquence sans empreintes enregistrées est un échec, pas une séquence ignorée
+        const double budgetMs = scenario.renderBudgetMs * options.budgetScale;
+        const bool overBudget = options.timing && maxRenderMs > budgetMs;
+        const bool missingFrames = !recording && expected.size() != scenario.frames;
+        if (mismatches > 0 || overBudget || missingFrames)
+            ++failures;
+
+        out() << "  " << scenario.name.leftJustified(22) << scenario.frames << " frames";
+        if (!recording) {
+            if (mismatches == 0 && !missingFrames)
+                out() << "  hashes ok";
+            else if (expected.isEmpty())
+                out() << "  NO GOLDEN HASHES";
+            else if (mismatches == 0)
+                out() << "  " << expected.size() << " GOLDEN HASHES FOR " << scenario.frames << " FRAMES";
+            else
+                out() << "  " << mismatches << " MISMATCHES (first at frame " << firstMismatch << ")";
+        }
+        out() << "  render avg " << QString::number(totalRenderMs / scenario.frames, 'f', 2)
+              << " ms, max " << QString::number(maxRenderMs, 'f', 2)
+              << " ms (budget " << QString::number(budgetMs, 'f', 1) << " ms)"
+              << (overBudget ? "  OVER BUDGET" : "") << "\n";
+    }
+
+    // Empreintes d'une séquence supprimée ou renommée : le fichier de référence doit être réenregistré
+    for (auto it = golden.constBegin(); it != golden.constEnd(); ++it) {
+        const bool known = std::any_of(scenarios.begin(), scenarios.end(),
+                                       [&](const GoldenScenario &scenario) { return scenario.name == it.key(); });
+        if (!known) {
+            out() << "  " << it.key().leftJustified(22) << "UNKNOWN SCENARIO in " << referencePath << "\n";
+            ++failures;
+        }
+    }
+
+    if (recording)
+        out() << "golden hashes written to " << options.recordPath << "\n";
+    else if (failures > 0)
+        out() << "re-record with: cmake --build <build> --target record_golden_frames (after checking the change is intended)\n";
+    out() << (failures == 0 ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return failures == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runGoldenFrames);
+}
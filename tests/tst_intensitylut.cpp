@@ -0,0 +1,179 @@
+/**
+ * @file tst_intensitylut.cpp
+ * @author G. Maxime
+ * @brief Test de la table de réponse des LED : compare la table au calcul gamma par LED
+ * (--frames images) et affiche leurs coûts, vérifie qu'un changement de luminosité ne coûte
+ * qu'une reconstruction de table, et qu'un panneau simulé en plans de bit est stable sur des
+ * cycles entiers, scintille sinon, avec une intensité moyenne juste.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/frameclock.h"
+#include "headers/intensitylut.h"
+#include "headers/ledframe.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QVector>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Table de réponse des LED : exactitude et coût face au calcul par LED, une seule
+ * reconstruction par changement de luminosité, et simulation des plans de bit stable sur
+ * des cycles entiers, scintillante sinon, juste en moyenne.
+ */
+int runIntensityLut(const TestSupport::Options &options)
+{
+    int failures = 0;
+    const double gamma = 2.2;
+    const double brightness = 0.6;
+    const auto mapLevel = [](int level, double gamma, double brightness) {
+        return level == 0 ? 0 : static_cast<int>(std::lround(255.0 * brightness * std::pow(level / 255.0, gamma)));
+    };
+
+    // Plans aléatoires à 30 % de LED allumées, intensités 8 bits
+    out() << "tst_intensitylut: " << options.frames << " frames of 250x60 LEDs\n";
+    IntensityLut lut;
+    lut.setResponse(gamma, brightness);
+    QRandomGenerator random(50);
+    LedFrame frame(250, 60);
+    LedFrame naive(250, 60);
+    bool exact = true;
+    qint64 tableNs = 0;
+    qint64 naiveNs = 0;
+    for (int index = 0; index < options.frames; ++index) {
+        for (int led = 0; led < frame.ledCount(); ++led) {
+            const quint32 value = random.generate();
+            frame.data()[led] = (value % 10) < 3 ? static_cast<quint8>(value >> 8) : 0;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        const LedFrame &mapped = lut.apply(frame, index * 16);
+        tableNs += timer.nsecsElapsed();
+        timer.restart();
+        for (int led = 0; led < frame.ledCount(); ++led)
+            naive.data()[led] = static_cast<quint8>(mapLevel(frame.data()[led], gamma, brightness));
+        naiveNs += timer.nsecsElapsed();
+        exact = exact && std::memcmp(mapped.data(), naive.data(), static_cast<size_t>(frame.ledCount())) == 0;
+    }
+    if (!exact)
+        ++failures;
+    out() << "  table:      " << (tableNs / options.frames) << " ns per frame (per-LED math "
+          << (naiveNs / options.frames) << " ns)" << (exact ? "" : "  FAIL (differs from the per-LED math)") << "\n";
+
+    // Variation de luminosité : une reconstruction de table par réglage
+    const quint64 buildsBefore = lut.statistics().tableBuilds;
+    const int steps = 100;
+    QElapsedTimer sweepTimer;
+    sweepTimer.start();
+    for (int step = 1; step <= steps; ++step) {
+        lut.setResponse(gamma, step / static_cast<double>(steps));
+        lut.apply(frame, (options.frames + step) * 16);
+    }
+    const qint64 sweepNs = sweepTimer.nsecsElapsed();
+    const quint64 builds = lut.statistics().tableBuilds - buildsBefore;
+    const bool sweepOk = builds == static_cast<quint64>(steps)
+                         && lut.table()[255] == mapLevel(255, gamma, 1.0);
+    if (!sweepOk)
+        ++failures;
+    out() << "  brightness: " << steps << " changes, " << builds << " table builds, "
+          << (sweepNs / steps) << " ns per change and frame" << (sweepOk ? "" : "  FAIL") << "\n";
+
+    // Plans de bit sur cycles entiers : image stable, niveaux du panneau 4 bits
+    const int bits = 4;
+    const int maxCode = (1 << bits) - 1;
+    IntensityLut planes;
+    planes.setResponse(gamma, brightness);
+    planes.setBitPlanes(bits, 100);
+    bool stable = true;
+    for (int index = 0; index < 20; ++index) {
+        planes.apply(frame, index * 20);
+        stable = stable && (index < 2 || !planes.isAnimating());
+    }
+    bool quantized = true;
+    QVector<int> expected(256);
+    for (int level = 0; level < 256; ++level) {
+        const int code = (mapLevel(level, gamma, brightness) * maxCode + 127) / 255;
+        expected[level] = static_cast<int>(std::lround(code * 255.0 / maxCode));
+        quantized = quantized && planes.table()[static_cast<size_t>(level)] == expected[level];
+    }
+    const bool wholeOk = stable && quantized;
+    if (!wholeOk)
+        ++failures;
+    out() << "  planes:     " << bits << " bits at 100 Hz, 20 ms frames: " << (stable ? "stable" : "FAIL (flickers)")
+          << ", " << (quantized ? "panel levels" : "FAIL (levels differ from the panel)") << "\n";
+
+    // Fenêtre d'exposition hors cycles entiers : scintillement, moyenne juste sur 9 cycles
+    planes.setBitPlanes(bits, 90);
+    planes.apply(frame, 980);
+    const int beatFrames = 50;
+    std::vector<double> sums(256, 0.0);
+    std::vector<int> lows(256, 255);
+    std::vector<int> highs(256, 0);
+    bool flickered = false;
+    for (int index = 0; index < beatFrames; ++index) {
+        planes.apply(frame, 1000 + index * 20);
+        flickered = flickered || planes.isAnimating();
+        for (int level = 0; level < 256; ++level) {
+            const int value = planes.table()[static_cast<size_t>(level)];
+            sums[static_cast<size_t>(level)] += value;
+            lows[static_cast<size_t>(level)] = std::min(lows[static_cast<size_t>(level)], value);
+            highs[static_cast<size_t>(level)] = std::max(highs[static_cast<size_t>(level)], value);
+        }
+    }
+    double worstMean = 0.0;
+    int worstSwing = 0;
+    for (int level = 0; level < 256; ++level) {
+        worstMean = std::max(worstMean, std::abs(sums[static_cast<size_t>(level)] / beatFrames - expected[level]));
+        worstSwing = std::max(worstSwing, highs[static_cast<size_t>(level)] - lows[static_cast<size_t>(level)]);
+    }
+    const bool beatOk = flickered && worstMean <= 2.0;
+    if (!beatOk)
+        ++failures;
+    out() << "  planes:     " << bits << " bits at 90 Hz, 20 ms frames: swing up to " << worstSwing
+          << " levels, mean error " << QString::number(worstMean, 'f', 2) << (beatOk ? "" : "  FAIL") << "\n";
+
+    // Matrice complète : les LED allumées présentent l'entrée de table de la pleine intensité
+    ManualFrameClock clock;
+    MatrixDisplay display;
+    display.setPowerSavingEnabled(false);
+    display.setClock(&clock);
+    display.resize(1200, 144);
+    display.setText(QStringLiteral("GAMMA 0123456789"));
+    display.setIntensityResponse(gamma, brightness);
+    const LedFrame &presented = display.displayFrame();
+    const quint8 *levels = presented.data();
+    const bool displayOk = presented.hasLitLed()
+                           && std::all_of(levels, levels + presented.ledCount(), [&](quint8 level) {
+                                  return level == 0 || level == mapLevel(LedFrame::FullLevel, gamma, brightness);
+                              });
+    if (!displayOk)
+        ++failures;
+    out() << "  display:    lit LEDs at level " << mapLevel(LedFrame::FullLevel, gamma, brightness)
+          << (displayOk ? "" : "  FAIL") << "\n";
+
+    out() << (failures == 0 ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return failures == 0 ? 0 : 1;
+}
+
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runIntensityLut);
+}
@@ -0,0 +1,132 @@
+/**
+ * @file tst_matrixquickitem.cpp
+ * @author G. Maxime
+ * @brief Test de la variante Qt Quick (builds avec Qt Quick) : le même texte défile sur le
+ * widget et sur MatrixQuickItem rendu par le moteur logiciel de Qt Quick (--frames images
+ * chacun) ; affiche le coût par image de chacun et vérifie que les LED allumées sont les
+ * mêmes, qu'une image fixe ne modifie aucun nœud et qu'une image défilée ne modifie que les
+ * LED changées.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/matrixquickitem.h"
+#include "headers/frameclock.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Variante Qt Quick sur le moteur de rendu logiciel : même contenu que le widget pour le
+ * même moteur de texte, coût par image comparé au widget, et seules les LED modifiées
+ * touchent au graphe de scène.
+ */
+int runQuickBackend(const TestSupport::Options &options)
+{
+    const int warmupFrames = 60;
+    const QString text = QStringLiteral("{red}SCENE {#ff8000}GRAPH {rainbow}0123456789 {}MATRIX DISPLAY");
+    const auto countLit = [](const LedFrame &frame) {
+        return static_cast<int>(std::count_if(frame.data(), frame.data() + frame.ledCount(),
+                                              [](quint8 level) { return level != 0; }));
+    };
+
+    // Référence : le widget dessiné dans une image
+    ManualFrameClock widgetClock;
+    MatrixDisplay display;
+    display.setPowerSavingEnabled(false);
+    display.setClock(&widgetClock);
+    display.resize(1200, 144);
+    display.setText(text);
+    display.setScrollInterval(5);
+    display.setScrollEnabled(true);
+    QImage image(display.size(), QImage::Format_RGB32);
+    QPainter painter(&image);
+    double widgetMs = 0.0;
+    for (int frame = 0; frame < warmupFrames + options.frames; ++frame) {
+        widgetClock.advance(16);
+        display.tick();
+        QElapsedTimer timer;
+        timer.start();
+        display.displayFrame();
+        display.renderMatrix(painter);
+        if (frame >= warmupFrames)
+            widgetMs += timer.nsecsElapsed() / 1e6;
+    }
+    const int widgetLit = countLit(display.displayFrame());
+
+    // Élément Qt Quick : moteur logiciel imposé avant la création de la fenêtre
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    ManualFrameClock quickClock;
+    QQuickWindow window;
+    window.resize(1200, 144);
+    auto *item = new MatrixQuickItem(window.contentItem());
+    item->setSize(QSizeF(1200, 144));
+    item->setClock(&quickClock);
+    item->setText(text);
+    item->setScrollInterval(5);
+    item->setScrollEnabled(true);
+    window.show();
+
+    double quickMs = 0.0;
+    quint64 changedBefore = 0;
+    for (int frame = 0; frame < warmupFrames + options.frames; ++frame) {
+        quickClock.advance(16);
+        item->tick();
+        if (frame == warmupFrames)
+            changedBefore = item->statistics().changedLeds;
+        QElapsedTimer timer;
+        timer.start();
+        window.grabWindow();
+        if (frame >= warmupFrames)
+            quickMs += timer.nsecsElapsed() / 1e6;
+    }
+    const MatrixQuickItem::Statistics scrolled = item->statistics();
+    const double changedPerFrame = static_cast<double>(scrolled.changedLeds - changedBefore) / options.frames;
+
+    // Image fixe redemandée : le graphe de scène ne doit rien recevoir
+    item->update();
+    window.grabWindow();
+    const MatrixQuickItem::Statistics still = item->statistics();
+    const quint64 stillChanges = still.changedLeds - scrolled.changedLeds;
+
+    const bool software = window.rendererInterface()->graphicsApi() == QSGRendererInterface::Software;
+    const int ledCount = display.displayFrame().ledCount();
+    const bool litOk = scrolled.litNodes == widgetLit;
+    const bool diffOk = stillChanges == 0 && changedPerFrame < ledCount;
+    const double averageWidgetMs = widgetMs / options.frames;
+    const double averageQuickMs = quickMs / options.frames;
+    out() << "tst_matrixquickitem: " << options.frames << " scrolling frames of " << ledCount << " LEDs\n"
+          << "  scene graph:   " << (software ? "software" : "FAIL (not the software backend)") << "\n"
+          << "  widget:        avg " << QString::number(averageWidgetMs, 'f', 3) << " ms per frame\n"
+          << "  quick item:    avg " << QString::number(averageQuickMs, 'f', 3) << " ms per frame (x"
+          << QString::number(averageWidgetMs > 0.0 ? averageQuickMs / averageWidgetMs : 0.0, 'f', 2) << ")\n"
+          << "  lit LEDs:      quick " << scrolled.litNodes << ", widget " << widgetLit
+          << (litOk ? "" : "  FAIL (engines disagree)") << "\n"
+          << "  node updates:  " << QString::number(changedPerFrame, 'f', 1) << " LEDs per scrolling frame, "
+          << stillChanges << " on a still frame, " << still.atlasBuilds << " atlas builds"
+          << (diffOk ? "" : "  FAIL (unchanged LEDs uploaded)") << "\n";
+
+    const bool ok = software && litOk && diffOk;
+    out() << (ok ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runQuickBackend);
+}
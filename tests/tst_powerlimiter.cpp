@@ -0,0 +1,168 @@
+/**
+ * @file tst_powerlimiter.cpp
+ * @author G. Maxime
+ * @brief Test du limiteur de consommation : compare le comptage des LED allumées à une
+ * boucle LED par LED (plans d'encre de 0, 4 et 8 bits, --frames images) et affiche son coût,
+ * puis vérifie qu'une image pleine est atténuée juste sous la limite, que la luminosité
+ * remonte progressivement sans dépasser la limite et qu'une matrice la respecte.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/frameclock.h"
+#include "headers/ledframe.h"
+#include "headers/ledpalette.h"
+#include "headers/powerlimiter.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+// Inclusion des headers standard nécessaires
+#include <array>
+#include <cstring>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Estimation du courant et limitation de luminosité : comptage exact face à une
+ * boucle LED par LED, coût par image, limite jamais dépassée et remontée progressive.
+ */
+int runPowerBudget(const TestSupport::Options &options)
+{
+    int failures = 0;
+    LedPalette palette(8);
+    palette.entryFor(qRgb(255, 255, 255));
+    palette.entryFor(qRgb(255, 0, 0));
+    palette.entryFor(qRgb(0, 64, 255));
+    std::array<quint16, 256> weights{};
+    for (int index = 0; index < palette.size(); ++index) {
+        const QRgb color = palette.color(index);
+        weights[static_cast<size_t>(index)] = static_cast<quint16>(qRed(color) + qGreen(color) + qBlue(color));
+    }
+    const auto naiveLevels = [&weights](const LedFrame &frame, int *litLeds) {
+        quint64 weighted = 0;
+        *litLeds = 0;
+        for (int led = 0; led < frame.ledCount(); ++led) {
+            if (frame.data()[led] == 0)
+                continue;
+            ++*litLeds;
+            weighted += static_cast<quint64>(frame.data()[led]) * weights[frame.inkAt(led)];
+        }
+        return weighted;
+    };
+
+    // Plans aléatoires (30 % de LED allumées, dimensions non multiples de 8), avec et sans encre
+    out() << "tst_powerlimiter: " << options.frames << " frames of 250x60 LEDs per ink depth\n";
+    QRandomGenerator random(48);
+    for (const int inkBits : {0, 4, 8}) {
+        LedFrame frame(250, 60);
+        frame.setInkDepth(inkBits);
+        bool exact = true;
+        qint64 fastNs = 0;
+        qint64 naiveNs = 0;
+        for (int index = 0; index < options.frames; ++index) {
+            for (int led = 0; led < frame.ledCount(); ++led) {
+                const quint32 value = random.generate();
+                frame.data()[led] = (value % 10) < 3 ? static_cast<quint8>(value >> 8) | 1 : 0;
+                frame.setInkAt(led, static_cast<quint8>((value >> 16) % palette.size()));
+            }
+            QElapsedTimer timer;
+            timer.start();
+            int fastLit = 0;
+            const quint64 fast = PowerLimiter::weightedLevels(frame, weights, &fastLit);
+            fastNs += timer.nsecsElapsed();
+            timer.restart();
+            int naiveLit = 0;
+            const quint64 naive = naiveLevels(frame, &naiveLit);
+            naiveNs += timer.nsecsElapsed();
+            exact = exact && fast == naive && fastLit == naiveLit;
+        }
+        if (!exact)
+            ++failures;
+        out() << "  " << inkBits << "-bit inks: " << (fastNs / options.frames) << " ns per frame (LED loop "
+              << (naiveNs / options.frames) << " ns)" << (exact ? "" : "  FAIL (count differs from the LED loop)") << "\n";
+    }
+
+    // Plan plein : réduit immédiatement sous la limite, puis remontée progressive une fois éteint
+    LedFrame bright(250, 60);
+    bright.setInkDepth(8);
+    std::memset(bright.data(), LedFrame::FullLevel, static_cast<size_t>(bright.ledCount()));
+    LedFrame dark(250, 60);
+    dark.setInkDepth(8);
+    PowerLimiter limiter;
+    limiter.setEnabled(true);
+    const double fullMa = PowerLimiter::DefaultLedCurrentMa * bright.ledCount();
+    const double limitMa = fullMa * 0.4;
+    limiter.setBudget(PowerLimiter::DefaultLedCurrentMa, limitMa);
+    qint64 nowMs = 0;
+    const auto deliveredMa = [&weights](const LedFrame &frame) {
+        return PowerLimiter::weightedLevels(frame, weights, nullptr) * PowerLimiter::DefaultLedCurrentMa / (255.0 * 765.0);
+    };
+    const double limitedMa = deliveredMa(limiter.apply(bright, palette, nowMs));
+    const bool limitOk = limitedMa <= limitMa && limitedMa >= limitMa * 0.95;
+    if (!limitOk)
+        ++failures;
+    out() << "  full white: requested " << qRound64(fullMa) << " mA, limit " << qRound64(limitMa) << " mA, delivered "
+          << qRound64(limitedMa) << " mA" << (limitOk ? "" : "  FAIL") << "\n";
+
+    int recoveryMs = -1;
+    double previous = limiter.statistics().brightness;
+    bool monotonic = true;
+    bool peakOk = true;
+    for (int step = 1; step <= 100 && recoveryMs < 0; ++step) {
+        nowMs += 16;
+        // Retour du plein blanc à mi-remontée : la limite reste tenue
+        if (step == 20)
+            peakOk = deliveredMa(limiter.apply(bright, palette, nowMs)) <= limitMa;
+        limiter.apply(dark, palette, nowMs);
+        const double brightness = limiter.statistics().brightness;
+        monotonic = monotonic && (step == 20 || brightness >= previous);
+        previous = brightness;
+        if (!limiter.isRecovering() && brightness >= 1.0)
+            recoveryMs = static_cast<int>(nowMs);
+    }
+    const bool recoveryOk = monotonic && peakOk && recoveryMs > 0 && recoveryMs <= 2 * PowerLimiter::ReleaseMs;
+    if (!recoveryOk)
+        ++failures;
+    out() << "  recovery:   full brightness after " << recoveryMs << " ms"
+          << (peakOk ? "" : ", limit exceeded on a new peak") << (monotonic ? "" : ", brightness not monotonic")
+          << (recoveryOk ? "" : "  FAIL") << "\n";
+
+    // Matrice complète : l'image présentée respecte la limite, le relevé l'indique
+    ManualFrameClock clock;
+    MatrixDisplay display;
+    display.setPowerSavingEnabled(false);
+    display.setClock(&clock);
+    display.resize(1200, 144);
+    display.setText(QStringLiteral("{#ffffff}POWER {red}BUDGET {#0040ff}0123456789"));
+    display.setPowerBudget(PowerLimiter::DefaultLedCurrentMa, 0.0);
+    display.displayFrame();
+    const double openMa = display.powerStatistics().requestedMa;
+    display.setPowerBudget(PowerLimiter::DefaultLedCurrentMa, openMa / 2.0);
+    display.resetPowerStatistics();
+    clock.advance(16);
+    display.displayFrame();
+    const PowerLimiter::Statistics statistics = display.powerStatistics();
+    const bool displayOk = openMa > 0.0 && statistics.deliveredMa <= openMa / 2.0 && statistics.limitedFrames == 1;
+    if (!displayOk)
+        ++failures;
+    out() << "  display:    " << statistics.litLeds << " lit LEDs, requested " << qRound64(statistics.requestedMa)
+          << " mA, delivered " << qRound64(statistics.deliveredMa) << " mA at "
+          << qRound(statistics.brightness * 100.0) << " % brightness" << (displayOk ? "" : "  FAIL") << "\n";
+
+    out() << (failures == 0 ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return failures == 0 ? 0 : 1;
+}
+
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runPowerBudget);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file tst_resizecoalescing.cpp
+ * @author G. Maxime
+ * @brief Test de la coalescence des redimensionnements : un redimensionnement à la souris
+ * (40 tailles en 400 ms) est simulé sur une matrice affichée ; vérifie que les images de LED
+ * ne sont construites que pour la taille finale (pas plus qu'un redimensionnement unique)
+ * et que le défilement n'est pas repris.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/frameclock.h"
+#include "headers/spritecache.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Redimensionnement à la souris sur une matrice affichée : images provisoires mises à
+ * l'échelle pendant le geste, une seule construction des images de LED pour la taille finale,
+ * et position de défilement conservée.
+ */
+int runResizeDrag(const TestSupport::Options &options)
+{
+    Q_UNUSED(options);
+    const int dragSteps = 40;
+    const int stepIntervalMs = 10;
+    const int settleMs = 400;
+
+    ManualFrameClock clock;
+    MatrixDisplay display;
+    display.setPowerSavingEnabled(false);
+    display.setClock(&clock);
+    display.resize(1200, 144);
+    display.setLedStyle(LedRenderer::GlowStyle);
+    display.setText(QStringLiteral("{red}RESIZE {#ff8000}DRAG {rainbow}0123456789 {}SCROLLING MATRIX DISPLAY"));
+    display.setScrollInterval(5);
+    display.setScrollEnabled(true);
+    display.show();
+
+    int paints = 0;
+    QObject::connect(&display, &MatrixDisplay::framePainted, &display, [&paints]() { ++paints; });
+    const auto processFor = [](int durationMs) {
+        QElapsedTimer elapsed;
+        elapsed.start();
+        while (elapsed.elapsed() < durationMs)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+    };
+    QElapsedTimer deadline;
+    deadline.start();
+    while (paints == 0 && deadline.elapsed() < 2000)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+    // Défilement engagé : un redémarrage du défilement changerait l'image
+    for (int frame = 0; frame < 25; ++frame) {
+        clock.advance(16);
+        display.tick();
+    }
+    processFor(50);
+    const quint64 hashBefore = display.displayFrame().hash();
+
+    // Geste : la largeur et la hauteur changent à chaque étape, donc la taille de cellule aussi
+    SpriteCache &cache = SpriteCache::instance();
+    const quint64 missesBefore = cache.statistics().misses;
+    const int paintsBefore = paints;
+    qint64 maxStepNs = 0;
+    for (int step = 1; step <= dragSteps; ++step) {
+        QElapsedTimer stepTimer;
+        stepTimer.start();
+        display.resize(1200 + 12 * step, 144 + 4 * step);
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+        maxStepNs = std::max(maxStepNs, stepTimer.nsecsElapsed());
+        processFor(stepIntervalMs);
+    }
+    const int dragPaints = paints - paintsBefore;
+    processFor(settleMs);
+    const quint64 dragMisses = cache.statistics().misses - missesBefore;
+    const quint64 hashAfter = display.displayFrame().hash();
+
+    // Référence : un seul redimensionnement vers une taille de cellule encore jamais dessinée
+    const quint64 singleBefore = cache.statistics().misses;
+    display.resize(960, 120);
+    processFor(settleMs);
+    const quint64 singleMisses = cache.statistics().misses - singleBefore;
+
+    const bool missesOk = dragMisses <= singleMisses;
+    const bool scrollOk = hashAfter == hashBefore;
+    const bool paintedOk = dragPaints > 0;
+    out() << "tst_resizecoalescing: " << dragSteps << " steps every " << stepIntervalMs << " ms, settled after "
+          << settleMs << " ms\n"
+          << "  paints during drag: " << dragPaints << (paintedOk ? "" : "  FAIL (no interim frame)") << "\n"
+          << "  slowest step:       " << QString::number(maxStepNs / 1e6, 'f', 2) << " ms\n"
+          << "  sprite builds:      drag " << dragMisses << ", single resize " << singleMisses
+          << (missesOk ? "" : "  FAIL (sprites built for intermediate sizes)") << "\n"
+          << "  scroll position:    " << (scrollOk ? "kept" : "FAIL (restarted by the resize)") << "\n";
+
+    const bool ok = missesOk && scrollOk && paintedOk;
+    out() << (ok ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return ok ? 0 : 1;
+}
+
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runResizeDrag);
+}
@@ -0,0 +1,125 @@
+/**
+ * @file tst_sharedframe.cpp
+ * @author G. Maxime
+ * @brief Test de la publication en mémoire partagée : un défilement est publié pendant
+ * qu'un thread le relit sans cesse ; vérifie qu'aucune lecture n'est incohérente et que la
+ * dernière image parvient au lecteur, et affiche la latence entre publication et lecture.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/frameclock.h"
+#include "headers/sharedframe.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Publication en mémoire partagée : un lecteur concurrent ne doit jamais voir
+ * d'image incohérente, et la dernière image publiée doit lui parvenir.
+ */
+int runSharedFrame(const TestSupport::Options &options)
+{
+    ManualFrameClock clock;
+    MatrixDisplay display;
+    display.setPowerSavingEnabled(false);
+    display.setClock(&clock);
+    display.resize(1200, 144);
+    display.setText(QStringLiteral("SHARED {#ff8000}MEMORY {rainbow}FRAMES 0123456789"));
+    display.setScrollInterval(5);
+    display.setScrollEnabled(true);
+
+    const QString key = QStringLiteral("matrix-tst-sharedframe-%1").arg(QCoreApplication::applicationPid());
+    QString error;
+    if (!display.setSharedFrameKey(key, &error)) {
+        out() << "tst_sharedframe: " << error << "\n";
+        out().flush();
+        return 1;
+    }
+    SharedFrameReader reader;
+    if (!reader.attach(key, &error)) {
+        out() << "tst_sharedframe: " << error << "\n";
+        out().flush();
+        return 1;
+    }
+
+    // Lecteur en attente active : il tente de lire pendant chaque publication
+    std::atomic<bool> stop{false};
+    std::atomic<quint64> lastHash{0};
+    quint64 framesRead = 0;
+    quint64 tornFrames = 0;
+    std::vector<qint64> latenciesNs;
+    latenciesNs.reserve(static_cast<size_t>(options.frames) + 1);
+    std::unique_ptr<QThread> readerThread(QThread::create([&]() {
+        LedFrame frame;
+        QVector<QRgb> palette;
+        SharedFrameInfo info;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (!reader.read(&frame, &palette, &info))
+                continue;
+            latenciesNs.push_back(SharedFrameReader::clockNs() - info.publishNs);
+            ++framesRead;
+            if (frame.hash() != info.hash)
+                ++tornFrames;
+            lastHash.store(info.hash, std::memory_order_relaxed);
+        }
+    }));
+    readerThread->start();
+
+    quint64 finalHash = 0;
+    for (int index = 0; index < options.frames; ++index) {
+        clock.advance(16);
+        display.tick();
+        finalHash = display.displayFrame().hash();
+        QThread::usleep(500);
+    }
+
+    // La dernière image publiée doit être lue
+    QElapsedTimer deadline;
+    deadline.start();
+    while (lastHash.load(std::memory_order_relaxed) != finalHash && deadline.elapsed() < 1000)
+        QThread::msleep(1);
+    stop.store(true, std::memory_order_relaxed);
+    readerThread->wait();
+
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+    const auto latencyUs = [&latenciesNs](int percent) {
+        if (latenciesNs.empty())
+            return qint64(0);
+        return latenciesNs[std::min(latenciesNs.size() - 1, latenciesNs.size() * percent / 100)] / 1000;
+    };
+    const bool finalOk = lastHash.load() == finalHash;
+    out() << "tst_sharedframe: " << options.frames << " published frames\n"
+          << "  frames read:  " << framesRead << "\n"
+          << "  read retries: " << reader.retries() << "\n"
+          << "  torn frames:  " << tornFrames << (tornFrames == 0 ? "" : "  FAIL") << "\n"
+          << "  latency (us): median " << latencyUs(50) << ", p99 " << latencyUs(99)
+          << ", max " << latencyUs(100) << "\n"
+          << "  last frame:   " << (finalOk ? "read" : "MISSING") << "\n";
+
+    const bool ok = framesRead > 0 && tornFrames == 0 && finalOk;
+    out() << (ok ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return ok ? 0 : 1;
+}
+
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runSharedFrame);
+}
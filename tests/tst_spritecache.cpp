@@ -0,0 +1,94 @@
+/**
+ * @file tst_spritecache.cpp
+ * @author G. Maxime
+ * @brief Test du cache d'images partagé : plusieurs matrices identiques doivent partager
+ * les images du SpriteCache, puis l'éviction doit respecter un plafond réduit.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+#include "headers/spritecache.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QImage>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Affiche les statistiques du cache d'images partagé.
+ */
+void printSpriteCacheStatistics(const char *label)
+{
+    const SpriteCache::Statistics stats = SpriteCache::instance().statistics();
+    out() << "  " << QString::fromLatin1(label).leftJustified(18) << stats.entries << " entries, "
+          << QString::number(stats.bytes / 1024.0, 'f', 1) << " KiB (peak "
+          << QString::number(stats.peakBytes / 1024.0, 'f', 1) << " KiB, cap "
+          << QString::number(stats.byteCap / 1024.0, 'f', 1) << " KiB), "
+          << stats.hits << " hits, " << stats.misses << " misses, " << stats.evictions << " evictions\n";
+}
+
+/**
+ * @brief Vérifie que des matrices identiques partagent leurs images et que le plafond du cache est respecté.
+ */
+int runSpriteCache(const TestSupport::Options &options)
+{
+    SpriteCache &cache = SpriteCache::instance();
+    cache.clear();
+    const qint64 initialCap = cache.byteCap();
+
+    const int displayCount = std::max(2, options.threads);
+    std::vector<std::unique_ptr<MatrixDisplay>> displays;
+    std::vector<QImage> images;
+    SpriteCache::Statistics single;
+    out() << "tst_spritecache: " << displayCount << " identical displays\n";
+    for (int i = 0; i < displayCount; ++i) {
+        displays.emplace_back(new MatrixDisplay);
+        MatrixDisplay &display = *displays.back();
+        display.setPowerSavingEnabled(false);
+        display.resize(1200, 144);
+        display.setLedStyle(LedRenderer::GlowStyle);
+        display.setText(QStringLiteral("{red}SHARED {#00ff00}SPRITES {}0123456789"));
+        images.emplace_back(display.size(), QImage::Format_RGB32);
+        display.render(&images.back());
+        if (i == 0) {
+            single = cache.statistics();
+            printSpriteCacheStatistics("first display");
+        }
+    }
+    const SpriteCache::Statistics shared = cache.statistics();
+    printSpriteCacheStatistics("all displays");
+    const bool sharedOk = shared.entries == single.entries && shared.bytes == single.bytes
+                          && shared.misses == single.misses;
+    out() << "  sharing: " << (sharedOk ? "ok" : "FAIL (identical displays built their own images)") << "\n";
+
+    // Plafond réduit de moitié : les images les plus anciennes sont évincées,
+    // celles encore utilisées par les matrices restent valides
+    cache.setByteCap(single.bytes / 2);
+    for (std::size_t i = 0; i < displays.size(); ++i)
+        displays[i]->render(&images[i]);
+    const SpriteCache::Statistics capped = cache.statistics();
+    printSpriteCacheStatistics("half cap");
+    const bool capOk = capped.bytes <= capped.byteCap && capped.evictions > 0;
+    out() << "  eviction: " << (capOk ? "ok" : "FAIL (cache over its byte cap)") << "\n";
+    cache.setByteCap(initialCap);
+
+    const bool ok = sharedOk && capOk;
+    out() << (ok ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runSpriteCache);
+}
@@ -0,0 +1,181 @@
+/**
+ * @file tst_videofeed.cpp
+ * @author G. Maxime
+ * @brief Test du flux vidéo (Unix) : un flux 640×360 à 30 images/s est envoyé par un tube
+ * pendant que le thread GUI dessine toutes les 10 ms ; vérifie que les images lues sont
+ * converties et affichées, et affiche les compteurs de lecture, de conversion et d'abandon.
+ * Avec --timing (entrée bench_videofeed), vérifie aussi qu'au moins 95 % des images sont
+ * converties et que le thread GUI n'est jamais bloqué plus de 50 ms.
+ */
+
+// Inclusion de mes headers
+#include "tests/testsupport.h"
+#include "headers/matrixdisplay.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QImage>
+#include <QPainter>
+#include <QThread>
+#include <QTimer>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cerrno>
+#include <memory>
+#include <vector>
+#include <unistd.h>
+
+using TestSupport::out;
+
+namespace {
+
+/**
+ * @brief Flux vidéo 640×360 à 30 images/s par un tube : vérifie que les images lues sont
+ * réduites et affichées, et, avec --timing, au rythme de la source sans bloquer le thread GUI.
+ */
+int runVideoFeed(const TestSupport::Options &options)
+{
+    const QSize frameSize(640, 360);
+    const int frameIntervalMs = 33;
+    const int frameBytes = frameSize.width() * frameSize.height() * 3;
+
+    // Images précalculées : le producteur ne fait qu'écrire, au rythme de la source
+    const QVector<QImage> animation = TestSupport::syntheticAnimation(8);
+    std::vector<QByteArray> frames;
+    for (const QImage &source : animation) {
+        const QImage scaled = source.scaled(frameSize).convertToFormat(QImage::Format_RGB888);
+        QByteArray bytes;
+        bytes.reserve(frameBytes);
+        for (int y = 0; y < scaled.height(); ++y)
+            bytes.append(reinterpret_cast<const char *>(scaled.constScanLine(y)), frameSize.width() * 3);
+        frames.push_back(bytes);
+    }
+
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        out() << "tst_videofeed: cannot create a pipe\n";
+        out().flush();
+        return 1;
+    }
+    // Un lecteur arrêté ne doit pas tuer le processus : l'écriture échoue simplement
+    ::signal(SIGPIPE, SIG_IGN);
+
+    MatrixDisplay display;
+    display.setPowerSavingEnabled(false);
+    display.resize(1200, 144);
+    display.setMatrixSize(96, 27);
+    QString error;
+    if (!display.openVideo(QStringLiteral("/dev/fd/%1").arg(fds[0]), frameSize, &error)) {
+        out() << "tst_videofeed: " << error << "\n";
+        out().flush();
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return 1;
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<quint64> written{0};
+    std::unique_ptr<QThread> producer(QThread::create([&]() {
+        QElapsedTimer elapsed;
+        elapsed.start();
+        quint64 index = 0;
+        while (!stop.load(std::memory_order_relaxed) && elapsed.elapsed() < options.durationMs) {
+            const QByteArray &frame = frames[index % frames.size()];
+            qint64 offset = 0;
+            while (offset < frame.size()) {
+                const ssize_t count = ::write(fds[1], frame.constData() + offset, static_cast<size_t>(frame.size() - offset));
+                if (count < 0 && errno == EINTR)
+                    continue;
+                if (count <= 0)
+                    break;
+                offset += count;
+            }
+            if (offset < frame.size())
+                break;
+            written.store(++index, std::memory_order_relaxed);
+            // Cadence de la source : image suivante à son heure, sans accumuler de retard
+            const qint64 dueMs = static_cast<qint64>(index) * frameIntervalMs;
+            const qint64 waitMs = dueMs - elapsed.elapsed();
+            if (waitMs > 0)
+                QThread::msleep(static_cast<unsigned long>(waitMs));
+        }
+        ::close(fds[1]);
+    }));
+    producer->start();
+
+    // Thread GUI : un rendu toutes les 10 ms, l'écart maximal entre deux réveils mesure les blocages
+    QImage image(display.size(), QImage::Format_RGB32);
+    QPainter painter(&image);
+    QElapsedTimer gapTimer;
+    gapTimer.start();
+    qint64 maxGapMs = 0;
+    quint64 renders = 0;
+    QTimer renderTimer;
+    renderTimer.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&renderTimer, &QTimer::timeout, &display, [&]() {
+        maxGapMs = std::max(maxGapMs, gapTimer.restart());
+        display.displayFrame();
+        display.renderMatrix(painter);
+        ++renders;
+    });
+    renderTimer.start(10);
+
+    QEventLoop loop;
+    QTimer::singleShot(options.durationMs, &loop, &QEventLoop::quit);
+    loop.exec();
+    renderTimer.stop();
+
+    stop.store(true, std::memory_order_relaxed);
+    producer->wait();
+    ::close(fds[0]);
+
+    // Fin du tube : les dernières images lues sont encore converties
+    QElapsedTimer deadline;
+    deadline.start();
+    VideoFeed::Statistics stats = display.zone(0)->videoStatistics();
+    while (stats.framesConverted + stats.queueDrops < stats.framesRead && deadline.elapsed() < 1000) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+        stats = display.zone(0)->videoStatistics();
+    }
+
+    const quint64 sent = written.load();
+    // Chaque image lue est convertie ou abandonnée par la file, et des images atteignent la matrice
+    const bool feedOk = sent > 0 && stats.framesConverted > 0 && stats.framesDisplayed > 0
+                        && stats.framesConverted + stats.queueDrops >= stats.framesRead;
+    // Budgets de temps : seulement avec --timing (entrée benchmark de ctest)
+    const double gapBudgetMs = 50.0 * options.budgetScale;
+    const bool rateOk = !options.timing || stats.framesConverted * 100 >= sent * 95;
+    const bool gapOk = !options.timing || maxGapMs < gapBudgetMs;
+    out() << "tst_videofeed: " << frameSize.width() << "x" << frameSize.height() << " at "
+          << 1000 / frameIntervalMs << " fps, " << options.durationMs << " ms\n"
+          << "  frames written:   " << sent << "\n"
+          << "  frames read:      " << stats.framesRead << "\n"
+          << "  frames converted: " << stats.framesConverted << " (avg "
+          << QString::number(stats.averageConvertMs, 'f', 2) << " ms)"
+          << (rateOk ? "" : "  FAIL (below 95% of the source rate)") << "\n"
+          << "  frames displayed: " << stats.framesDisplayed
+          << (feedOk ? "" : "  FAIL (frames lost between the pipe and the display)") << "\n"
+          << "  queue drops:      " << stats.queueDrops << "\n"
+          << "  stale drops:      " << stats.staleDrops << "\n"
+          << "  renders:          " << renders << "\n"
+          << "  max GUI gap:      " << maxGapMs << " ms (budget " << gapBudgetMs << " ms)"
+          << (gapOk ? "" : "  FAIL") << "\n";
+
+    const bool ok = feedOk && rateOk && gapOk;
+    out() << (ok ? "PASS" : "FAIL") << "\n";
+    out().flush();
+    return ok ? 0 : 1;
+}
+
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return TestSupport::run(argc, argv, runVideoFeed);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file framestreamviewer.cpp
+ * @author G. Maxime
+ * @brief Visualiseur distant des images diffusées sur TCP (--stream-port).
+ * Reconstruit l'image à partir des images clés et des différences, et mesure le débit reçu.
+ */
+
+// Inclusion de mes headers
+#include "headers/framestream.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QTcpSocket>
+#include <QTimer>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Flux de sortie du rapport.
+ */
+QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+/**
+ * @brief Dessine l'image reconstruite en caractères, une ligne de texte par ligne de LED.
+ */
+void printFrame(const FrameStreamDecoder &decoder)
+{
+    out() << "frame " << decoder.frameNumber() << ": " << decoder.cols() << "x" << decoder.rows() << " LEDs, "
+          << decoder.inkBits() << "-bit inks, " << decoder.palette().size() << " palette colors\n";
+    for (int row = 0; row < decoder.rows(); ++row) {
+        QString line(decoder.cols(), QLatin1Char(' '));
+        for (int col = 0; col < decoder.cols(); ++col) {
+            if (decoder.isLit(col, row))
+                line[col] = QLatin1Char('#');
+        }
+        out() << line << "\n";
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Fonction principale du visualiseur.
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments
+ * @return 0 si au moins une image a été reçue sans erreur de flux
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Views the LED frames streamed by Matrix_Display --stream-port"));
+    parser.addHelpOption();
+    const QCommandLineOption hostOption(QStringLiteral("host"),
+        QStringLiteral("Address of the display (127.0.0.1 by default)."), QStringLiteral("host"));
+    const QCommandLineOption portOption(QStringLiteral("port"),
+        QStringLiteral("Stream port of the display."), QStringLiteral("port"));
+    const QCommandLineOption durationOption(QStringLiteral("duration-ms"),
+        QStringLiteral("Measurement duration in milliseconds (5000 by default)."), QStringLiteral("ms"));
+    const QCommandLineOption showOption(QStringLiteral("show"),
+        QStringLiteral("Print every frame received instead of the last one only."));
+    parser.addOptions({hostOption, portOption, durationOption, showOption});
+    parser.process(application);
+
+    bool ok = true;
+    const int port = parser.value(portOption).toInt(&ok);
+    if (!ok || port <= 0 || port > 65535) {
+        out() << "framestreamviewer: --port is required\n";
+        out().flush();
+        return 1;
+    }
+    const int durationMs = parser.isSet(durationOption) ? parser.value(durationOption).toInt(&ok) : 5000;
+    if (!ok || durationMs <= 0) {
+        out() << "framestreamviewer: invalid duration\n";
+        out().flush();
+        return 1;
+    }
+    const QString host = parser.isSet(hostOption) ? parser.value(hostOption) : QStringLiteral("127.0.0.1");
+
+    FrameStreamDecoder decoder;
+    QTcpSocket socket;
+    QString errorMessage;
+    quint64 bytesReceived = 0;
+    quint64 framesReceived = 0;
+    QElapsedTimer elapsed;
+
+    QObject::connect(&socket, &QTcpSocket::readyRead, &application, [&]() {
+        const QByteArray bytes = socket.readAll();
+        bytesReceived += static_cast<quint64>(bytes.size());
+        const int decoded = decoder.feed(bytes, &errorMessage);
+        if (decoded < 0) {
+            application.exit(1);
+            return;
+        }
+        framesReceived += static_cast<quint64>(decoded);
+        if (decoded > 0 && parser.isSet(showOption))
+            printFrame(decoder);
+    });
+    QObject::connect(&socket, &QTcpSocket::errorOccurred, &application, [&]() {
+        errorMessage = socket.errorString();
+        application.exit(1);
+    });
+    QTimer::singleShot(durationMs, &application, [&]() { application.exit(0); });
+
+    elapsed.start();
+    socket.connectToHost(host, static_cast<quint16>(port));
+    const int status = application.exec();
+    const double seconds = std::max<qint64>(1, elapsed.elapsed()) / 1000.0;
+
+    if (decoder.hasFrame() && !parser.isSet(showOption))
+        printFrame(decoder);
+    out() << "framestreamviewer: " << host << ":" << port << ", " << elapsed.elapsed() << " ms\n"
+          << "  frames:     " << framesReceived << " (" << decoder.keyframes() << " keyframes, "
+          << decoder.deltas() << " deltas)\n"
+          << "  bytes:      " << bytesReceived << " (" << qRound64(bytesReceived / seconds) << " bytes/s)\n"
+          << "  per frame:  " << (framesReceived > 0 ? bytesReceived / framesReceived : 0) << " bytes\n";
+    if (!errorMessage.isEmpty())
+        out() << "  error:      " << errorMessage << "\n";
+    out().flush();
+    return (status == 0 && decoder.hasFrame()) ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file sharedframereader.cpp
+ * @author G. Maxime
+ * @brief Lecteur du plan des LED publié en mémoire partagée (--shared-frame).
+ * Affiche l'image publiée et mesure la latence entre publication et lecture.
+ */
+
+// Inclusion de mes headers
+#include "headers/sharedframe.h"
+
+// Inclusion des headers Qt nécessaires
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QThread>
+
+// Inclusion des headers standard nécessaires
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Flux de sortie du rapport.
+ */
+QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+/**
+ * @brief Dessine le plan en caractères, une ligne de texte par ligne de LED.
+ */
+void printFrame(const LedFrame &frame, const QVector<QRgb> &palette, const SharedFrameInfo &info)
+{
+    out() << "frame " << info.frameNumber << ": " << frame.cols() << "x" << frame.rows() << " LEDs, "
+          << frame.inkDepth() << "-bit inks, " << palette.size() << " palette colors\n";
+    static const char kShades[] = " .:o#";
+    for (int row = 0; row < frame.rows(); ++row) {
+        QString line(frame.cols(), QLatin1Char(' '));
+        for (int col = 0; col < frame.cols(); ++col) {
+            line[col] = QLatin1Char(kShades[(frame.at(col, row) * 4 + 254) / 255]);
+        }
+        out() << line << "\n";
+    }
+}
+
+/**
+ * @brief Valeur d'un centile d'une série triée.
+ */
+qint64 percentile(const std::vector<qint64> &sorted, int percent)
+{
+    if (sorted.empty())
+        return 0;
+    const size_t index = std::min(sorted.size() - 1, sorted.size() * percent / 100);
+    return sorted[index];
+}
+
+} // namespace
+
+/**
+ * @brief Fonction principale du lecteur.
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments
+ * @return 0 si au moins une image a été lue sans incohérence
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Reads the LED frames published by Matrix_Display --shared-frame"));
+    parser.addHelpOption();
+    const QCommandLineOption keyOption(QStringLiteral("key"),
+        QStringLiteral("Name of the shared-memory segment."), QStringLiteral("key"));
+    const QCommandLineOption durationOption(QStringLiteral("duration-ms"),
+        QStringLiteral("Measurement duration in milliseconds (5000 by default)."), QStringLiteral("ms"));
+    const QCommandLineOption pollOption(QStringLiteral("poll-us"),
+        QStringLiteral("Polling interval in microseconds (200 by default, 0 spins)."), QStringLiteral("us"));
+    const QCommandLineOption showOption(QStringLiteral("show"),
+        QStringLiteral("Print every frame read instead of the last one only."));
+    parser.addOptions({keyOption, durationOption, pollOption, showOption});
+    parser.process(application);
+
+    const QString key = parser.value(keyOption);
+    if (key.isEmpty()) {
+        out() << "sharedframereader: --key is required\n";
+        out().flush();
+        return 1;
+    }
+    bool ok = true;
+    const int durationMs = parser.isSet(durationOption) ? parser.value(durationOption).toInt(&ok) : 5000;
+    if (!ok || durationMs <= 0) {
+        out() << "sharedframereader: invalid duration\n";
+        out().flush();
+        return 1;
+    }
+    const int pollUs = parser.isSet(pollOption) ? parser.value(pollOption).toInt(&ok) : 200;
+    if (!ok || pollUs < 0) {
+        out() << "sharedframereader: invalid polling interval\n";
+        out().flush();
+        return 1;
+    }
+
+    SharedFrameReader reader;
+    QString errorMessage;
+    if (!reader.attach(key, &errorMessage)) {
+        out() << "sharedframereader: " << errorMessage << "\n";
+        out().flush();
+        return 1;
+    }
+
+    LedFrame frame;
+    QVector<QRgb> palette;
+    SharedFrameInfo info;
+    std::vector<qint64> latenciesNs;
+    latenciesNs.reserve(1 << 16);
+    quint64 framesRead = 0;
+    quint64 framesMissed = 0;
+    quint64 tornFrames = 0;
+    quint64 previousNumber = 0;
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    while (elapsed.elapsed() < durationMs) {
+        // Sondage sans copie : la génération seule indique une nouvelle image
+        if (!reader.hasNewFrame()) {
+            if (pollUs > 0)
+                QThread::usleep(static_cast<unsigned long>(pollUs));
+            continue;
+        }
+        if (!reader.read(&frame, &palette, &info))
+            continue;
+
+        latenciesNs.push_back(SharedFrameReader::clockNs() - info.publishNs);
+        ++framesRead;
+        // Une lecture validée par le seqlock doit toujours correspondre à l'empreinte de l'écrivain
+        if (frame.hash() != info.hash)
+            ++tornFrames;
+        if (previousNumber > 0 && info.frameNumber > previousNumber + 1)
+            framesMissed += info.frameNumber - previousNumber - 1;
+        previousNumber = info.frameNumber;
+        if (parser.isSet(showOption))
+            printFrame(frame, palette, info);
+    }
+
+    if (framesRead > 0 && !parser.isSet(showOption))
+        printFrame(frame, palette, info);
+
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+    out() << "sharedframereader: " << key << ", " << durationMs << " ms, polling every " << pollUs << " us\n"
+          << "  frames read:     " << framesRead << "\n"
+          << "  frames skipped:  " << framesMissed << " (published between two polls)\n"
+          << "  read retries:    " << reader.retries() << "\n"
+          << "  torn frames:     " << tornFrames << "\n"
+          << "  latency (us):    min " << percentile(latenciesNs, 0) / 1000
+          << ", median " << percentile(latenciesNs, 50) / 1000
+          << ", p99 " << percentile(latenciesNs, 99) / 1000
+          << ", max " << (latenciesNs.empty() ? 0 : latenciesNs.back() / 1000) << "\n";
+    out().flush();
+    return (framesRead > 0 && tornFrames == 0) ? 0 : 1;
+}